@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/nanobench.dir/src/test/app/nanobench.cpp.o"
+  "CMakeFiles/nanobench.dir/src/test/app/nanobench.cpp.o.d"
+  "libnanobench.a"
+  "libnanobench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/nanobench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
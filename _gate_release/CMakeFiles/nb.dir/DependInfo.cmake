@@ -0,0 +1,80 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/test/app/doctest.cpp" "CMakeFiles/nb.dir/src/test/app/doctest.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/app/doctest.cpp.o.d"
+  "/root/repo/src/test/app/nanobench.cpp" "CMakeFiles/nb.dir/src/test/app/nanobench.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/app/nanobench.cpp.o.d"
+  "/root/repo/src/test/example_always_the_same.cpp" "CMakeFiles/nb.dir/src/test/example_always_the_same.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/example_always_the_same.cpp.o.d"
+  "/root/repo/src/test/example_atomic.cpp" "CMakeFiles/nb.dir/src/test/example_atomic.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/example_atomic.cpp.o.d"
+  "/root/repo/src/test/example_branch_misses.cpp" "CMakeFiles/nb.dir/src/test/example_branch_misses.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/example_branch_misses.cpp.o.d"
+  "/root/repo/src/test/example_complexity.cpp" "CMakeFiles/nb.dir/src/test/example_complexity.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/example_complexity.cpp.o.d"
+  "/root/repo/src/test/example_containers.cpp" "CMakeFiles/nb.dir/src/test/example_containers.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/example_containers.cpp.o.d"
+  "/root/repo/src/test/example_csv.cpp" "CMakeFiles/nb.dir/src/test/example_csv.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/example_csv.cpp.o.d"
+  "/root/repo/src/test/example_hide_output.cpp" "CMakeFiles/nb.dir/src/test/example_hide_output.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/example_hide_output.cpp.o.d"
+  "/root/repo/src/test/example_preconfigured_name.cpp" "CMakeFiles/nb.dir/src/test/example_preconfigured_name.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/example_preconfigured_name.cpp.o.d"
+  "/root/repo/src/test/example_pyperf.cpp" "CMakeFiles/nb.dir/src/test/example_pyperf.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/example_pyperf.cpp.o.d"
+  "/root/repo/src/test/example_random2.cpp" "CMakeFiles/nb.dir/src/test/example_random2.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/example_random2.cpp.o.d"
+  "/root/repo/src/test/example_random_number_generators.cpp" "CMakeFiles/nb.dir/src/test/example_random_number_generators.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/example_random_number_generators.cpp.o.d"
+  "/root/repo/src/test/example_random_uniform01.cpp" "CMakeFiles/nb.dir/src/test/example_random_uniform01.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/example_random_uniform01.cpp.o.d"
+  "/root/repo/src/test/example_shuffle.cpp" "CMakeFiles/nb.dir/src/test/example_shuffle.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/example_shuffle.cpp.o.d"
+  "/root/repo/src/test/tutorial_compare.cpp" "CMakeFiles/nb.dir/src/test/tutorial_compare.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/tutorial_compare.cpp.o.d"
+  "/root/repo/src/test/tutorial_complexity_set.cpp" "CMakeFiles/nb.dir/src/test/tutorial_complexity_set.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/tutorial_complexity_set.cpp.o.d"
+  "/root/repo/src/test/tutorial_complexity_sort.cpp" "CMakeFiles/nb.dir/src/test/tutorial_complexity_sort.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/tutorial_complexity_sort.cpp.o.d"
+  "/root/repo/src/test/tutorial_context.cpp" "CMakeFiles/nb.dir/src/test/tutorial_context.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/tutorial_context.cpp.o.d"
+  "/root/repo/src/test/tutorial_fast_v1.cpp" "CMakeFiles/nb.dir/src/test/tutorial_fast_v1.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/tutorial_fast_v1.cpp.o.d"
+  "/root/repo/src/test/tutorial_fast_v2.cpp" "CMakeFiles/nb.dir/src/test/tutorial_fast_v2.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/tutorial_fast_v2.cpp.o.d"
+  "/root/repo/src/test/tutorial_fluctuating_v1.cpp" "CMakeFiles/nb.dir/src/test/tutorial_fluctuating_v1.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/tutorial_fluctuating_v1.cpp.o.d"
+  "/root/repo/src/test/tutorial_fluctuating_v2.cpp" "CMakeFiles/nb.dir/src/test/tutorial_fluctuating_v2.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/tutorial_fluctuating_v2.cpp.o.d"
+  "/root/repo/src/test/tutorial_mustache.cpp" "CMakeFiles/nb.dir/src/test/tutorial_mustache.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/tutorial_mustache.cpp.o.d"
+  "/root/repo/src/test/tutorial_render_simple.cpp" "CMakeFiles/nb.dir/src/test/tutorial_render_simple.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/tutorial_render_simple.cpp.o.d"
+  "/root/repo/src/test/tutorial_slow_v1.cpp" "CMakeFiles/nb.dir/src/test/tutorial_slow_v1.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/tutorial_slow_v1.cpp.o.d"
+  "/root/repo/src/test/tutorial_slow_v2.cpp" "CMakeFiles/nb.dir/src/test/tutorial_slow_v2.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/tutorial_slow_v2.cpp.o.d"
+  "/root/repo/src/test/unit_api.cpp" "CMakeFiles/nb.dir/src/test/unit_api.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_api.cpp.o.d"
+  "/root/repo/src/test/unit_baseline.cpp" "CMakeFiles/nb.dir/src/test/unit_baseline.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_baseline.cpp.o.d"
+  "/root/repo/src/test/unit_bench_config.cpp" "CMakeFiles/nb.dir/src/test/unit_bench_config.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_bench_config.cpp.o.d"
+  "/root/repo/src/test/unit_checkpoint.cpp" "CMakeFiles/nb.dir/src/test/unit_checkpoint.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_checkpoint.cpp.o.d"
+  "/root/repo/src/test/unit_cold.cpp" "CMakeFiles/nb.dir/src/test/unit_cold.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_cold.cpp.o.d"
+  "/root/repo/src/test/unit_columns.cpp" "CMakeFiles/nb.dir/src/test/unit_columns.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_columns.cpp.o.d"
+  "/root/repo/src/test/unit_compare.cpp" "CMakeFiles/nb.dir/src/test/unit_compare.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_compare.cpp.o.d"
+  "/root/repo/src/test/unit_compare_output.cpp" "CMakeFiles/nb.dir/src/test/unit_compare_output.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_compare_output.cpp.o.d"
+  "/root/repo/src/test/unit_compare_shared_libraries.cpp" "CMakeFiles/nb.dir/src/test/unit_compare_shared_libraries.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_compare_shared_libraries.cpp.o.d"
+  "/root/repo/src/test/unit_complexity.cpp" "CMakeFiles/nb.dir/src/test/unit_complexity.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_complexity.cpp.o.d"
+  "/root/repo/src/test/unit_env_config.cpp" "CMakeFiles/nb.dir/src/test/unit_env_config.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_env_config.cpp.o.d"
+  "/root/repo/src/test/unit_epoch_time.cpp" "CMakeFiles/nb.dir/src/test/unit_epoch_time.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_epoch_time.cpp.o.d"
+  "/root/repo/src/test/unit_exact_iters_and_epochs.cpp" "CMakeFiles/nb.dir/src/test/unit_exact_iters_and_epochs.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_exact_iters_and_epochs.cpp.o.d"
+  "/root/repo/src/test/unit_html_report.cpp" "CMakeFiles/nb.dir/src/test/unit_html_report.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_html_report.cpp.o.d"
+  "/root/repo/src/test/unit_json_lines.cpp" "CMakeFiles/nb.dir/src/test/unit_json_lines.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_json_lines.cpp.o.d"
+  "/root/repo/src/test/unit_load_results.cpp" "CMakeFiles/nb.dir/src/test/unit_load_results.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_load_results.cpp.o.d"
+  "/root/repo/src/test/unit_markdown_output.cpp" "CMakeFiles/nb.dir/src/test/unit_markdown_output.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_markdown_output.cpp.o.d"
+  "/root/repo/src/test/unit_mdape.cpp" "CMakeFiles/nb.dir/src/test/unit_mdape.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_mdape.cpp.o.d"
+  "/root/repo/src/test/unit_multi_output.cpp" "CMakeFiles/nb.dir/src/test/unit_multi_output.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_multi_output.cpp.o.d"
+  "/root/repo/src/test/unit_number_format.cpp" "CMakeFiles/nb.dir/src/test/unit_number_format.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_number_format.cpp.o.d"
+  "/root/repo/src/test/unit_outliers.cpp" "CMakeFiles/nb.dir/src/test/unit_outliers.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_outliers.cpp.o.d"
+  "/root/repo/src/test/unit_perf_counter_math.cpp" "CMakeFiles/nb.dir/src/test/unit_perf_counter_math.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_perf_counter_math.cpp.o.d"
+  "/root/repo/src/test/unit_progress.cpp" "CMakeFiles/nb.dir/src/test/unit_progress.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_progress.cpp.o.d"
+  "/root/repo/src/test/unit_relative_batch.cpp" "CMakeFiles/nb.dir/src/test/unit_relative_batch.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_relative_batch.cpp.o.d"
+  "/root/repo/src/test/unit_render_commands.cpp" "CMakeFiles/nb.dir/src/test/unit_render_commands.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_render_commands.cpp.o.d"
+  "/root/repo/src/test/unit_render_errors.cpp" "CMakeFiles/nb.dir/src/test/unit_render_errors.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_render_errors.cpp.o.d"
+  "/root/repo/src/test/unit_result_file.cpp" "CMakeFiles/nb.dir/src/test/unit_result_file.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_result_file.cpp.o.d"
+  "/root/repo/src/test/unit_result_statistics.cpp" "CMakeFiles/nb.dir/src/test/unit_result_statistics.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_result_statistics.cpp.o.d"
+  "/root/repo/src/test/unit_rng.cpp" "CMakeFiles/nb.dir/src/test/unit_rng.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_rng.cpp.o.d"
+  "/root/repo/src/test/unit_setup.cpp" "CMakeFiles/nb.dir/src/test/unit_setup.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_setup.cpp.o.d"
+  "/root/repo/src/test/unit_streaming.cpp" "CMakeFiles/nb.dir/src/test/unit_streaming.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_streaming.cpp.o.d"
+  "/root/repo/src/test/unit_string_view.cpp" "CMakeFiles/nb.dir/src/test/unit_string_view.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_string_view.cpp.o.d"
+  "/root/repo/src/test/unit_templates.cpp" "CMakeFiles/nb.dir/src/test/unit_templates.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_templates.cpp.o.d"
+  "/root/repo/src/test/unit_timeunit.cpp" "CMakeFiles/nb.dir/src/test/unit_timeunit.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_timeunit.cpp.o.d"
+  "/root/repo/src/test/unit_trace.cpp" "CMakeFiles/nb.dir/src/test/unit_trace.cpp.o" "gcc" "CMakeFiles/nb.dir/src/test/unit_trace.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,133 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/nb.dir/src/test/app/doctest.cpp.o"
+  "CMakeFiles/nb.dir/src/test/app/doctest.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/app/nanobench.cpp.o"
+  "CMakeFiles/nb.dir/src/test/app/nanobench.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/example_always_the_same.cpp.o"
+  "CMakeFiles/nb.dir/src/test/example_always_the_same.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/example_atomic.cpp.o"
+  "CMakeFiles/nb.dir/src/test/example_atomic.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/example_branch_misses.cpp.o"
+  "CMakeFiles/nb.dir/src/test/example_branch_misses.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/example_complexity.cpp.o"
+  "CMakeFiles/nb.dir/src/test/example_complexity.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/example_containers.cpp.o"
+  "CMakeFiles/nb.dir/src/test/example_containers.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/example_csv.cpp.o"
+  "CMakeFiles/nb.dir/src/test/example_csv.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/example_hide_output.cpp.o"
+  "CMakeFiles/nb.dir/src/test/example_hide_output.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/example_preconfigured_name.cpp.o"
+  "CMakeFiles/nb.dir/src/test/example_preconfigured_name.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/example_pyperf.cpp.o"
+  "CMakeFiles/nb.dir/src/test/example_pyperf.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/example_random2.cpp.o"
+  "CMakeFiles/nb.dir/src/test/example_random2.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/example_random_number_generators.cpp.o"
+  "CMakeFiles/nb.dir/src/test/example_random_number_generators.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/example_random_uniform01.cpp.o"
+  "CMakeFiles/nb.dir/src/test/example_random_uniform01.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/example_shuffle.cpp.o"
+  "CMakeFiles/nb.dir/src/test/example_shuffle.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/tutorial_compare.cpp.o"
+  "CMakeFiles/nb.dir/src/test/tutorial_compare.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/tutorial_complexity_set.cpp.o"
+  "CMakeFiles/nb.dir/src/test/tutorial_complexity_set.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/tutorial_complexity_sort.cpp.o"
+  "CMakeFiles/nb.dir/src/test/tutorial_complexity_sort.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/tutorial_context.cpp.o"
+  "CMakeFiles/nb.dir/src/test/tutorial_context.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/tutorial_fast_v1.cpp.o"
+  "CMakeFiles/nb.dir/src/test/tutorial_fast_v1.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/tutorial_fast_v2.cpp.o"
+  "CMakeFiles/nb.dir/src/test/tutorial_fast_v2.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/tutorial_fluctuating_v1.cpp.o"
+  "CMakeFiles/nb.dir/src/test/tutorial_fluctuating_v1.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/tutorial_fluctuating_v2.cpp.o"
+  "CMakeFiles/nb.dir/src/test/tutorial_fluctuating_v2.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/tutorial_mustache.cpp.o"
+  "CMakeFiles/nb.dir/src/test/tutorial_mustache.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/tutorial_render_simple.cpp.o"
+  "CMakeFiles/nb.dir/src/test/tutorial_render_simple.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/tutorial_slow_v1.cpp.o"
+  "CMakeFiles/nb.dir/src/test/tutorial_slow_v1.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/tutorial_slow_v2.cpp.o"
+  "CMakeFiles/nb.dir/src/test/tutorial_slow_v2.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_api.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_api.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_baseline.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_baseline.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_bench_config.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_bench_config.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_checkpoint.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_checkpoint.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_cold.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_cold.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_columns.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_columns.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_compare.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_compare.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_compare_output.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_compare_output.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_compare_shared_libraries.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_compare_shared_libraries.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_complexity.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_complexity.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_env_config.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_env_config.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_epoch_time.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_epoch_time.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_exact_iters_and_epochs.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_exact_iters_and_epochs.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_html_report.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_html_report.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_json_lines.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_json_lines.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_load_results.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_load_results.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_markdown_output.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_markdown_output.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_mdape.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_mdape.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_multi_output.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_multi_output.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_number_format.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_number_format.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_outliers.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_outliers.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_perf_counter_math.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_perf_counter_math.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_progress.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_progress.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_relative_batch.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_relative_batch.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_render_commands.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_render_commands.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_render_errors.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_render_errors.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_result_file.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_result_file.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_result_statistics.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_result_statistics.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_rng.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_rng.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_setup.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_setup.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_streaming.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_streaming.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_string_view.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_string_view.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_templates.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_templates.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_timeunit.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_timeunit.cpp.o.d"
+  "CMakeFiles/nb.dir/src/test/unit_trace.cpp.o"
+  "CMakeFiles/nb.dir/src/test/unit_trace.cpp.o.d"
+  "nb"
+  "nb.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/nb.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/nb_compare_op_4.dir/library/compare_op.cpp.o"
+  "CMakeFiles/nb_compare_op_4.dir/library/compare_op.cpp.o.d"
+  "libnb_compare_op_4.pdb"
+  "libnb_compare_op_4.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/nb_compare_op_4.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
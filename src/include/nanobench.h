@@ -39,10 +39,12 @@
 // public facing api - as minimal as possible
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <array>         // markers of the streaming quantile estimator
 #include <chrono>        // high_resolution_clock
 #include <cmath>         // log & exp for the paired A/B statistics
 #include <cstring>       // memcpy
 #include <iosfwd>        // for std::ostream* custom output target in Config
+#include <memory>        // shared_ptr, the Results of a Bench share its Config
 #include <string>        // all names
 #include <unordered_map> // holds context information of results
 #include <vector>        // holds all results
@@ -115,6 +117,15 @@
 #    endif
 #endif
 
+// Bench::compareSharedLibraries() needs dlopen(), which before glibc 2.34 is a library of its own that
+// every program would have to link with -ldl, whether it compares libraries or not. So it is only there
+// where ANKERL_NANOBENCH_DLOPEN is defined along with ANKERL_NANOBENCH_IMPLEMENT.
+#define ANKERL_NANOBENCH_PRIVATE_DLOPEN() 0
+#if defined(ANKERL_NANOBENCH_DLOPEN) && (defined(__unix__) || defined(__APPLE__))
+#    undef ANKERL_NANOBENCH_PRIVATE_DLOPEN
+#    define ANKERL_NANOBENCH_PRIVATE_DLOPEN() 1
+#endif
+
 #if defined(__clang__)
 #    define ANKERL_NANOBENCH_NO_SANITIZE(...) __attribute__((no_sanitize(__VA_ARGS__)))
 #else
@@ -175,6 +186,11 @@ class Result;
 class Rng;
 class BigO;
 class CompareResult;
+class CompareSweep;
+class Template;
+class ResultView;
+class ResultFile;
+class HtmlReport;
 
 namespace detail {
 template <typename SetupOp>
@@ -189,9 +205,14 @@ class SetupRunner;
 // is one indirect call per *epoch*, against an epoch of a millisecond.
 //
 // std::function would not do, because it would put that indirection in the inner loop instead.
+//
+// `setUp`, when it is not nullptr, is the untimed setup that goes before every epoch - see
+// withSetup().
 struct ErasedOp {
     void (*run)(void* op, uint64_t numIters); // NOLINT(misc-non-private-member-variables-in-classes)
     void* op;                                 // NOLINT(misc-non-private-member-variables-in-classes)
+    void (*setUp)(void* setupOp);             // NOLINT(misc-non-private-member-variables-in-classes)
+    void* setupOp;                            // NOLINT(misc-non-private-member-variables-in-classes)
 };
 
 template <typename Op>
@@ -209,10 +230,81 @@ ErasedOp eraseOp(Op&& op) {
     // to fit it through void* is safe - a const lambda's operator() is const or it could not be
     // called at all.
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
-    return ErasedOp{&runErasedOp<Bare>, const_cast<void*>(static_cast<void const*>(&op))};
+    return ErasedOp{&runErasedOp<Bare>, const_cast<void*>(static_cast<void const*>(&op)), nullptr, nullptr};
+}
+
+template <typename SetupOp>
+void runErasedSetup(void* setupOp) {
+    (*static_cast<SetupOp*>(setupOp))();
+}
+
+// An alternative with a setup of its own, see withSetup().
+template <typename SetupOp, typename Op>
+struct SetupAndOp {
+    SetupOp setupOp; // NOLINT(misc-non-private-member-variables-in-classes)
+    Op op;           // NOLINT(misc-non-private-member-variables-in-classes)
+};
+
+// More specialized than the overload above, so an alternative given as withSetup() ends up here.
+template <typename SetupOp, typename Op>
+ErasedOp eraseOp(SetupAndOp<SetupOp, Op>& setupAndOp) {
+    return ErasedOp{&runErasedOp<Op>, &setupAndOp.op, &runErasedSetup<SetupOp>, &setupAndOp.setupOp};
+}
+
+// One of compareSweep()'s alternatives: the operation, and where to read the size it is called with.
+// All of them point at the same size, which compareSweep() changes between one comparison and the
+// next - so the ErasedOp that runs this is built once, and each size is still an ordinary compare().
+struct SizedOp {
+    void* op;        // NOLINT(misc-non-private-member-variables-in-classes)
+    size_t const* n; // NOLINT(misc-non-private-member-variables-in-classes)
+};
+
+template <typename Op>
+void runErasedSizedOp(void* sizedOp, uint64_t numIters) {
+    auto const& sized = *static_cast<SizedOp const*>(sizedOp);
+    auto& concrete = *static_cast<Op*>(sized.op);
+    // read once per epoch, not per call: the size is fixed for the whole comparison
+    auto const n = *sized.n;
+    for (uint64_t i = 0; i < numIters; ++i) {
+        concrete(n);
+    }
 }
+
+// A Result with the given epochs, laid out measure after measure as a Result keeps them: the epochs
+// of measure m are epochs[m * numEpochs, (m + 1) * numEpochs), and a measure counts as recorded when
+// its bit in `has` is set. For results read back from a file, see loadResults().
+Result resultOfEpochs(Config config, std::vector<double> const& epochs, size_t numEpochs, uint32_t has);
+
+// Writes `results` in the binary format, see saveResults().
+void writeResults(std::ostream& out, Result const* results, size_t numResults);
 } // namespace detail
 
+/**
+ * @brief An alternative for compare() that needs its data prepared before every epoch.
+ *
+ * An alternative that changes its data - sorts it, transforms it in place, drains a queue - would
+ * otherwise measure the first epoch on fresh data and every later one on what the previous epoch
+ * left behind. @p setupOp runs before each of its epochs, outside the timed and counted window,
+ * exactly like Bench::setup() does for run():
+ *
+ * @code
+ * bench.epochIterations(1).compare(
+ *     "std::sort",    ankerl::nanobench::withSetup([&] { a = shuffled; }, [&] { std::sort(a.begin(), a.end()); }),
+ *     "radix sort",   ankerl::nanobench::withSetup([&] { b = shuffled; }, [&] { radixSort(b); }));
+ * @endcode
+ *
+ * As with Bench::setup(), the setup runs once per epoch and not once per iteration, so this is
+ * usually combined with epochIterations(1). A setup shared by all alternatives is
+ * `bench.setup(setupOp).compare(...)`; an alternative given with its own setup keeps that one.
+ *
+ * @param setupOp Runs before every epoch of @p op, untimed.
+ * @param op The operation to compare.
+ */
+template <typename SetupOp, typename Op>
+detail::SetupAndOp<typename std::decay<SetupOp>::type, typename std::decay<Op>::type> withSetup(SetupOp&& setupOp, Op&& op) {
+    return {std::forward<SetupOp>(setupOp), std::forward<Op>(op)};
+}
+
 /**
  * @brief Renders output from a mustache-like template and benchmark results.
  *
@@ -260,6 +352,9 @@ ErasedOp eraseOp(Op&& op) {
  *
  *    * `{{context(variableName)}}` See Bench::context.
  *
+ *    * `{{#context}}` Every context variable, sorted by name, with `{{variable}}` for its name and `{{value}}` for its
+ *      value. Ends with `{{/context}}`.
+ *
  *    Apart from these tags, it is also possible to use some mathematical operations on the measurement data. The operations
  *    are of the form `{{command(name)}}`.  Currently `name` can be one of `elapsed`, `iterations`. If performance counters
  *    are available (currently only on current Linux systems), you also have `pagefaults`, `cpucycles`,
@@ -305,6 +400,12 @@ ErasedOp eraseOp(Op&& op) {
  *      sum these results up:
  *      `{{sumProduct(iterations, elapsed)}}`.
  *
+ *    * `{{outliers}}` Number of epochs classified as outliers, 0 unless Bench::outliers() is set.
+ *
+ *    * `{{#filtered}}` Everything above, but over the epochs that are *not* outliers - e.g.
+ *      `{{average(elapsed)}}` next to `{{#filtered}}{{average(elapsed)}}{{/filtered}}` shows what the outliers did to the
+ *      average. Identical to the unfiltered values unless Bench::outliers() is set. Ends with `{{/filtered}}`.
+ *
  *    * `{{#measurement}}` To access individual measurement results, open the begin tag for measurements.
  *
  *       * `{{elapsed}}` Average elapsed wall clock time per iteration, in seconds.
@@ -324,6 +425,15 @@ ErasedOp eraseOp(Op&& op) {
  *
  *       * `{{branchmisses}}` Average number of branches that were missed per iteration.
  *
+ *       * `{{outlier}}` 1 when this epoch was classified as an outlier, 0 otherwise. See Bench::outliers().
+ *
+ *      A measure this epoch has no value for renders as `null`: that is an epoch of a merged result whose
+ *      own run did not record a counter the other runs did, see Result::merge(). A measure no epoch
+ *      recorded renders as 0.
+ *
+ *       * The result's config tags from `{{title}}` to `{{relative}}`, `{{context(variableName)}}` and `{{#context}}`,
+ *         for formats that repeat them in a record per epoch.
+ *
  *    * `{{/measurement}}` Ends the measurement tag.
  *
  * * `{{/result}}` Marks the end of the result layer. This is the end marker for the template part that will be instantiated
@@ -362,6 +472,7 @@ ErasedOp eraseOp(Op&& op) {
    * :cpp:func:`templates::json() <ankerl::nanobench::templates::json()>`
    * :cpp:func:`templates::htmlBoxplot() <ankerl::nanobench::templates::htmlBoxplot()>`
    * :cpp:func:`templates::pyperf() <ankerl::nanobench::templates::pyperf()>`
+   * :cpp:func:`templates::googleBenchmark() <ankerl::nanobench::templates::googleBenchmark()>`
 
    @endverbatim
  *
@@ -383,6 +494,115 @@ void render(std::string const& mustacheTemplate, Bench const& bench, std::ostrea
 void render(char const* mustacheTemplate, std::vector<Result> const& results, std::ostream& out);
 void render(std::string const& mustacheTemplate, std::vector<Result> const& results, std::ostream& out);
 
+/**
+ * @brief Renders a paired comparison from Bench::compare(), for everything the markdown table of
+ *        `operator<<` shows and more, in whatever format a pipeline wants.
+ *
+ * The comparison is not a list of results but of alternatives, each with a result *and* a ratio to
+ * the baseline, so it has a layer of its own:
+ *
+ * * `{{rounds}}`, `{{comparisons}}`, `{{confidence}}`, `{{looks}}`, `{{fastest}}` and
+ *   `{{equivalenceMargin}}` are the comparison's, see CompareResult. They can be used anywhere.
+ *
+ * * `{{#entry}}` Once for each alternative, the baseline first. Ends with `{{/entry}}`. Inside it:
+ *
+ *    * `{{name}}` The alternative's name.
+ *
+ *    * `{{relative}}`, `{{relativeLow}}`, `{{relativeHigh}}` Its median time relative to the baseline
+ *      and the interval for it - note `{{relative}}` is this ratio here, not Bench::relative().
+ *
+ *    * `{{relative(<name>)}}`, `{{relativeLow(<name>)}}`, `{{relativeHigh(<name>)}}` The same for any
+ *      measure, see CompareResult::Entry::ratio().
+ *
+ *    * `{{isSignificant}}`, `{{isDropped}}` 1 or 0, see CompareResult::isSignificant() and
+ *      CompareResult::isDropped().
+ *
+ *    * `{{tiedRounds}}` Rounds in which the alternative and the baseline measured the same.
+ *
+ *    * `{{equivalence}}` One of `equivalent`, `notEquivalent` or `inconclusive`, see
+ *      CompareResult::equivalence().
+ *
+ *    * Everything that is available inside `{{#result}}`, for the alternative's own measurements.
+ *
+ * Outside of `{{#entry}}`, the config tags are the baseline's.
+ *
+ * @code
+ * ankerl::nanobench::render("{{#entry}}{{name}},{{relative}},{{relativeLow}},{{relativeHigh}},{{isSignificant}}\n{{/entry}}",
+ *                           bench.compare(...), std::cout);
+ * @endcode
+ *
+ * @param mustacheTemplate The template.
+ * @param compareResult The comparison to render.
+ * @param out Output for the generated output.
+ */
+void render(char const* mustacheTemplate, CompareResult const& compareResult, std::ostream& out);
+void render(std::string const& mustacheTemplate, CompareResult const& compareResult, std::ostream& out);
+
+/**
+ * @brief Renders the complexity fits from Bench::complexityBigO().
+ *
+ * `{{#bigO}}` is once for each fit, in the order they are given - best first, as complexityBigO()
+ * sorts them. Inside it `{{name}}` is the fit's name, `{{constant}}` its constant, and
+ * `{{normalizedRootMeanSquare}}` its error. Ends with `{{/bigO}}`.
+ *
+ * @param mustacheTemplate The template.
+ * @param bigOs The fits to render.
+ * @param out Output for the generated output.
+ */
+void render(char const* mustacheTemplate, std::vector<BigO> const& bigOs, std::ostream& out);
+void render(std::string const& mustacheTemplate, std::vector<BigO> const& bigOs, std::ostream& out);
+
+namespace templates {
+struct Op;
+} // namespace templates
+
+/**
+ * @brief A mustache template, parsed once and rendered any number of times.
+ *
+ * render() with a string parses the template again on every call, and looks up every tag by name for
+ * every result it writes. That is nothing for one report at the end of a run, but it adds up when the
+ * same json, csv or dashboard template is rendered after each of thousands of benchmarks. A Template
+ * does both when it is constructed, so that rendering is a walk over tags that already know which
+ * config value, command and measure they stand for.
+ *
+ * It keeps what it needs of the text, so the string it was made from can go away, and it is cheap to
+ * copy. The output is exactly that of render() with the same string - including a mistake in the
+ * template, which is reported when rendering reaches it and not when it is constructed.
+ *
+ * @code
+ * ankerl::nanobench::Template const json(ankerl::nanobench::templates::json());
+ * for (...) {
+ *     bench.run(...);
+ *     ankerl::nanobench::render(json, bench, out);
+ * }
+ * @endcode
+ */
+class Template {
+public:
+    explicit Template(char const* mustacheTemplate);
+    explicit Template(std::string const& mustacheTemplate);
+
+private:
+    friend void render(Template const& tpl, std::vector<Result> const& results, std::ostream& out);
+    friend void render(Template const& tpl, CompareResult const& compareResult, std::ostream& out);
+    friend void render(Template const& tpl, std::vector<BigO> const& bigOs, std::ostream& out);
+
+    std::shared_ptr<std::vector<templates::Op> const> mOps;
+};
+
+/**
+ * Same as render(char const* mustacheTemplate, Bench const& bench, std::ostream& out), with a
+ * template that has already been parsed.
+ *
+ * @param tpl The template.
+ * @param bench Benchmark, containing all the results.
+ * @param out Output for the generated output.
+ */
+void render(Template const& tpl, Bench const& bench, std::ostream& out);
+void render(Template const& tpl, std::vector<Result> const& results, std::ostream& out);
+void render(Template const& tpl, CompareResult const& compareResult, std::ostream& out);
+void render(Template const& tpl, std::vector<BigO> const& bigOs, std::ostream& out);
+
 // Contains mustache-like templates
 namespace templates {
 
@@ -400,7 +620,8 @@ char const* csv() noexcept;
 /*!
   @brief HTML output that uses plotly to generate an interactive boxplot chart. See the tutorial for an example output.
 
-  The output uses only the elapsed wall clock time, and displays each epoch as a single dot.
+  The output uses only the elapsed wall clock time, and displays each epoch as a single dot. The page
+  loads plotly from a CDN; for a report that works offline, see ankerl::nanobench::HtmlReport.
   @verbatim embed:rst
   See the tutorial at :ref:`tutorial-template-html` for an example.
   @endverbatim
@@ -428,6 +649,20 @@ char const* pyperf() noexcept;
  */
 char const* json() noexcept;
 
+/*!
+  @brief Output in the JSON format of Google Benchmark, for its `compare.py` and the dashboards that read it.
+
+  Every epoch is a run of type `iteration`, the way Google Benchmark writes each repetition, so a U test over
+  them compares the same samples nanobench's statistics use. Each result ends with its `median` and `mean`
+  aggregates. The time is `real_time` and `cpu_time` alike, in nanoseconds per iteration - nanobench only
+  measures wall clock time. The name is the benchmark's name, followed by its context as named arguments, e.g.
+  `std::sort/alloc:std/type:int`. The performance counters, `complexityN` and `batch` are user counters, and
+  `title` and `unit` are extra keys Google Benchmark's tools ignore.
+
+  loadResults() reads this back, and Google Benchmark's own JSON output as well.
+ */
+char const* googleBenchmark() noexcept;
+
 } // namespace templates
 
 namespace detail {
@@ -437,6 +672,9 @@ struct PerfCountSet;
 
 class IterationLogic;
 class PerformanceCounters;
+struct BaselineFile;
+class CheckpointLog;
+class ConfigRestorer;
 
 #if ANKERL_NANOBENCH(PERF_COUNTERS)
 class LinuxPerformanceCounters;
@@ -462,8 +700,106 @@ struct PerfCountSet {
     T branchMisses{};
 };
 
+// Count, sum, extremes, mean and variance of a stream of values in constant memory. The mean and
+// variance are Welford's: updating a running mean by the difference to it, rather than keeping a
+// sum of squares, does not lose everything to cancellation when the values are large and close
+// together - which per-epoch times after an hour of soak testing are.
+ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
+class RunningStats {
+public:
+    void add(double x) noexcept;
+
+    ANKERL_NANOBENCH(NODISCARD) size_t count() const noexcept;
+    ANKERL_NANOBENCH(NODISCARD) double sum() const noexcept;
+    ANKERL_NANOBENCH(NODISCARD) double mean() const noexcept;
+    // Sample variance, 0 for fewer than two values.
+    ANKERL_NANOBENCH(NODISCARD) double variance() const noexcept;
+    ANKERL_NANOBENCH(NODISCARD) double minimum() const noexcept;
+    ANKERL_NANOBENCH(NODISCARD) double maximum() const noexcept;
+
+private:
+    size_t mCount = 0;
+    double mSum = 0.0;
+    double mMean = 0.0;
+    double mSumSquaredDeviations = 0.0;
+    double mMinimum = 0.0;
+    double mMaximum = 0.0;
+};
+ANKERL_NANOBENCH(IGNORE_PADDED_POP)
+
+// Estimates the p-quantile of a stream of values in constant memory, with Jain and Chlamtac's P²
+// algorithm: five markers whose heights track the minimum, p/2, p, (1+p)/2 and maximum quantiles,
+// nudged after each value by a piecewise-parabolic fit. Exact for the first five values; after that
+// typically within a fraction of a percent of the true quantile for the unimodal, skewed
+// distributions that timings have.
+ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
+class P2Quantile {
+public:
+    explicit P2Quantile(double p) noexcept;
+
+    void add(double x) noexcept;
+
+    ANKERL_NANOBENCH(NODISCARD) size_t count() const noexcept;
+    // The estimate, 0 when nothing was added yet.
+    ANKERL_NANOBENCH(NODISCARD) double value() const noexcept;
+
+private:
+    ANKERL_NANOBENCH(NODISCARD) double parabolic(size_t i, double sign) const noexcept;
+    ANKERL_NANOBENCH(NODISCARD) double linear(size_t i, double sign) const noexcept;
+
+    double mP;
+    size_t mCount = 0;
+    std::array<double, 5> mHeights{};
+    std::array<double, 5> mPositions{};
+    std::array<double, 5> mDesired{};
+    std::array<double, 5> mIncrements{};
+};
+ANKERL_NANOBENCH(IGNORE_PADDED_POP)
+
+// The epochs of one measure, as Result stores them: a view into its storage rather than a copy.
+class MeasurementRange {
+public:
+    MeasurementRange(double const* first, size_t size) noexcept;
+
+    ANKERL_NANOBENCH(NODISCARD) double const* begin() const noexcept;
+    ANKERL_NANOBENCH(NODISCARD) double const* end() const noexcept;
+    ANKERL_NANOBENCH(NODISCARD) size_t size() const noexcept;
+    ANKERL_NANOBENCH(NODISCARD) bool empty() const noexcept;
+
+private:
+    double const* mFirst;
+    size_t mSize;
+};
+
+// Everything a streaming Result keeps about one measure.
+struct StreamingMeasure {
+    RunningStats stats{};                 // NOLINT(misc-non-private-member-variables-in-classes)
+    P2Quantile median{0.5};               // NOLINT(misc-non-private-member-variables-in-classes)
+    P2Quantile absolutePercentError{0.5}; // NOLINT(misc-non-private-member-variables-in-classes)
+};
+
 } // namespace detail
 
+/**
+ * @brief How epochs are classified as outliers, see Bench::outliers().
+ *
+ * An epoch is classified by its time per iteration only, and as a whole: an epoch that an interrupt
+ * made 10x slower has its instructions and branches counted during that interrupt as well.
+ */
+enum class OutlierMethod {
+    none,  ///< Nothing is an outlier. The default.
+    tukey, ///< Outside Tukey's fences, more than 1.5 interquartile ranges below the first or above the third quartile.
+    mad,   ///< A modified z-score above 3.5, i.e. more than ~5.2 median absolute deviations away from the median.
+};
+
+/// What happens to the epochs classified as outliers. @see Bench::outliers()
+enum class OutlierAction {
+    count,     ///< They are only counted, in the `outl` column; every statistic still includes them.
+    exclude,   ///< The table's statistics leave them out. results() and the templates keep both.
+    remeasure, ///< Like exclude, but each outlier among the epochs() asked for is replaced by an extra epoch - up to
+               ///< twice epochs() in total. The extra epochs are not classified again before the run ends.
+};
+
 ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
 struct Config {
     // actual benchmark config
@@ -488,8 +824,27 @@ struct Config {
     std::unordered_map<std::string, std::string> mContext{};               // NOLINT(misc-non-private-member-variables-in-classes)
     // One bit per Column, set when that column is hidden - so the default of 0 shows everything and
     // stays the table nanobench has always printed.
-    uint32_t mHiddenColumns{};                  // NOLINT(misc-non-private-member-variables-in-classes)
-    std::vector<std::string> mContextColumns{}; // NOLINT(misc-non-private-member-variables-in-classes)
+    uint32_t mHiddenColumns{};                           // NOLINT(misc-non-private-member-variables-in-classes)
+    std::vector<std::string> mContextColumns{};          // NOLINT(misc-non-private-member-variables-in-classes)
+    OutlierMethod mOutlierMethod = OutlierMethod::none;  // NOLINT(misc-non-private-member-variables-in-classes)
+    OutlierAction mOutlierAction = OutlierAction::count; // NOLINT(misc-non-private-member-variables-in-classes)
+    bool mStreaming = false;                             // NOLINT(misc-non-private-member-variables-in-classes)
+    std::chrono::nanoseconds mLiveReport{};              // NOLINT(misc-non-private-member-variables-in-classes)
+    std::chrono::nanoseconds mProgress{};                // NOLINT(misc-non-private-member-variables-in-classes)
+    size_t mProgressTotal = 0;                           // NOLINT(misc-non-private-member-variables-in-classes)
+    std::string mBaselinePath{};                         // NOLINT(misc-non-private-member-variables-in-classes)
+    double mBaselineTolerance = 0.05;                    // NOLINT(misc-non-private-member-variables-in-classes)
+    bool mBaselineUpdate = false;                        // NOLINT(misc-non-private-member-variables-in-classes)
+    double mCompareTargetWidth = 0.0;                    // NOLINT(misc-non-private-member-variables-in-classes)
+    bool mCompareRacing = false;                         // NOLINT(misc-non-private-member-variables-in-classes)
+    std::chrono::nanoseconds mCompareTimeBudget = std::chrono::seconds(10); // NOLINT(misc-non-private-member-variables-in-classes)
+    std::string mNoiseFloorPath{};                                          // NOLINT(misc-non-private-member-variables-in-classes)
+    bool mShowConfidenceIntervals = false;                                  // NOLINT(misc-non-private-member-variables-in-classes)
+    double mCompareEquivalenceMargin = 0.0;                                 // NOLINT(misc-non-private-member-variables-in-classes)
+    std::string mJsonLinesPath{};                                           // NOLINT(misc-non-private-member-variables-in-classes)
+    bool mJsonLinesMeasurements = false;                                    // NOLINT(misc-non-private-member-variables-in-classes)
+    std::string mTracePath{};                                               // NOLINT(misc-non-private-member-variables-in-classes)
+    std::string mCheckpointPath{};                                          // NOLINT(misc-non-private-member-variables-in-classes)
 
     Config();
     ~Config();
@@ -521,6 +876,10 @@ public:
 
     explicit Result(Config benchmarkConfig);
 
+    /// Shares the config instead of copying it, which is how a Bench makes its results: a sweep over
+    /// thousands of parameters holds one config per setting that changed, not one per result.
+    explicit Result(std::shared_ptr<Config const> benchmarkConfig);
+
     ~Result();
     Result& operator=(Result const& other);
     Result& operator=(Result&& other) noexcept(ANKERL_NANOBENCH(NOEXCEPT_STRING_MOVE));
@@ -548,20 +907,246 @@ public:
     ANKERL_NANOBENCH(NODISCARD) bool empty() const noexcept;
     ANKERL_NANOBENCH(NODISCARD) size_t size() const noexcept;
 
+    /// One flag per epoch, set for those that the config's OutlierMethod classifies as outliers by
+    /// their elapsed time. All false for OutlierMethod::none. @see Bench::outliers()
+    ANKERL_NANOBENCH(NODISCARD) std::vector<bool> outlierEpochs() const;
+
+    /// Number of epochs flagged by outlierEpochs().
+    ANKERL_NANOBENCH(NODISCARD) size_t numOutliers() const;
+
+    /// A copy without the epochs flagged by outlierEpochs(), every measure of them - so the
+    /// statistics of the copy are those of the remaining epochs.
+    ANKERL_NANOBENCH(NODISCARD) Result withoutOutliers() const;
+
+    /**
+     * @brief Appends the epochs of @p other, the same benchmark run again - in another process, on
+     *        another shard.
+     *
+     * The statistics are then those of all the epochs together. Only a run of the same benchmark can
+     * be merged: the same title, name, context and complexityN, which is what a baseline file keys
+     * a benchmark by, and the same unit and batch, so that an epoch means the same in both. A
+     * measure that only one of them recorded - a counter that was available on one machine and not
+     * on the other - is kept: get() is NaN for the epochs that do not have it, and its statistics
+     * are those of the epochs that do.
+     *
+     * @throws std::runtime_error for a result of another benchmark, or for a streaming result,
+     *         which has no epochs to merge.
+     */
+    Result& merge(Result const& other);
+
+    /**
+     * @brief True when this Result keeps running statistics instead of every epoch, see Bench::streaming().
+     *
+     * Then median() and medianAbsolutePercentError() are P² estimates, average(), sum(), minimum(),
+     * maximum() and sumProduct() are exact, get() throws because there is no individual epoch to
+     * return, and outlierEpochs() is empty.
+     *
+     * The MdAPE needs the median to measure each epoch against, and the final one is only known at
+     * the end. Each epoch is measured against the median estimated when it came in instead, so the
+     * first few dozen epochs' errors are against a median that is still moving: early on, and for a
+     * short run, the MdAPE comes out higher than the exact one. Over a long run this washes out.
+     */
+    ANKERL_NANOBENCH(NODISCARD) bool streaming() const noexcept;
+
     // Finds string, if not found, returns _size.
     static Measure fromString(std::string const& str);
 
 private:
+    // the binary format is this class's storage written out, and read back in
+    friend class ResultView;
+    friend void detail::writeResults(std::ostream& out, Result const* results, size_t numResults);
+    friend Result detail::resultOfEpochs(Config config, std::vector<double> const& epochs, size_t numEpochs, uint32_t has);
+
     // The per-epoch values of one measure. Every accessor above goes through this, so how the
-    // measures are stored - including the extra slot the constructor explains - is written down once
-    // rather than asserted at a dozen call sites.
-    ANKERL_NANOBENCH(NODISCARD) std::vector<double> const& measurements(Measure m) const;
+    // measures are stored is written down once rather than asserted at a dozen call sites.
+    ANKERL_NANOBENCH(NODISCARD) detail::MeasurementRange measurements(Measure m) const;
+
+    // Makes room for numEpochs epochs of every stored measure, keeping those already there.
+    void reserveEpochs(size_t numEpochs);
+
+    // Lays the buffer out for exactly these measures. Only while there are no epochs yet.
+    void storeMeasures(uint32_t measures);
+
+    // Where measure idx starts in mMeasurements, in units of mCapacity.
+    ANKERL_NANOBENCH(NODISCARD) size_t slotOf(size_t idx) const noexcept;
+
+    // Feeds one epoch's value of a measure to the running statistics.
+    void record(Measure m, double value);
+
+    std::shared_ptr<Config const> mConfig;
+
+    // The stored measures in one allocation, measure after measure: the epochs of measure m are
+    // mMeasurements[slotOf(m) * mCapacity, slotOf(m) * mCapacity + mNumEpochs). It is sized for the
+    // config's epochs at the first add(), so a result is one allocation rather than one per measure
+    // and regrowth. Only the measures in mStored have room, which the first epoch decides: without
+    // performance counters that is elapsed and iterations, not all eight.
+    std::vector<double> mMeasurements{};
+    size_t mCapacity = 0;
+    size_t mNumEpochs = 0;
+    uint32_t mStored = 0;
+
+    // One bit per measure that every epoch has. The counters a process can read do not change
+    // between epochs, so in practice a measure is either in all of them or in none.
+    uint32_t mHas = 0;
+
+    // A copy of the values of a measure, without the epochs a merged result is missing it in, for the
+    // caller to reorder. The median and the MdAPE select in such a copy. Nothing is cached, so that
+    // the const accessors of one Result can be called from several threads at once.
+    ANKERL_NANOBENCH(NODISCARD) std::vector<double> values(Measure m) const;
+
+    // Only used when streaming: the running statistics per measure, and the running sum of the
+    // product of every pair of measures, so sumProduct() does not need the epochs either.
+    std::vector<detail::StreamingMeasure> mStreamed{};
+    std::vector<double> mStreamedProducts{};
+};
+ANKERL_NANOBENCH(IGNORE_PADDED_POP)
 
-    Config mConfig{};
-    std::vector<std::vector<double>> mNameToMeasurements{};
+/**
+ * @brief Saves results in nanobench's binary format, to be read back with ResultFile.
+ *
+ * The json template with every epoch in it is hundreds of MB for a large sweep, and slow to parse
+ * back. The binary format is the way a Result stores itself anyway - every epoch of one measure in
+ * one contiguous array of doubles - written out as it is. That makes reading it back a matter of
+ * mapping the file into memory, with no parsing at all. It is a file in native byte order, for the
+ * machine and later runs that made it, not for exchange; ResultFile rejects one of the other byte
+ * order.
+ *
+ * All of it is 64-bit words, so every array in a mapped file is aligned:
+ *
+ * - A header of 5 words: the magic `nanobnch`, the format version 1, the byte order mark
+ *   0x0102030405060708, the number of results, and the size of the string table in words.
+ * - The string table: every string once, each terminated by a 0 byte, padded with 0 to a whole
+ *   word. A string is referred to by its byte offset in this table.
+ * - One record per result. 17 words of config: title, name and unit (string offsets), batch and
+ *   complexityN (doubles), epochs, clockResolutionMultiple, maxEpochTime and minEpochTime (in
+ *   nanoseconds), minEpochIterations, epochIterations, warmup, relative, the OutlierMethod, a mask
+ *   with bit m set for every Result::Measure m that was recorded, the number of epochs, and the
+ *   number of context variables. Then two string offsets, name and value, per context variable,
+ *   sorted by name. Then for each measure in the mask, in Result::Measure order, its value for every
+ *   epoch as doubles.
+ *
+ * A streaming result keeps no epochs, so it is saved with none.
+ *
+ * @param path File to write. It is replaced if it exists.
+ * @param results The results to save.
+ * @return false when the file could not be written.
+ */
+bool saveResults(std::string const& path, std::vector<Result> const& results);
+bool saveResults(std::string const& path, Bench const& bench);
+
+/**
+ * @brief One result of a ResultFile, read directly from the mapped file.
+ *
+ * Nothing is copied: the strings and the epochs are where the file put them, and valid for as long
+ * as the ResultFile is. toResult() makes a Result of it, for render() and everything else that works
+ * on one.
+ */
+class ResultView {
+public:
+    ANKERL_NANOBENCH(NODISCARD) char const* title() const noexcept;
+    ANKERL_NANOBENCH(NODISCARD) char const* name() const noexcept;
+    ANKERL_NANOBENCH(NODISCARD) char const* unit() const noexcept;
+
+    /// Everything that was saved of the config, copied into a Config.
+    ANKERL_NANOBENCH(NODISCARD) Config config() const;
+
+    /// Number of epochs.
+    ANKERL_NANOBENCH(NODISCARD) size_t size() const noexcept;
+    ANKERL_NANOBENCH(NODISCARD) bool has(Result::Measure m) const noexcept;
+
+    /// The value of @p m for every epoch, size() doubles. nullptr when @p m was not recorded.
+    ANKERL_NANOBENCH(NODISCARD) double const* measure(Result::Measure m) const noexcept;
+
+    ANKERL_NANOBENCH(NODISCARD) Result toResult() const;
+
+private:
+    friend class ResultFile;
+    friend class detail::CheckpointLog;
+    ResultView(uint64_t const* record, char const* strings) noexcept;
+
+    ANKERL_NANOBENCH(NODISCARD) uint64_t field(size_t idx) const noexcept;
+
+    uint64_t const* mRecord;
+    char const* mStrings;
+};
+
+/**
+ * @brief A file written by saveResults(), mapped into memory.
+ *
+ * Opening it checks the header and that every record lies within the file, and nothing else is read
+ * until it is asked for. A file that is missing, truncated, of the other byte order or not a result
+ * file at all is not valid() and has no results - like a missing baseline file, it is not an
+ * exception. Where there is no mmap(), or it fails, the file is read into memory instead, with the same
+ * result.
+ */
+ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
+class ResultFile {
+public:
+    explicit ResultFile(std::string const& path);
+    ~ResultFile();
+
+    // the views point into the mapping, which is unmapped once
+    ResultFile(ResultFile const&) = delete;
+    ResultFile& operator=(ResultFile const&) = delete;
+    ResultFile(ResultFile&&) = delete;
+    ResultFile& operator=(ResultFile&&) = delete;
+
+    ANKERL_NANOBENCH(NODISCARD) bool valid() const noexcept;
+    ANKERL_NANOBENCH(NODISCARD) size_t size() const noexcept;
+
+    /// @p idx must be less than size().
+    ANKERL_NANOBENCH(NODISCARD) ResultView operator[](size_t idx) const noexcept;
+
+    /// Every result as a Result, e.g. to render() them with any template.
+    ANKERL_NANOBENCH(NODISCARD) std::vector<Result> results() const;
+
+private:
+    void* mMapped = nullptr;
+    size_t mMappedBytes = 0;
+    std::vector<uint64_t> mBuffer{};
+    std::vector<uint64_t const*> mRecords{};
+    char const* mStrings = nullptr;
+    bool mIsValid = false;
 };
 ANKERL_NANOBENCH(IGNORE_PADDED_POP)
 
+/**
+ * @brief Reads back results that nanobench saved: with saveResults(), Bench::jsonLines() or
+ *        templates::json().
+ *
+ * The format is told by the contents. A JSON file may hold any number of values, which is what
+ * makes a JSON Lines file one: each value is either a result, an object with a `results` array of
+ * them as templates::json() writes it, or the output of Google Benchmark - its own, or what
+ * templates::googleBenchmark() writes. There every repetition of a benchmark is an epoch, named
+ * arguments such as `size:8` are its context, and the aggregates are left out. Every key nanobench
+ * writes for the config is read back, along with the `context` that JSON Lines adds. The epochs
+ * come from the `measurements` - without them a result has its config but no epochs, and so no
+ * statistics either. JSON has no way to say that a measure was not recorded, so a performance
+ * counter that is 0 in every epoch reads as not recorded. A `null` is an epoch of a merged result
+ * without a value for that measure, and reads back as one.
+ *
+ * Loaded results are Results like any other: render() them with any template, merge() the runs of
+ * a benchmark from several processes with mergeResults(), or fit them with complexityBigO().
+ *
+ * @throws std::runtime_error when the file cannot be read, or is neither format.
+ */
+std::vector<Result> loadResults(std::string const& path);
+
+/**
+ * @brief Merges every result into the first one of the same benchmark, see Result::merge().
+ *
+ * Results of different benchmarks are kept apart, in the order they first appear - so the results of
+ * several repetitions of a suite, one after the other, come out as one suite with all the epochs.
+ */
+std::vector<Result> mergeResults(std::vector<Result> const& results);
+
+/// Whether an alternative is within the margin of the baseline, see Bench::compareEquivalence().
+enum class Equivalence {
+    equivalent,    ///< The whole interval lies within the margin.
+    notEquivalent, ///< The whole interval lies outside the margin, on one side of it.
+    inconclusive,  ///< The interval straddles the margin: more rounds could decide it either way.
+};
+
 /**
  * @brief The outcome of a paired comparison, see Bench::compare().
  *
@@ -583,6 +1168,13 @@ ANKERL_NANOBENCH(IGNORE_PADDED_POP)
 ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
 class CompareResult {
 public:
+    /// A ratio to the baseline, and the interval for it.
+    struct Ratio {
+        double relative;     // NOLINT(misc-non-private-member-variables-in-classes)
+        double relativeLow;  // NOLINT(misc-non-private-member-variables-in-classes)
+        double relativeHigh; // NOLINT(misc-non-private-member-variables-in-classes)
+    };
+
     /// One alternative: its measurements, and how it compares to the baseline.
     ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
     struct Entry {
@@ -597,11 +1189,29 @@ public:
         double relativeLow;  // NOLINT(misc-non-private-member-variables-in-classes)
         double relativeHigh; // NOLINT(misc-non-private-member-variables-in-classes)
         size_t tiedRounds;   // NOLINT(misc-non-private-member-variables-in-classes)
+
+        /**
+         * @brief The ratio to the baseline and its interval for any measure, performance counters
+         *        included.
+         *
+         * Every round records the counters along with the time, and they pair up the same way. An
+         * instruction count barely varies from one round to the next, so its interval is far narrower
+         * than the time's: a 1% reduction in instructions can be resolved where the same 1% in time is
+         * lost in the noise. In the same direction as `relative`, so above 1 means this alternative
+         * counted fewer, and at the same confidence. All 0 when either side did not record @p measure.
+         */
+        ANKERL_NANOBENCH(NODISCARD) Ratio ratio(Result::Measure measure) const noexcept;
+
+        /// The ratios ratio() returns, indexed by Result::Measure.
+        std::vector<Ratio> measureRatios{}; // NOLINT(misc-non-private-member-variables-in-classes)
     };
     ANKERL_NANOBENCH(IGNORE_PADDED_POP)
 
     CompareResult(std::vector<Entry> entries, size_t numRounds);
 
+    /// A result whose intervals were built at @p confidence, after looking at them @p looks times.
+    CompareResult(std::vector<Entry> entries, size_t numRounds, double confidence, size_t looks);
+
     /// Number of alternatives compared, including the baseline.
     ANKERL_NANOBENCH(NODISCARD) size_t size() const noexcept;
 
@@ -624,6 +1234,20 @@ public:
      */
     ANKERL_NANOBENCH(NODISCARD) size_t comparisons() const noexcept;
 
+    /// Confidence each individual interval was built at, so that the whole table holds at 95%.
+    ANKERL_NANOBENCH(NODISCARD) double confidence() const noexcept;
+
+    /**
+     * @brief How often the intervals were looked at to decide whether to stop.
+     *
+     * 1, unless Bench::compareTargetWidth() made the comparison sequential. Every look is one more
+     * chance to stop on a lucky interval, which is what confidence() was lowered for.
+     */
+    ANKERL_NANOBENCH(NODISCARD) size_t looks() const noexcept;
+
+    /// True when compareRacing() stopped running this alternative before the others finished.
+    ANKERL_NANOBENCH(NODISCARD) bool isDropped(size_t idx) const;
+
     /**
      * @brief True when this alternative's interval excludes the baseline, i.e. the measurement told
      *        them apart. Always false for the baseline itself.
@@ -633,9 +1257,22 @@ public:
     /// Index of the alternative with the lowest median time.
     ANKERL_NANOBENCH(NODISCARD) size_t fastest() const;
 
+    /// The margin the comparison was run with, see Bench::compareEquivalence(). 0 when none.
+    ANKERL_NANOBENCH(NODISCARD) double equivalenceMargin() const;
+
+    /**
+     * @brief Whether this alternative is within equivalenceMargin() of the baseline.
+     *
+     * Always Equivalence::equivalent for the baseline itself, and Equivalence::inconclusive for every
+     * other entry when there is no margin.
+     */
+    ANKERL_NANOBENCH(NODISCARD) Equivalence equivalence(size_t idx) const;
+
 private:
     std::vector<Entry> mEntries{};
     size_t mRounds{};
+    double mConfidence{};
+    size_t mLooks{};
 };
 ANKERL_NANOBENCH(IGNORE_PADDED_POP)
 
@@ -643,6 +1280,47 @@ ANKERL_NANOBENCH(IGNORE_PADDED_POP)
 /// a summary line under it.
 std::ostream& operator<<(std::ostream& os, CompareResult const& compareResult);
 
+/**
+ * @brief compare() at each of several sizes, see Bench::compareSweep().
+ *
+ * One CompareResult per size, in the order the sizes were given. Each of them is a complete paired
+ * comparison with its own calibration and its own intervals, exactly as if compare() had been
+ * called once per size.
+ */
+ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
+class CompareSweep {
+public:
+    CompareSweep(std::vector<size_t> sizes, std::vector<CompareResult> results);
+
+    /// Number of sizes compared at.
+    ANKERL_NANOBENCH(NODISCARD) size_t size() const noexcept;
+
+    /// The sizes, in the order they were compared at.
+    ANKERL_NANOBENCH(NODISCARD) std::vector<size_t> const& sizes() const noexcept;
+
+    /// The comparison at sizes()[idx].
+    ANKERL_NANOBENCH(NODISCARD) CompareResult const& operator[](size_t idx) const;
+
+    /**
+     * @brief Indices at which the fastest alternative differs from the one at the size before.
+     *
+     * An index `i` in here means the winner changed somewhere between sizes()[i - 1] and sizes()[i]:
+     * that is as close as the sweep can place a crossover, so sizes that are closer together around it
+     * place it more closely. The fastest is CompareResult::fastest(), so between two alternatives that
+     * were not told apart this can flip back and forth - the table says which crossovers were resolved.
+     */
+    ANKERL_NANOBENCH(NODISCARD) std::vector<size_t> crossovers() const;
+
+private:
+    std::vector<size_t> mSizes{};
+    std::vector<CompareResult> mResults{};
+};
+ANKERL_NANOBENCH(IGNORE_PADDED_POP)
+
+/// Writes the sweep as a markdown table, one row per size and one column per alternative, with the
+/// crossovers under it.
+std::ostream& operator<<(std::ostream& os, CompareSweep const& compareSweep);
+
 /**
  * An extremely fast random generator. Currently, this implements *RomuDuoJr*, developed by Mark Overton. Source:
  * http://www.romu-random.org/
@@ -788,20 +1466,56 @@ private:
  * @see ankerl::nanobench::Bench::hideColumn()
  */
 enum class Column : size_t {
-    relative,      ///< `relative` - only shown when Bench::relative() is set.
-    complexityN,   ///< `complexityN` - only shown when Bench::complexityN() is set.
-    timePerUnit,   ///< `ns/op` - time for one unit.
-    unitPerSecond, ///< `op/s` - units per second.
-    error,         ///< `err%` - median absolute percentage error over the epochs.
-    instructions,  ///< `ins/op` - retired instructions, Linux only.
-    cycles,        ///< `cyc/op` - CPU cycles, Linux only.
-    ipc,           ///< `IPC` - instructions per cycle, Linux only.
-    branches,      ///< `bra/op` - retired branch instructions, Linux only.
-    branchMisses,  ///< `miss%` - percentage of branches mispredicted, Linux only.
-    total,         ///< `total` - wall clock time spent measuring this row.
-    _size          ///< Not a column; the number of them.
+    relative,         ///< `relative` - only shown when Bench::relative() is set.
+    complexityN,      ///< `complexityN` - only shown when Bench::complexityN() is set.
+    timePerUnit,      ///< `ns/op` - time for one unit.
+    unitPerSecond,    ///< `op/s` - units per second.
+    error,            ///< `err%` - median absolute percentage error over the epochs.
+    instructions,     ///< `ins/op` - retired instructions, Linux only.
+    cycles,           ///< `cyc/op` - CPU cycles, Linux only.
+    ipc,              ///< `IPC` - instructions per cycle, Linux only.
+    branches,         ///< `bra/op` - retired branch instructions, Linux only.
+    branchMisses,     ///< `miss%` - percentage of branches mispredicted, Linux only.
+    total,            ///< `total` - wall clock time spent measuring this row.
+    outliers,         ///< `outl` - epochs classified as outliers, only shown when Bench::outliers() is set.
+    baseline,         ///< `vs. base` - change against the saved baseline, only shown when Bench::baseline() is set.
+    medianInterval,   ///< `median 95% CI` - interval for the median time, only shown when Bench::confidenceIntervals() is set.
+    relativeInterval, ///< `relative 95% CI` - interval for `relative`, only shown when both it and Bench::confidenceIntervals() are.
+    _size             ///< Not a column; the number of them.
+};
+
+/// How a benchmark compares to its saved baseline, see Bench::baseline().
+enum class BaselineVerdict {
+    unchanged, ///< The interval includes no change, or the change is within the tolerance.
+    faster,    ///< Faster by more than the tolerance, and the interval excludes no change.
+    slower,    ///< Slower by more than the tolerance, and the interval excludes no change.
 };
 
+/// One benchmark compared to its saved baseline, see Bench::baseline().
+ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
+struct BaselineComparison {
+    std::string name;        // NOLINT(misc-non-private-member-variables-in-classes)
+    double relative;         // NOLINT(misc-non-private-member-variables-in-classes)
+    double relativeLow;      // NOLINT(misc-non-private-member-variables-in-classes)
+    double relativeHigh;     // NOLINT(misc-non-private-member-variables-in-classes)
+    BaselineVerdict verdict; // NOLINT(misc-non-private-member-variables-in-classes)
+};
+ANKERL_NANOBENCH(IGNORE_PADDED_POP)
+
+/// How noisy compare() is on this machine, measured by comparing identical code, see
+/// Bench::calibrateNoise().
+ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
+struct NoiseFloor {
+    /// A/A comparisons made, and the paired rounds each of them ran.
+    size_t runs;   // NOLINT(misc-non-private-member-variables-in-classes)
+    size_t rounds; // NOLINT(misc-non-private-member-variables-in-classes)
+    /// How many of them resolved a difference that is not there.
+    size_t falsePositives; // NOLINT(misc-non-private-member-variables-in-classes)
+    /// Median half-width of their intervals relative to the ratio, e.g. 0.02 for ±2%.
+    double halfWidth; // NOLINT(misc-non-private-member-variables-in-classes)
+};
+ANKERL_NANOBENCH(IGNORE_PADDED_POP)
+
 /**
  * @brief Main entry point to nanobench's benchmarking facility.
  *
@@ -815,6 +1529,9 @@ enum class Column : size_t {
  * In that example Bench() constructs the benchmark, it is then configured with unit() and batch(), and after configuration a
  * benchmark is executed with run(). Once run() has finished, it prints the result to `std::cout`. It would also store the results
  * in the Bench instance, but in this case the object is immediately destroyed so it's not available any more.
+ *
+ * The results of the same configuration share one copy of it, which run() takes when the configuration changed since the last
+ * run(). A sweep that changes complexityN() or context() before every run() still gives every result a copy of its own.
  */
 ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
 class Bench {
@@ -929,8 +1646,12 @@ public:
 
      @endverbatim
      *
+     * An alternative that changes its data needs it prepared again before every epoch: give it as
+     * withSetup(setupOp, op), or share one setup between all of them with
+     * `bench.setup(setupOp).compare(...)`. Either runs outside the timed window.
+     *
      * @tparam Args Alternating names and operations.
-     * @param args `name, op` pairs; at least two.
+     * @param args `name, op` pairs; at least two. An op may be a withSetup().
      * @return The ratios and their intervals; also written to output() unless that is nullptr.
      */
     template <typename... Args>
@@ -938,17 +1659,162 @@ public:
     CompareResult compare(Args&&... args);
 
     /**
-     * @brief Title of the benchmark, will be shown in the table header. Changing the title will start a new markdown table.
+     * @brief compare(), with each alternative a build of a shared library.
      *
-     * @param benchmarkTitle The title of the benchmark.
+     * compare() can only interleave operations compiled into the same binary, while the question is
+     * usually whether the library built from this branch is faster than the one built from main.
+     * This loads each of @p paths and compares the function @p symbol exported by each of them,
+     * with exactly the same calibration, interleaving and statistics as compare(). The first path is
+     * the baseline, and each row is named after its path.
+     *
+     * The function runs its own loop, so that the call into the library happens once per epoch and
+     * the operation inlines into that loop the way it was built:
+     *
+     * @code
+     * extern "C" void nanobench_op(uint64_t numIters) {
+     *     for (uint64_t i = 0; i < numIters; ++i) {
+     *         ankerl::nanobench::doNotOptimizeAway(parse(input));
+     *     }
+     * }
+     * @endcode
+     *
+     * On glibc each library is loaded with dlmopen() into a namespace of its own, so two builds that
+     * share a soname, or that depend on different builds of a third library, do not resolve each
+     * other's symbols. Elsewhere they are loaded with dlopen() and RTLD_LOCAL, which keeps the
+     * libraries apart but not their dependencies. They are unloaded again before this returns.
+     *
+     * This is only there where the translation unit with `ANKERL_NANOBENCH_IMPLEMENT` also defines
+     * `ANKERL_NANOBENCH_DLOPEN`, since dlopen() needs linking with `-ldl` before glibc 2.34; the CMake
+     * target `nanobench::nanobench` does both. Everywhere else this throws.
+     *
+     * Throws std::runtime_error when a library or its symbol cannot be loaded, and on platforms
+     * without dlopen().
+     *
+     * @param paths At least two shared libraries, the first one being the baseline.
+     * @param symbol Name of the `extern "C" void (uint64_t numIters)` function each of them exports.
+     * @return The ratios and their intervals; also written to output() unless that is nullptr.
      */
-    Bench& title(char const* benchmarkTitle);
-    Bench& title(std::string const& benchmarkTitle);
+    CompareResult compareSharedLibraries(std::vector<std::string> const& paths, std::string const& symbol);
 
     /**
-     * @brief Gets the title of the benchmark
+     * @brief compare(), repeated at each of @p sizes, to see where one alternative overtakes another.
+     *
+     * Which of two data structures or algorithms is faster often depends on the size of the input: a
+     * linear search beats a binary search up to some size, insertion sort beats std::sort up to some
+     * other one. A single compare() answers for one size only, and the question is usually where the
+     * answer changes. This runs the same paired, interleaved comparison at every size, and writes one
+     * table with a row per size and the ratio and interval for each alternative, followed by the
+     * sizes between which the fastest one changes.
+     *
+     * Here the operations take the size as their argument, and are called as `op(n)`:
+     *
+     * @code
+     * bench.compareSweep({4, 16, 64, 256, 1024},
+     *     "linear", [&](size_t n) { ankerl::nanobench::doNotOptimizeAway(linearFind(data, n)); },
+     *     "binary", [&](size_t n) { ankerl::nanobench::doNotOptimizeAway(binaryFind(data, n)); });
+     * @endcode
+     *
+     * Each size is calibrated on its own, and complexityN() is set to the size while it runs, so the
+     * Result of every entry carries its size along. The intervals hold at 95% per size; across the whole
+     * sweep, one of them being wrong is correspondingly more likely. compareTargetWidth() and
+     * compareRacing() apply to each size separately.
+     *
+     * @param sizes At least one size, usually in increasing order.
+     * @param args `name, op` pairs, at least two, where each op is callable with a size_t.
+     * @return One CompareResult per size; also written to output() as one table unless that is nullptr.
      */
-    ANKERL_NANOBENCH(NODISCARD) std::string const& title() const noexcept;
+    template <typename... Args>
+    CompareSweep compareSweep(std::vector<size_t> const& sizes, Args&&... args);
+
+    /**
+     * @brief Makes compare() run until every interval is narrower than @p relativeHalfWidth.
+     *
+     * compare() otherwise decides on its number of rounds up front, from epochs(), and a noisy
+     * comparison then ends with "no difference resolved" where a few more rounds would have
+     * resolved it. With a target width it runs epochs() rounds first, then keeps adding rounds,
+     * about half as many again each time, until every alternative's interval lies within
+     * @p relativeHalfWidth of its ratio - or until compareTimeBudget() is used up.
+     *
+     * Stopping on whichever interval happens to be narrow enough is a test repeated at every look, and
+     * would hold at well under 95% if each look were made at 95%. So the error rate is spent across
+     * the looks: look @f$ k @f$ builds its intervals at an error rate of
+     * @f$ \alpha / (k (k + 1)) @f$, which sums to @f$ \alpha @f$ over any number of looks. The
+     * rounds growing geometrically is what keeps the number of looks, and so the widening, small.
+     *
+     * @param relativeHalfWidth E.g. 0.01 for an interval of ±1% around the ratio. 0, the default, runs a
+     *        fixed number of rounds.
+     */
+    Bench& compareTargetWidth(double relativeHalfWidth) noexcept;
+    ANKERL_NANOBENCH(NODISCARD) double compareTargetWidth() const noexcept;
+
+    /**
+     * @brief Makes compare() decide whether each alternative is within @p margin of the baseline.
+     *
+     * compare() says "faster", "slower" or "no difference resolved", and the last one is not what a
+     * refactoring of a hot path needs to be accepted: that needs "proven to be within 2%". This is the
+     * equivalence test for it - two one-sided tests, one against each edge of the margin, which comes
+     * down to asking where the interval lies. An alternative whose whole interval is within
+     * @p margin of 1 is Equivalence::equivalent, one whose whole interval is outside it is
+     * Equivalence::notEquivalent, and one whose interval straddles an edge is
+     * Equivalence::inconclusive. The summary says which, for each alternative.
+     *
+     * The intervals are the ones the table shows, so each of the two one-sided tests is made at
+     * 2.5% rather than the textbook 5%: stricter, which is the safe side for a gate.
+     *
+     * An inconclusive alternative is one more rounds could decide, so with a margin compare() keeps
+     * adding rounds until every alternative is decided, in the same way and under the same
+     * compareTimeBudget() as compareTargetWidth(), and spending the error rate across the looks the
+     * same way too.
+     *
+     * @param margin Relative, e.g. 0.02 for ±2%, measured on the log scale so that it is as far above
+     *        the baseline as below it. 0, the default, switches it off.
+     */
+    Bench& compareEquivalence(double margin) noexcept;
+    ANKERL_NANOBENCH(NODISCARD) double compareEquivalence() const noexcept;
+
+    /**
+     * @brief Most time a compare() with a compareTargetWidth() or a compareEquivalence() spends before
+     *        it stops regardless.
+     *
+     * The intervals it ends with are valid however it stopped, only wider than asked for.
+     *
+     * @param budget Time for the whole comparison, calibration included. Default is 10 seconds.
+     */
+    Bench& compareTimeBudget(std::chrono::nanoseconds budget) noexcept;
+    ANKERL_NANOBENCH(NODISCARD) std::chrono::nanoseconds compareTimeBudget() const noexcept;
+
+    /**
+     * @brief Makes compare() stop running alternatives that are clearly slower than the fastest.
+     *
+     * With ten or twenty variants to compare, the ones that were 3x slower after the first few
+     * rounds get as many rounds as the close contenders, and those rounds decide nothing. Racing
+     * looks at the alternatives after a few rounds, and then again each time about half as many
+     * rounds again have run. An alternative whose interval against the current leader lies entirely
+     * on the slower side is dropped, and the remaining rounds go to the others. It runs epochs()
+     * rounds in total, or more with compareTargetWidth().
+     *
+     * The baseline is never dropped, since every ratio in the result is measured against it. A
+     * dropped alternative stays in the CompareResult with the rounds it got, paired with the
+     * baseline's first rounds, and is marked in the table. The looks spend the error rate the same
+     * way compareTargetWidth() does, so the intervals still hold at 95% together.
+     *
+     * @param enabled True to race. Default is false.
+     */
+    Bench& compareRacing(bool enabled) noexcept;
+    ANKERL_NANOBENCH(NODISCARD) bool compareRacing() const noexcept;
+
+    /**
+     * @brief Title of the benchmark, will be shown in the table header. Changing the title will start a new markdown table.
+     *
+     * @param benchmarkTitle The title of the benchmark.
+     */
+    Bench& title(char const* benchmarkTitle);
+    Bench& title(std::string const& benchmarkTitle);
+
+    /**
+     * @brief Gets the title of the benchmark
+     */
+    ANKERL_NANOBENCH(NODISCARD) std::string const& title() const noexcept;
 
     /// Name of the benchmark, will be shown in the table row.
     Bench& name(char const* benchmarkName);
@@ -1165,6 +2031,314 @@ public:
     Bench& performanceCounters(bool showPerformanceCounters) noexcept;
     ANKERL_NANOBENCH(NODISCARD) bool performanceCounters() const noexcept;
 
+    /**
+     * @brief Classifies epochs as outliers, and decides what happens to them.
+     *
+     * An interrupt or a page cache hiccup makes the occasional epoch 10x slower. The median shrugs
+     * that off, but average(), maximum(), sumProduct() and with them the `total` column do not. With
+     * a method set, the table gets an `outl` column counting the epochs that were classified as
+     * outliers, and depending on @p action they are also left out of the table's statistics or
+     * measured again:
+     *
+     *     bench.outliers(OutlierMethod::mad, OutlierAction::exclude).run(...);
+     *
+     * Only what is *shown* changes: results() keeps every epoch, Result::withoutOutliers() is the
+     * filtered view, and templates have both - see render(). `total` is always all epochs, because
+     * the time was spent either way.
+     *
+     * @param method How to classify, OutlierMethod::none to switch it off. Default is none.
+     * @param action What to do with the epochs classified as outliers. Default is count.
+     */
+    Bench& outliers(OutlierMethod method, OutlierAction action = OutlierAction::count) noexcept;
+    ANKERL_NANOBENCH(NODISCARD) OutlierMethod outlierMethod() const noexcept;
+    ANKERL_NANOBENCH(NODISCARD) OutlierAction outlierAction() const noexcept;
+
+    /**
+     * @brief Adds 95% confidence intervals for the median and for `relative` to the table.
+     *
+     * `err%` is the spread of the epochs around their median, which says how much one epoch can be
+     * trusted but not how precisely the median itself is known - that also depends on how many epochs
+     * there were. And `relative` has no uncertainty attached at all, so a row at 99% reads as 1% slower
+     * when the measurement could not tell. With this set the table gets two more columns:
+     *
+     * - `median 95% CI`, where the median lies with 95% confidence, as offsets from it. The same
+     *   distribution-free interval compare() uses, from the order statistics of the epochs, so it needs
+     *   at least six of them.
+     * - `relative 95% CI` next to `relative`, when that is shown: the interval for the ratio to the
+     *   first run. The two runs' epochs are not paired, so it is the Mann-Whitney interval around the
+     *   Hodges-Lehmann estimate that baseline() uses. Two runs one after the other also differ in what
+     *   the machine did meanwhile, which no interval from within either of them can see - use
+     *   compare() for a difference that has to hold up.
+     *
+     * @param enabled True to show the columns. Default is false.
+     */
+    Bench& confidenceIntervals(bool enabled) noexcept;
+    ANKERL_NANOBENCH(NODISCARD) bool confidenceIntervals() const noexcept;
+
+    /**
+     * @brief Keeps running statistics instead of every epoch, so memory stays constant however long it runs.
+     *
+     * A Result normally stores every measure of every epoch, which is what makes its statistics exact
+     * and the `{{#measurement}}` templates possible - and what makes a run of millions of epochs grow
+     * without bound. Streaming keeps a count, sum, extremes and Welford's mean and variance per
+     * measure, plus P² estimators for the median and the MdAPE. The table looks the same; see
+     * Result::streaming() for what changes.
+     *
+     * `NANOBENCH_ENDLESS` always streams, so an endless run's Result has no epochs: its
+     * `{{#measurement}}` renders nothing, and its `err%` is the estimate Result::streaming() describes.
+     *
+     * @param enabled True to stream. Default is false.
+     */
+    Bench& streaming(bool enabled) noexcept;
+    ANKERL_NANOBENCH(NODISCARD) bool streaming() const noexcept;
+
+    /**
+     * @brief Reports progress of a running benchmark every @p interval.
+     *
+     * Each report is a table row with the epochs so far, the median time per unit and `err%` over all
+     * of them, and the median over just the epochs since the previous report - the `window` - with
+     * its difference to the overall median as `drift%`. A soak test that slowly degrades shows it
+     * there while it happens, rather than as one median at the end.
+     *
+     * `NANOBENCH_ENDLESS` reports every 10 seconds unless this is set, since it never gets to the end.
+     *
+     * @param interval Time between reports, 0 to switch them off. Default is 0.
+     */
+    Bench& liveReport(std::chrono::nanoseconds interval) noexcept;
+    ANKERL_NANOBENCH(NODISCARD) std::chrono::nanoseconds liveReport() const noexcept;
+
+    /**
+     * @brief Writes what is running, and how long it is going to take, to `stderr` while a long suite
+     *        runs.
+     *
+     * A table row is only printed once its benchmark is done, so a suite of long epochs says nothing
+     * for minutes at a time, and nothing at all about how much longer it has to go. With progress
+     * switched on, a line like
+     *
+     *     nanobench: [12/2000] hash maps / insert: epoch 4/11, ~0.8s left, ~1h 02m left in the suite
+     *
+     * is written to `stderr` at most once per @p interval: the benchmark, the epoch it is at -
+     * `calibrating` while it is still warming up or finding the number of iterations - and the time
+     * it has left. That is the epochs still to go times the time of one: the target time of an epoch
+     * until one was measured, then the average of those measured. The suite's part is only there
+     * with a progressTotal(), estimated from the benchmarks of this bench done so far.
+     *
+     * The line is written between two epochs, never while one is measured, and to `stderr`, so it
+     * stays out of output() and whatever is rendered there. `progress=1s` in `NANOBENCH_CONFIG`
+     * switches it on without recompiling.
+     *
+     * @param interval Minimum time between two lines, 0 to switch them off. Default is 0.
+     */
+    Bench& progress(std::chrono::nanoseconds interval) noexcept;
+    ANKERL_NANOBENCH(NODISCARD) std::chrono::nanoseconds progress() const noexcept;
+
+    /**
+     * @brief The number of benchmarks this bench is going to run, for the suite's part of progress().
+     *
+     * A bench does not know how many more times it is going to be run. When the caller does, this
+     * adds the position in the suite and the time the whole suite has left to each progress line.
+     *
+     * @param numBenchmarks Number of run() calls the suite makes on this bench, 0 for unknown. Default
+     *        is 0.
+     */
+    Bench& progressTotal(size_t numBenchmarks) noexcept;
+    ANKERL_NANOBENCH(NODISCARD) size_t progressTotal() const noexcept;
+
+    /**
+     * @brief Compares each benchmark to its epochs saved in @p path by an earlier run.
+     *
+     * relative() only compares within one process. With a baseline file the epochs of a benchmark
+     * are kept across runs, keyed by title, name, context and complexityN. The next run compares its
+     * epochs against them and adds a `vs. base` column saying whether it got faster, slower or
+     * neither. A benchmark that is not in the file yet is saved there and shows as `new`.
+     *
+     * The epochs of the two runs are not paired, so the comparison is the Hodges-Lehmann estimate of
+     * the time ratio: the median over every pair of one epoch from each run, with the 95%
+     * confidence interval of the Mann-Whitney test around it. A benchmark is only called faster or
+     * slower when that interval excludes no change *and* the estimate is off by more than
+     * baselineTolerance(). Two processes differ in ways one process never sees - code alignment,
+     * address space layout, what else the machine is doing - and the tolerance is there to absorb
+     * that.
+     *
+     * Streaming results keep no epochs, so they are neither compared nor saved.
+     *
+     * The file is read once per bench, by its first run() with it. A new benchmark is appended to it
+     * as one line; an update writes the whole file next to it and renames it over it, so a process
+     * killed in the middle keeps the previous baseline.
+     *
+     * @param path File to load from and save to. Empty switches baselines off, which is the default.
+     */
+    Bench& baseline(std::string const& path);
+    ANKERL_NANOBENCH(NODISCARD) std::string const& baseline() const noexcept;
+
+    /**
+     * @brief Smallest change against the baseline that counts as faster or slower.
+     *
+     * @param tolerance Relative change, e.g. 0.05 for 5%. Default is 0.05.
+     */
+    Bench& baselineTolerance(double tolerance) noexcept;
+    ANKERL_NANOBENCH(NODISCARD) double baselineTolerance() const noexcept;
+
+    /**
+     * @brief Overwrites the saved epochs of benchmarks that are already in the baseline file.
+     *
+     * By default a baseline stays what it was when it was first saved, so a regression does not
+     * become the new normal by merely being run. Setting the environment variable
+     * `NANOBENCH_UPDATE_BASELINE` to anything but `0` does the same for a whole process, which is
+     * how a baseline is accepted from the command line.
+     *
+     * @param enabled True to overwrite. Default is false.
+     */
+    Bench& baselineUpdate(bool enabled) noexcept;
+    ANKERL_NANOBENCH(NODISCARD) bool baselineUpdate() const noexcept;
+
+    /**
+     * @brief Appends each result to a JSON Lines file as soon as its benchmark is done.
+     *
+     * render() works on the results once they are all there, so a suite that crashes at benchmark
+     * 1,900 of 2,000 has nothing to show for the first 1,899, and nothing can watch a long run while it
+     * is going. With a JSON Lines file every run() adds one line to it, a JSON object with the same
+     * keys templates::json() writes for a result plus its `context` and `outliers`, and closes the
+     * file again: each line is on disk the moment its benchmark has finished, ready for whoever tails
+     * the file.
+     *
+     * The environment variable `NANOBENCH_JSON_LINES` names a file for every Bench in the process that
+     * does not have one of its own.
+     *
+     * compare() and its relatives write nothing there, their rounds are not results of their own.
+     *
+     * @param path File to append to. Empty switches it off, which is the default.
+     * @param withMeasurements True to add the `measurements` array, one object per epoch. It makes
+     *        the lines a lot longer, so it is off by default.
+     */
+    Bench& jsonLines(std::string const& path, bool withMeasurements = false);
+    ANKERL_NANOBENCH(NODISCARD) std::string const& jsonLines() const noexcept;
+    ANKERL_NANOBENCH(NODISCARD) bool jsonLinesMeasurements() const noexcept;
+
+    /**
+     * @brief Records the timeline of every run() in a Chrome trace file, to see where the time of a
+     *        slow or noisy suite went.
+     *
+       @verbatim embed:rst
+       The table shows what each benchmark measured, but not how it got there: how long the warmup
+       took, how many epochs it needed to find the number of iterations, whether one epoch in the
+       middle took ten times as long, or how much of the suite's time went into setup() between the
+       epochs. With a trace file every run() appends its timeline as `Chrome trace events
+       <https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU>`_, which
+       `Perfetto <https://ui.perfetto.dev>`_ and ``chrome://tracing`` open offline:
+
+       * a span for the benchmark as a whole, with its title and context,
+       * inside it a ``calibration`` span for the benchmark's preparation, which the first time
+         includes measuring the clock's resolution,
+       * a span for each epoch, named after the phase it was run in - ``warmup``,
+         ``upscaling_runtime``, or ``epoch 3`` once it is measuring - with its number of iterations,
+         its time per iteration, and the performance counters' totals for the epoch,
+       * between the epochs a ``between epochs`` span, which is the setup() when there is one, and
+         nanobench's own bookkeeping - before the first epoch of a process, mostly setting up the
+         performance counters,
+       * and a counter track of the time per iteration of each epoch.
+
+       The spans are kept in memory while the benchmark runs and only written once it is done, so
+       tracing adds no I/O between the epochs. The first benchmark of a process to use a file starts
+       it over; everything after that in the same process is appended to it. The array is never
+       closed, which the trace event format allows, so that the file is complete after each benchmark
+       - and after a crash.
+
+       The environment variable ``NANOBENCH_TRACE`` names a file for every Bench in the process that
+       does not have one of its own. compare() and its relatives are not traced, their rounds are
+       not results of their own.
+       @endverbatim
+     *
+     * @param path File to write the trace to. Empty switches it off, which is the default.
+     */
+    Bench& trace(std::string const& path);
+    ANKERL_NANOBENCH(NODISCARD) std::string const& trace() const noexcept;
+
+    /**
+     * @brief Keeps each finished benchmark in a file, so that a suite that was killed half way
+     *        through picks up where it stopped.
+     *
+       @verbatim embed:rst
+       A preempted machine or a timed out job otherwise means measuring everything again, including
+       the hour of benchmarks that were already done. With a checkpoint file, every run() that measured
+       all its epochs saves its result there before the next benchmark starts. When the process is
+       started again with the same file, a run() that finds its benchmark in it does not run the
+       benchmark at all: its saved epochs are taken as they are, and the row, the baseline comparison
+       and the result in :cpp:func:`results() <ankerl::nanobench::Bench::results()>` come out the way
+       they did the first time. So whatever is rendered at the end is the same as after a run that was
+       never interrupted.
+
+       A benchmark is found by its title, name, context and complexityN, and a hash of the settings
+       that decide how it is measured - epochs, warmup, the epoch times and iterations, the clock
+       resolution multiple, the outlier method, batch and unit. Change any of them and the benchmark
+       is measured again rather than reusing what a different setup measured. A benchmark that is
+       run several times under the same name gets its saved results in the order they were saved,
+       one per run(). Only what a previous process saved there is restored, never what this process has
+       saved since, whichever bench saved it. Delete the file to start over.
+
+       Each result is appended to the file as it is done, in the binary format of
+       :cpp:func:`ankerl::nanobench::saveResults()` - so the file is a log of such files, one per
+       result, that :cpp:func:`ankerl::nanobench::loadResults()` does not read. Saving a result costs
+       the same however many came before it. A process killed while appending leaves a result cut
+       short at the end, which the next process to use the file drops. A file with no complete result
+       in it - anything else that happens to be at that path - is left alone, with a warning, and
+       nothing is checkpointed there. A result read from the
+       checkpoint is not appended to the jsonLines() file or the trace() again, the interrupted run
+       already did that.
+
+       The environment variable ``NANOBENCH_CHECKPOINT`` names a file for every Bench in the process
+       that does not have one of its own. Streaming results and compare() and its relatives are not
+       checkpointed, the former have no epochs to save and the latter no results of their own.
+       @endverbatim
+     *
+     * @param path File to keep the results in. Empty switches it off, which is the default.
+     */
+    Bench& checkpoint(std::string const& path);
+    ANKERL_NANOBENCH(NODISCARD) std::string const& checkpoint() const noexcept;
+
+    /**
+     * @brief Measures how often compare() calls identical code different on this machine.
+     *
+     * A 95% interval is meant to call identical code different once in twenty comparisons, but on a
+     * shared CI runner nobody knows whether it does: a noisy neighbour that comes and goes breaks the
+     * assumption that the rounds are independent, and with it the 95%. This runs @p runs comparisons
+     * of one operation against itself - with this bench's epochs(), epoch times and counters, so at
+     * the resolution its own compare() calls run at - and counts how many of them resolved a
+     * difference that is not there. Along with that rate it reports the median width of their
+     * intervals, which is the smallest difference a compare() with these settings can resolve here.
+     *
+     * The result is written to output(), and saved to noiseFloor() when that is set, where every later
+     * compare() with the same file reads it from. Those then warn when the machine called identical
+     * code different clearly more often than 5% of the time - more often than 5% would have done
+     * with 99% probability - and when compareTargetWidth() asks for an interval narrower than the
+     * noise floor.
+     *
+     * compareTargetWidth(), compareEquivalence() and compareRacing() are off while calibrating, so
+     * every run is the same fixed number of rounds.
+     *
+     * @param runs Number of A/A comparisons. The rate is a count out of this, so 40, the default,
+     *        tells 5% from 15% but not from 7%.
+     */
+    NoiseFloor calibrateNoise(size_t runs = 40);
+
+    /**
+     * @brief File that calibrateNoise() saves the noise floor to, and that compare() reads it from.
+     *
+     * @param path Empty, the default, neither saves nor warns.
+     */
+    Bench& noiseFloor(std::string const& path);
+    ANKERL_NANOBENCH(NODISCARD) std::string const& noiseFloor() const noexcept;
+
+    /// Every benchmark run by this bench that had a saved baseline to compare to, in run order.
+    ANKERL_NANOBENCH(NODISCARD) std::vector<BaselineComparison> const& baselineComparisons() const noexcept;
+
+    /**
+     * @brief 1 when any benchmark compared slower than its baseline, 0 otherwise.
+     *
+     * For gating a CI job on performance: `return bench.baselineExitStatus();` from main().
+     */
+    ANKERL_NANOBENCH(NODISCARD) int baselineExitStatus() const noexcept;
+
     /**
      * @brief Removes a column from the table.
      *
@@ -1319,6 +2493,7 @@ public:
      */
     Bench& render(char const* templateContent, std::ostream& os);
     Bench& render(std::string const& templateContent, std::ostream& os);
+    Bench& render(Template const& tpl, std::ostream& os);
 
     Bench& config(Config const& benchmarkConfig);
     ANKERL_NANOBENCH(NODISCARD) Config const& config() const noexcept;
@@ -1378,6 +2553,34 @@ private:
         compareCollect(names, ops, std::forward<Rest>(rest)...);
     }
 
+    template <typename SetupOp, typename... Args>
+    CompareResult compareWithSetup(SetupOp& setupOp, Args&&... args);
+
+    // compareCollect() for compareSweep(), whose operations take the size as an argument. `sized` has to
+    // have room for all of them already, since each ErasedOp points into it.
+    static void compareSweepCollect(std::vector<std::string>& /*names*/, std::vector<detail::SizedOp>& /*sized*/,
+                                    std::vector<detail::ErasedOp>& /*ops*/, size_t const& /*n*/) {}
+
+    template <typename Name, typename Op, typename... Rest>
+    static void compareSweepCollect(std::vector<std::string>& names, std::vector<detail::SizedOp>& sized,
+                                    std::vector<detail::ErasedOp>& ops, size_t const& n, Name&& name, Op&& op, Rest&&... rest) {
+        using Bare = typename std::remove_reference<Op>::type;
+        names.emplace_back(std::forward<Name>(name));
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        sized.push_back(detail::SizedOp{const_cast<void*>(static_cast<void const*>(&op)), &n});
+        ops.push_back(detail::ErasedOp{&detail::runErasedSizedOp<Bare>, &sized.back(), nullptr, nullptr});
+        compareSweepCollect(names, sized, ops, n, std::forward<Rest>(rest)...);
+    }
+
+    // Runs compareImpl() once per size, with `n` set to that size, and prints the sweep as one table.
+    CompareSweep compareSweepImpl(std::vector<size_t> const& sizes, std::vector<std::string> const& names,
+                                  std::vector<detail::ErasedOp> const& ops, size_t& n);
+
+    // Whether a sequential compare() has what it was asked for at this look: intervals narrow enough
+    // for compareTargetWidth(), and every alternative decided for compareEquivalence().
+    ANKERL_NANOBENCH(NODISCARD)
+    bool isCompareDone(std::vector<Result> const& results, double confidence) const;
+
     // The measuring half, which no longer needs to know the operations' types.
     ANKERL_NANOBENCH(NODISCARD)
     CompareResult compareImpl(std::vector<std::string> const& names, std::vector<detail::ErasedOp> const& ops);
@@ -1401,9 +2604,28 @@ private:
 
     template <typename SetupOp>
     friend class detail::SetupRunner;
+    friend class detail::ConfigRestorer;
+
+    // IterationLogic makes the Result, with sharedConfig().
+    friend class detail::IterationLogic;
+
+    // The config for writing. Every setter goes through this, and nothing else writes to mConfig, so
+    // that the next run() knows to take a new snapshot of it.
+    Config& mutableConfig() noexcept;
+
+    // A snapshot of mConfig for the results, taken at the first run() after it changed. Results of the
+    // same setup share it, and a setter never writes to a config a result has.
+    std::shared_ptr<Config const> const& sharedConfig();
 
     Config mConfig{};
+    std::shared_ptr<Config const> mSharedConfig{};
     std::vector<Result> mResults{};
+    std::vector<BaselineComparison> mBaselineComparisons{};
+    // wall time of the benchmarks that showed progress, to estimate the rest of the suite from
+    std::chrono::nanoseconds mProgressElapsed{};
+    size_t mProgressBenchmarks = 0;
+    // the baseline file as this bench has read and written it, so that a run() does not parse it again
+    std::shared_ptr<detail::BaselineFile> mBaselineFile{};
 };
 ANKERL_NANOBENCH(IGNORE_PADDED_POP)
 
@@ -1453,7 +2675,7 @@ void doNotOptimizeAway(T& val) {
 ANKERL_NANOBENCH(IGNORE_EFFCPP_PUSH)
 class IterationLogic {
 public:
-    explicit IterationLogic(Bench const& bench);
+    explicit IterationLogic(Bench& bench);
     IterationLogic(IterationLogic&&) = delete;
     IterationLogic& operator=(IterationLogic&&) = delete;
     IterationLogic(IterationLogic const&) = delete;
@@ -1461,8 +2683,14 @@ public:
     ~IterationLogic();
 
     ANKERL_NANOBENCH(NODISCARD) uint64_t numIters() const noexcept;
-    void add(std::chrono::nanoseconds elapsed, PerformanceCounters const& pc) noexcept;
-    void moveResultTo(std::vector<Result>& results) noexcept;
+    // The epoch that ran from before to after. The time points rather than the difference, so that a
+    // trace can place the epoch on its timeline.
+    void add(Clock::time_point before, Clock::time_point after, PerformanceCounters const& pc) noexcept;
+    // Writes the result to the baseline, checkpoint, JSON Lines and trace files the config names.
+    void writeResultFiles();
+    // Hands the result, and its comparison to the baseline if there was one, to the bench. Growing
+    // the bench's lists allocates, so a bad_alloc leaves run() like any other.
+    void moveResultTo(Bench& bench);
 
 private:
     struct Impl;
@@ -1487,13 +2715,19 @@ public:
 
     ANKERL_NANOBENCH(NODISCARD) PerfCountSet<uint64_t> const& val() const noexcept;
     ANKERL_NANOBENCH(NODISCARD) PerfCountSet<bool> const& has() const noexcept;
+    // The counters perf_event_open handed out, whether or not the kernel then ever ran them.
+    ANKERL_NANOBENCH(NODISCARD) PerfCountSet<bool> const& opened() const noexcept;
 
 private:
 #if ANKERL_NANOBENCH(PERF_COUNTERS)
+    // Takes the counters out of has() whose group has failed, so that they are not reported as zeros.
+    void dropFailedCounters();
+
     LinuxPerformanceCounters* mPc = nullptr;
 #endif
     PerfCountSet<uint64_t> mVal{};
     PerfCountSet<bool> mHas{};
+    PerfCountSet<bool> mOpened{};
 };
 ANKERL_NANOBENCH(IGNORE_PADDED_POP)
 
@@ -1519,6 +2753,31 @@ ANKERL_NANOBENCH(NODISCARD) bool isColumnVisible(Config const& config, Column co
 void printStabilityInformationOnce(std::ostream* outStream);
 void printPerformanceCounterHintOnce(std::ostream* outStream, bool wantsPerformanceCounters);
 
+// The text of that note for the given set of live counters: empty when every one of them works, the
+// whole story when no hardware counter does, and otherwise which counters are measured and which are
+// not - a VM that virtualizes only part of the PMU is exactly the case where a column silently
+// missing is least expected. A counter that is in `opened` but not live was refused by nothing: the
+// kernel just never ran it, which has other causes than a failed perf_event_open and is said so.
+// Separate from the printing so it is testable without perf events.
+ANKERL_NANOBENCH(NODISCARD) std::string performanceCounterNote(PerfCountSet<bool> const& has, PerfCountSet<bool> const& opened);
+
+// The counters of `has` that are still live, asking `isLive` with the value each one writes to in
+// `val`. Once after calibrating, and again whenever a group fails in the middle of a run: from then
+// on it reads zeros, which must not end up in a column as if they were measured. Separate from the
+// counters so it is testable without perf events.
+template <typename IsLive>
+ANKERL_NANOBENCH(NODISCARD)
+PerfCountSet<bool> liveCounters(PerfCountSet<bool> const& has, PerfCountSet<uint64_t> const& val, IsLive&& isLive) {
+    PerfCountSet<bool> live;
+    live.pageFaults = has.pageFaults && isLive(&val.pageFaults);
+    live.cpuCycles = has.cpuCycles && isLive(&val.cpuCycles);
+    live.contextSwitches = has.contextSwitches && isLive(&val.contextSwitches);
+    live.instructions = has.instructions && isLive(&val.instructions);
+    live.branchInstructions = has.branchInstructions && isLive(&val.branchInstructions);
+    live.branchMisses = has.branchMisses && isLive(&val.branchMisses);
+    return live;
+}
+
 // The last table settings written to this stream. When they change, a new header is written.
 uint64_t& streamHeaderHash(std::ostream& os);
 
@@ -1578,6 +2837,10 @@ std::vector<double> pairedLogRatios(std::vector<double> const& a, std::vector<do
 // against the baseline, but between any two of them.
 std::vector<double> pairedLogRatios(Result const& a, Result const& b);
 
+// ... or over any other measure of theirs, the performance counters included. Empty when either of
+// them did not record it.
+std::vector<double> pairedLogRatios(Result const& a, Result const& b, Result::Measure m);
+
 // Median of a copy of the values. 0.0 when there are none.
 double medianOf(std::vector<double> values);
 
@@ -1614,6 +2877,245 @@ double bonferroniConfidence(size_t numComparisons) noexcept;
 // a tool whose output ends up in a pull request.
 std::pair<double, double> medianInterval(std::vector<double> values, double confidence);
 
+// The `median 95% CI` column: the 95% interval of the median time per unit, as offsets in percent
+// from the median, "-0.8% .. +1.2%". Empty with too few epochs for an interval.
+std::string medianIntervalText(Result const& shown);
+
+// True when every alternative's interval against the baseline lies within `relativeHalfWidth` of its
+// ratio, on the log scale so that "within 1%" means the same above the ratio as below it. Entry 0 of
+// `results` is the baseline.
+bool isCompareNarrowEnough(std::vector<Result> const& results, double confidence, double relativeHalfWidth);
+
+// Where an interval of log ratios lies relative to ±`margin`, see Bench::compareEquivalence().
+Equivalence equivalenceOf(std::pair<double, double> const& logInterval, double margin);
+
+// True when every alternative still running has an equivalence that is not inconclusive. Entry 0 of
+// `results` is the baseline.
+bool isCompareEquivalenceDecided(std::vector<Result> const& results, double confidence, double margin);
+
+// Runs the alternative's setup, if it has one.
+void setUpErasedOp(ErasedOp const& op);
+
+// Half-width of an entry's interval relative to its ratio, on the log scale as compareTargetWidth()
+// measures it: the wider of the two sides, so 0.02 means the interval lies within ±2% of the ratio.
+double compareHalfWidth(CompareResult::Entry const& entry);
+
+// The noise floor file's format: a header line, then runs, rounds, falsePositives and halfWidth.
+// Loading returns false for a file that is missing or is not a noise floor file.
+bool saveNoiseFloor(std::string const& path, NoiseFloor const& noiseFloor);
+bool loadNoiseFloor(std::string const& path, NoiseFloor& noiseFloor);
+
+// What compare() adds under its summary when the noise floor says the machine is too noisy for the
+// comparison it was asked for. Nothing when it is not.
+void writeNoiseFloorWarnings(std::ostream& os, NoiseFloor const& noiseFloor, double targetWidth);
+
+// The paired ratio of `baseline` to `alternative` and its interval, for every measure, indexed by
+// Result::Measure. All 0 for a measure either of them did not record.
+std::vector<CompareResult::Ratio> compareMeasureRatios(Result const& baseline, Result const& alternative, double confidence);
+
+// Racing: removes from `running` every alternative whose interval against the current leader - the
+// running one with the lowest median - lies entirely on the slower side. Never removes the baseline,
+// entry 0 of `results`. All of `running` must have run the same rounds.
+void dropSlowerThanLeader(std::vector<Result> const& results, std::vector<uint32_t>& running, double confidence);
+
+// Which of the values are outliers by `method`, one flag per value. Both methods are robust: the
+// fences come from quartiles or from the median absolute deviation, which a few 10x epochs barely
+// move, rather than from a mean and standard deviation that they drag along with them.
+//
+// Flags nothing with fewer than four values, where a quartile is one of the values it is meant to
+// judge, and nothing when the spread is 0. The latter is a clock too coarse for the operation:
+// most epochs read the same tick, and calling every epoch one tick off an outlier would throw away
+// the data rather than the disturbances.
+std::vector<bool> outlierFlags(std::vector<double> const& values, OutlierMethod method);
+
+// The epochs of a baseline file, per benchmark key, in the order they are in the file.
+using BaselineEntries = std::vector<std::pair<std::string, std::vector<double>>>;
+
+// What a benchmark is saved under in a baseline file: title, name, and - so that the runs of a sweep
+// do not overwrite each other - its context and complexityN.
+std::string baselineKey(Config const& config);
+
+// An unreadable or missing file, or one that is not a baseline file, has no entries. A last line that
+// was cut short, by a process killed while appending it, is not an entry either.
+BaselineEntries loadBaseline(std::string const& path);
+// Writes the whole file next to `path` and renames it over it, so that being killed in the middle of
+// writing keeps the previous baseline rather than half of one.
+bool saveBaseline(std::string const& path, BaselineEntries const& entries);
+// Adds one entry to the end of an existing baseline file.
+bool appendBaseline(std::string const& path, BaselineEntries::value_type const& entry);
+// Whether the file at `path` ends in a newline, so that a line appended to it is a line of its own
+// rather than the end of one that was cut short.
+bool endsInNewline(std::string const& path);
+
+// A baseline file as a bench reads and writes it, see Bench::baseline(): read by the first run() that
+// uses it, then kept in step with what the bench saves there, so that neither a run() nor a save that
+// appends has to parse the whole file again. A save that rewrites the whole file reads it again first,
+// since other benches may share it.
+ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
+struct BaselineFile {
+    std::string path{};         // NOLINT(misc-non-private-member-variables-in-classes)
+    BaselineEntries entries{};  // NOLINT(misc-non-private-member-variables-in-classes)
+    bool isLoaded = false;      // NOLINT(misc-non-private-member-variables-in-classes)
+};
+ANKERL_NANOBENCH(IGNORE_PADDED_POP)
+
+// The entries of the baseline file at `path`, read unless `file` already has them.
+BaselineEntries& baselineEntries(BaselineFile& file, std::string const& path);
+
+// Renames `from` over `to`, also where rename() does not replace an existing file.
+bool renameOver(std::string const& from, std::string const& to);
+
+// A checkpoint file as a process uses it, see Bench::checkpoint(). The file is a log: every result saved
+// there is appended as a saveResults() file of its own, so that saving one costs the same however many
+// came before it. Opening it notes where each result is and under which checkpointKey(), and keeps
+// nothing else; the epochs of one are read when a run() restores it.
+//
+// Each file is opened once per process, by the first bench that uses it, so only what a previous
+// process saved there is restored - never what this one has saved since, by any bench. A key that is
+// run several times - the same name in a loop - gets its saved results in the order they were saved:
+// the first run() the first one, the second run() the second.
+ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
+class CheckpointLog {
+public:
+    // Opens the file at `path`: what is in it, and a result cut short at its end cut off. A file that
+    // is there but has no complete result in it is not a checkpoint, and is left alone with
+    // checkpointing off.
+    explicit CheckpointLog(std::string path);
+
+    // This process's log of the file at `path`, opened the first time it is asked for.
+    static CheckpointLog& of(std::string const& path);
+
+    // Forgets what this process found in the file at `path`, so that the next bench to use it opens it
+    // again the way a new process would.
+    static void forget(std::string const& path);
+
+    // Restores the next result of `config`'s benchmark into `result`, with its epochs and `config`.
+    // False when the file has no more results for it.
+    bool restore(Config const& config, Result& result);
+
+    // Appends `result` to the file. True without writing anything when checkpointing is off for it.
+    ANKERL_NANOBENCH(NODISCARD) bool append(Result const& result) const;
+
+private:
+    // Where a saved result is: the saveResults() file it is in, in words from the start of the log, and
+    // its index there.
+    struct Entry {
+        uint64_t offset; // NOLINT(misc-non-private-member-variables-in-classes)
+        uint64_t size;   // NOLINT(misc-non-private-member-variables-in-classes)
+        size_t index;    // NOLINT(misc-non-private-member-variables-in-classes)
+    };
+
+    std::string mPath;
+    bool mIsOff = false;
+    std::unordered_map<std::string, std::vector<Entry>> mEntries{};
+    // how many run()s of each key there have been
+    std::unordered_map<std::string, size_t> mNumRuns{};
+};
+ANKERL_NANOBENCH(IGNORE_PADDED_POP)
+
+// The words of a result record in the binary format, see saveResults(). The context pairs and then
+// the measures follow.
+enum class ResultField : size_t {
+    title,
+    name,
+    unit,
+    batch,
+    complexityN,
+    epochs,
+    clockResolutionMultiple,
+    maxEpochTime,
+    minEpochTime,
+    minEpochIterations,
+    epochIterations,
+    warmup,
+    relative,
+    outlierMethod,
+    has,
+    numEpochs,
+    numContext,
+    _size
+};
+
+// Checks a whole binary result file of `numWords` words and finds its string table and its records.
+// False, with `records` in whatever state, for anything that is not a complete file of this byte order.
+bool indexResultFile(uint64_t const* words, size_t numWords, char const*& strings, std::vector<uint64_t const*>& records);
+
+// The results in text that loadResults() found not to be a binary file: any number of JSON values,
+// each a result, an object with a `results` array of them, or Google Benchmark's output. Throws std::runtime_error naming the
+// offset of the first thing that is not JSON.
+std::vector<Result> resultsFromJson(std::string const& text);
+
+// Why two results cannot be merged, or empty when they can, see Result::merge().
+std::string mergeMismatch(Config const& a, Config const& b);
+
+// The models complexityBigO() fits, with the function of n each one is.
+struct ComplexityModel {
+    char const* name;        // NOLINT(misc-non-private-member-variables-in-classes)
+    double (*scale)(double); // NOLINT(misc-non-private-member-variables-in-classes)
+};
+std::vector<ComplexityModel> const& complexityModels();
+
+// The JSON Lines file a result goes to: its own, or else the one NANOBENCH_JSON_LINES names. Empty for
+// none.
+std::string jsonLinesPath(Config const& config);
+
+// The name Result::fromString() reads back as `measure`, and "" for _size.
+char const* measureName(Result::Measure measure) noexcept;
+
+// One result as a line of JSON, newline included, see Bench::jsonLines().
+void writeJsonLine(std::ostream& os, Result const& result, bool withMeasurements);
+
+// A time left as a progress line shows it, see Bench::progress(): as precise as it is worth being,
+// "4.2s", "42s", "3m 12s" or "1h 02m".
+std::string progressDuration(std::chrono::nanoseconds duration);
+
+// One epoch on a benchmark's timeline, see Bench::trace(). `phase` is the state the iteration logic
+// was in - "warmup", "upscaling_runtime" or "measuring" - and `epoch` the epoch's index in the result
+// when it was measuring. The counters are the totals of the whole epoch. A span of no iterations is
+// not an epoch but the "calibration" before the first one.
+ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
+struct TraceSpan {
+    char const* phase;               // NOLINT(misc-non-private-member-variables-in-classes)
+    Clock::time_point begin;         // NOLINT(misc-non-private-member-variables-in-classes)
+    Clock::time_point end;           // NOLINT(misc-non-private-member-variables-in-classes)
+    uint64_t iterations;             // NOLINT(misc-non-private-member-variables-in-classes)
+    size_t epoch;                    // NOLINT(misc-non-private-member-variables-in-classes)
+    PerfCountSet<uint64_t> counters; // NOLINT(misc-non-private-member-variables-in-classes)
+};
+ANKERL_NANOBENCH(IGNORE_PADDED_POP)
+
+// The trace file a benchmark's timeline goes to: its own, or else the one NANOBENCH_TRACE names. Empty
+// for none.
+std::string tracePath(Config const& config);
+
+// Where the timeline starts: the first time this was asked, which is before the first traced
+// benchmark of the process. Every timestamp in a trace is relative to it.
+Clock::time_point traceOrigin();
+
+// The checkpoint file a result goes to: its own, or else the one NANOBENCH_CHECKPOINT names. Empty for
+// none.
+std::string checkpointPath(Config const& config);
+
+// What a result is found under in a checkpoint file, see Bench::checkpoint(): its baselineKey() and a
+// hash of the settings that decide how it is measured. Only settings the binary result format keeps
+// are in it, so a result read back from the file has the same key it was saved under.
+std::string checkpointKey(Config const& config);
+
+// A result with the epochs of `stored` and the given config, which is what a benchmark restored from a
+// checkpoint is: the file has the epochs, but not how they are to be shown.
+Result withEpochsOf(Config const& config, Result const& stored);
+
+// One benchmark's timeline as Chrome trace events, each starting with the comma that separates it from
+// the one before: the benchmark from begin to end, each span with the gap before it, and a counter
+// event per epoch for the time per iteration. Only the counters in `has` are written.
+void writeTraceEvents(std::ostream& os, Result const& result, Clock::time_point begin, Clock::time_point end,
+                      std::vector<TraceSpan> const& spans, PerfCountSet<bool> const& has);
+
+// Compares two unpaired samples of times, see Bench::baseline(). Values that are not positive have no
+// logarithm and are left out.
+BaselineComparison compareToBaseline(std::string name, std::vector<double> const& baseline, std::vector<double> const& current,
+                                     double tolerance);
+
 // Branch misses cannot exceed the branches they were taken from, and the loop is assumed to mispredict
 // its own exit once - so at least one miss is always attributed to it.
 double correctBranchMisses(uint64_t rawBranchMisses, double correctedBranchInstructions) noexcept;
@@ -1666,6 +3168,61 @@ private:
 std::ostream& operator<<(std::ostream& os, BigO const& bigO);
 std::ostream& operator<<(std::ostream& os, std::vector<ankerl::nanobench::BigO> const& bigOs);
 
+/// Same as Bench::complexityBigO(), for results that did not all come from one bench - e.g. the
+/// shards of a sweep, read back with loadResults().
+std::vector<BigO> complexityBigO(std::vector<Result> const& results);
+
+/**
+ * @brief A report of results and comparisons as a single HTML file that needs nothing but a browser.
+ *
+ * templates::htmlBoxplot() loads plotly from a CDN, so it is a blank page wherever there is no
+ * internet, and it only shows the time. This draws every chart as inline SVG instead, with no script
+ * at all:
+ *
+ * * For the results of each title, a box plot of the time per unit, and the time of every epoch in
+ *   the order they were measured - which is where a drift or a warmup that was too short shows up.
+ *   Outlier epochs are drawn hollow.
+ * * When results have a complexityN, the median against it on log-log axes, with the best fit of
+ *   complexityBigO() through it.
+ * * For a comparison, the ratio of each alternative to the baseline with its interval, colored when
+ *   the interval resolves a difference.
+ *
+ * Each section is drawn as it is added, so the report keeps no results. A point is a few bytes of
+ * SVG path, which keeps even thousands of results small enough to attach to every CI run. Hovering
+ * over a box or an interval shows its numbers.
+ *
+ * @code
+ * ankerl::nanobench::HtmlReport report("nightly");
+ * report.add(bench).add("hash maps", bench.compare(...));
+ * report.write("nightly.html");
+ * @endcode
+ */
+ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
+class HtmlReport {
+public:
+    explicit HtmlReport(std::string title = "nanobench");
+
+    /// Adds a section for each title in @p results, in the order the titles first appear.
+    HtmlReport& add(std::vector<Result> const& results);
+
+    /// Same as add(bench.results()).
+    HtmlReport& add(Bench const& bench);
+
+    /// Adds the intervals of @p compareResult under @p heading.
+    HtmlReport& add(std::string const& heading, CompareResult const& compareResult);
+
+    /// Writes the whole document.
+    void write(std::ostream& out) const;
+
+    /// Writes the whole document to @p path. False when it could not be written.
+    bool write(std::string const& path) const;
+
+private:
+    std::string mTitle;
+    std::string mSections{};
+};
+ANKERL_NANOBENCH(IGNORE_PADDED_POP)
+
 } // namespace nanobench
 } // namespace ankerl
 
@@ -1761,6 +3318,13 @@ public:
         return run(std::forward<Op>(op));
     }
 
+    // Bench::compare(), with the setup before every epoch of every alternative that has no
+    // withSetup() of its own.
+    template <typename... Args>
+    CompareResult compare(Args&&... args) {
+        return mBench.compareWithSetup(mSetupOp, std::forward<Args>(args)...);
+    }
+
 private:
     SetupOp mSetupOp;
     Bench& mBench;
@@ -1793,9 +3357,10 @@ Bench& Bench::runImpl(SetupOp& setupOp, Op&& op) {
         Clock::time_point const after = Clock::now();
         pc.endMeasure();
         pc.updateResults(iterationLogic.numIters());
-        iterationLogic.add(after - before, pc);
+        iterationLogic.add(before, after, pc);
     }
-    iterationLogic.moveResultTo(mResults);
+    iterationLogic.writeResultFiles();
+    iterationLogic.moveResultTo(*this);
     return *this;
 }
 
@@ -1812,6 +3377,41 @@ CompareResult Bench::compare(Args&&... args) {
     return compareImpl(names, ops);
 }
 
+template <typename SetupOp, typename... Args>
+CompareResult Bench::compareWithSetup(SetupOp& setupOp, Args&&... args) {
+    static_assert(sizeof...(args) % 2 == 0, "compare() takes `name, op` pairs");
+    static_assert(sizeof...(args) >= 4, "compare() needs at least two alternatives to compare");
+
+    std::vector<std::string> names;
+    std::vector<detail::ErasedOp> ops;
+    names.reserve(sizeof...(args) / 2);
+    ops.reserve(sizeof...(args) / 2);
+    compareCollect(names, ops, std::forward<Args>(args)...);
+    for (auto& op : ops) {
+        if (nullptr == op.setUp) {
+            op.setUp = &detail::runErasedSetup<SetupOp>;
+            op.setupOp = &setupOp;
+        }
+    }
+    return compareImpl(names, ops);
+}
+
+template <typename... Args>
+CompareSweep Bench::compareSweep(std::vector<size_t> const& sizes, Args&&... args) {
+    static_assert(sizeof...(args) % 2 == 0, "compareSweep() takes `name, op` pairs after the sizes");
+    static_assert(sizeof...(args) >= 4, "compareSweep() needs at least two alternatives to compare");
+
+    size_t n = 0;
+    std::vector<std::string> names;
+    std::vector<detail::SizedOp> sized;
+    std::vector<detail::ErasedOp> ops;
+    names.reserve(sizeof...(args) / 2);
+    sized.reserve(sizeof...(args) / 2);
+    ops.reserve(sizeof...(args) / 2);
+    compareSweepCollect(names, sized, ops, n, std::forward<Args>(args)...);
+    return compareSweepImpl(sizes, names, ops, n);
+}
+
 template <typename SetupOp>
 detail::SetupRunner<SetupOp> Bench::setup(SetupOp setupOp) {
     return detail::SetupRunner<SetupOp>(std::move(setupOp), *this);
@@ -1852,14 +3452,14 @@ BigO Bench::complexityBigO(std::string const& benchmarkName, Op op) const {
 // Any argument is cast to double.
 template <typename T>
 Bench& Bench::batch(T b) noexcept {
-    mConfig.mBatch = static_cast<double>(b);
+    mutableConfig().mBatch = static_cast<double>(b);
     return *this;
 }
 
 // Sets the computation complexity of the next run. Any argument is cast to double.
 template <typename T>
 Bench& Bench::complexityN(T n) noexcept {
-    mConfig.mComplexityN = static_cast<double>(n);
+    mutableConfig().mComplexityN = static_cast<double>(n);
     return *this;
 }
 
@@ -1903,7 +3503,9 @@ void doNotOptimizeAway(T const& val) {
 #    include <fstream>   // ifstream to parse proc files
 #    include <iomanip>   // setw, setprecision
 #    include <iostream>  // cout
+#    include <iterator>  // back_inserter
 #    include <limits>    // numeric_limits, to parse NANOBENCH_CONFIG without overflowing
+#    include <locale>    // classic, baseline files read the same whatever the global locale
 #    include <numeric>   // accumulate
 #    include <random>    // random_device
 #    include <sstream>   // to_s in Number
@@ -1911,6 +3513,15 @@ void doNotOptimizeAway(T const& val) {
 #    if defined(__linux__)
 #        include <unistd.h> //sysconf
 #    endif
+#    if ANKERL_NANOBENCH(DLOPEN)
+#        include <dlfcn.h> // dlmopen, for compareSharedLibraries
+#    endif
+#    if defined(__unix__) || defined(__APPLE__)
+#        include <fcntl.h>    // open, for ResultFile
+#        include <sys/mman.h> // mmap, for ResultFile
+#        include <sys/stat.h> // fstat, for ResultFile and loadResults
+#        include <unistd.h>   // close, for ResultFile
+#    endif
 #    if ANKERL_NANOBENCH(PERF_COUNTERS)
 #        include <map> // map
 
@@ -1938,6 +3549,10 @@ class Number;
 class MarkDownColumn;
 class MarkDownCode;
 
+// helper replacement for std::to_string of signed/unsigned numbers so we are locale independent. Up
+// here with the forward declarations, the template renderer below needs it for a message.
+std::string to_s(uint64_t n);
+
 } // namespace fmt
 } // namespace detail
 } // namespace nanobench
@@ -1976,8 +3591,21 @@ inline uint64_t u64(double val) noexcept {
 // Calculates clock resolution once, and remembers the result
 inline Clock::duration clockResolution() noexcept;
 
+// The context variables of `config`, sorted by name. An unordered_map's order is not the same from
+// one run to the next, so everything that writes them out goes through this.
+static std::vector<std::pair<std::string, std::string>> sortedContext(Config const& config) {
+    std::vector<std::pair<std::string, std::string>> context(config.mContext.begin(), config.mContext.end());
+    std::sort(context.begin(), context.end());
+    return context;
+}
+
 } // namespace detail
 
+// NaN is where a merged result's measure has no value, see Result::merge().
+static bool isMissing(double x) noexcept {
+    return std::isnan(x);
+}
+
 namespace templates {
 
 char const* csv() noexcept {
@@ -2082,10 +3710,72 @@ char const* json() noexcept {
 })DELIM";
 }
 
-ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
-struct Node {
-    enum class Type { tag, content, section, inverted_section };
-
+char const* googleBenchmark() noexcept {
+    return R"DELIM({
+  "context": {
+    "executable": "nanobench",
+    "library_build_type": "release"
+  },
+  "benchmarks": [
+{{#result}}{{#measurement}}    {
+      "name": "{{name}}{{#context}}/{{variable}}:{{value}}{{/context}}",
+      "run_name": "{{name}}{{#context}}/{{variable}}:{{value}}{{/context}}",
+      "run_type": "iteration",
+      "repetitions": {{epochs}},
+      "threads": 1,
+      "iterations": {{iterations}},
+      "real_time": {{elapsedns}},
+      "cpu_time": {{elapsedns}},
+      "time_unit": "ns",
+      "title": "{{title}}",
+      "unit": "{{unit}}",
+      "batch": {{batch}},
+      "complexityN": {{complexityN}},
+      "pagefaults": {{pagefaults}},
+      "cpucycles": {{cpucycles}},
+      "contextswitches": {{contextswitches}},
+      "instructions": {{instructions}},
+      "branchinstructions": {{branchinstructions}},
+      "branchmisses": {{branchmisses}}
+    },
+{{/measurement}}    {
+      "name": "{{name}}{{#context}}/{{variable}}:{{value}}{{/context}}_median",
+      "run_name": "{{name}}{{#context}}/{{variable}}:{{value}}{{/context}}",
+      "run_type": "aggregate",
+      "repetitions": {{epochs}},
+      "threads": 1,
+      "aggregate_name": "median",
+      "aggregate_unit": "time",
+      "iterations": {{epochs}},
+      "real_time": {{median(elapsedns)}},
+      "cpu_time": {{median(elapsedns)}},
+      "time_unit": "ns",
+      "title": "{{title}}",
+      "unit": "{{unit}}"
+    },
+    {
+      "name": "{{name}}{{#context}}/{{variable}}:{{value}}{{/context}}_mean",
+      "run_name": "{{name}}{{#context}}/{{variable}}:{{value}}{{/context}}",
+      "run_type": "aggregate",
+      "repetitions": {{epochs}},
+      "threads": 1,
+      "aggregate_name": "mean",
+      "aggregate_unit": "time",
+      "iterations": {{epochs}},
+      "real_time": {{average(elapsedns)}},
+      "cpu_time": {{average(elapsedns)}},
+      "time_unit": "ns",
+      "title": "{{title}}",
+      "unit": "{{unit}}"
+    }{{^-last}},{{/-last}}
+{{/result}}  ]
+})DELIM";
+}
+
+ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
+struct Node {
+    enum class Type { tag, content, section, inverted_section };
+
     char const* begin;
     char const* end;
     std::vector<Node> children;
@@ -2100,17 +3790,14 @@ struct Node {
 };
 ANKERL_NANOBENCH(IGNORE_PADDED_POP)
 
-// A node points into the template rather than owning its text, and these two are the only places that
-// have to know it: everywhere else asks for the text or writes it out. Free functions rather than
-// members, so Node stays the plain aggregate that parseMustacheTemplate() brace-initializes.
+// A node points into the template rather than owning its text, and this is the only place that has
+// to know it: compiling copies out what it keeps, so a Template does not depend on the string it was
+// made from. A free function rather than a member, so Node stays the plain aggregate that
+// parseMustacheTemplate() brace-initializes.
 static std::string text(Node const& n) {
     return {n.begin, n.end};
 }
 
-static void writeTo(Node const& n, std::ostream& out) {
-    out.write(n.begin, std::distance(n.begin, n.end));
-}
-
 // NOLINTNEXTLINE(misc-no-recursion)
 static std::vector<Node> parseMustacheTemplate(char const** tpl) {
     std::vector<Node> nodes;
@@ -2159,31 +3846,105 @@ static std::vector<Node> parseMustacheTemplate(char const** tpl) {
     }
 }
 
-static bool generateFirstLast(Node const& n, size_t idx, size_t size, std::ostream& out) {
-    ANKERL_NANOBENCH_LOG("n.type=" << static_cast<int>(n.type));
-    bool const matchFirst = n == "-first";
-    bool const matchLast = n == "-last";
-    if (!matchFirst && !matchLast) {
-        return false;
-    }
+// A parsed template, compiled. Parsing only finds where the tags are; compiling also decides what
+// each one means, once: which config value or command a tag names, which measure it is applied to,
+// and what a section is allowed to contain. Rendering then walks these and never looks at a name
+// again.
+//
+// A mistake in the template is compiled into an error op rather than reported right away, so that it
+// is still reported when rendering reaches it and not before - a {{#result}} that is empty because
+// there are no results never complained about what was inside it, and still does not.
+ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
+struct Op {
+    enum class Kind {
+        content,
+        tag,
+        error,
+        first,
+        notFirst,
+        last,
+        notLast,
+        result,
+        measurement,
+        onlyMeasurement,
+        filtered,
+        context,
+        entry,
+        bigO
+    };
 
-    bool doWrite = false;
-    if (n.type == Node::Type::section) {
-        doWrite = (matchFirst && idx == 0) || (matchLast && idx == size - 1);
-    } else if (n.type == Node::Type::inverted_section) {
-        doWrite = (matchFirst && idx != 0) || (matchLast && idx != size - 1);
-    }
+    // what a tag writes. The config values come first, they are the only tags that need no result. The
+    // comparison's and the complexity fits' own come last, they need no result either.
+    enum class Tag {
+        title,
+        name,
+        unit,
+        batch,
+        complexityN,
+        epochs,
+        clockResolution,
+        clockResolutionMultiple,
+        maxEpochTime,
+        minEpochTime,
+        minEpochIterations,
+        epochIterations,
+        warmup,
+        relative,
+        outliers,
+        context,
+        median,
+        average,
+        medianAbsolutePercentError,
+        sum,
+        minimum,
+        maximum,
+        sumProduct,
+        zero,
+        notUnderstood,
+        measure,
+        outlier,
+        variable,
+        value,
+        rounds,
+        comparisons,
+        confidence,
+        looks,
+        fastest,
+        equivalenceMargin,
+        entryName,
+        entryRelative,
+        entryRelativeLow,
+        entryRelativeHigh,
+        isSignificant,
+        isDropped,
+        tiedRounds,
+        equivalence,
+        ratio,
+        ratioLow,
+        ratioHigh,
+        bigOName,
+        constant,
+        normalizedRootMeanSquare
+    };
 
-    if (doWrite) {
-        for (auto const& child : n.children) {
-            if (child.type == Node::Type::content) {
-                writeTo(child, out);
-            }
-        }
-    }
-    return true;
-}
+    Kind kind;
+    Tag tag;
+    std::string text;     // the content to write, the tag as written, or the error message
+    std::string variable; // for {{context(variable)}}
+    Result::Measure measure;
+    Result::Measure measure2;
+    double scale;
+    double scale2;
+    std::vector<Op> children;
+};
+ANKERL_NANOBENCH(IGNORE_PADDED_POP)
+
+// where a node is, which decides what it may be
+enum class Scope { top, result, measurement, context, entry, bigO };
 
+static Op makeOp(Op::Kind kind, std::string text) {
+    return Op{kind, Op::Tag::notUnderstood, std::move(text), {}, Result::Measure::_size, Result::Measure::_size, 1.0, 1.0, {}};
+}
 static bool matchCmdArgs(std::string const& str, std::vector<std::string>& matchResult) {
     matchResult.clear();
     auto idxOpen = str.find('(');
@@ -2212,42 +3973,6 @@ static bool matchCmdArgs(std::string const& str, std::vector<std::string>& match
     return true;
 }
 
-// One tag: writes `value` when the node names it, and reports whether it did.
-template <size_t N, typename T>
-// NOLINTNEXTLINE(hicpp-avoid-c-arrays,modernize-avoid-c-arrays,cppcoreguidelines-avoid-c-arrays)
-static bool writeTag(Node const& n, char const (&tagName)[N], T const& value, std::ostream& out) {
-    if (!(n == tagName)) {
-        return false;
-    }
-    out << value;
-    return true;
-}
-
-static bool generateConfigTag(Node const& n, Config const& config, std::ostream& out) {
-    using detail::d;
-
-    // Not part of the chain below: the chain evaluates the arguments of every tag up to the one that
-    // matches, and measuring the clock's resolution the first time is the one that is not free.
-    if (n == "clockResolution") {
-        out << d(detail::clockResolution());
-        return true;
-    }
-
-    // '||' short-circuits, so at most one of these writes anything and nothing past the match is even
-    // evaluated. Written out as fourteen copies of writeTag()'s body, this was a four-line stanza per
-    // tag whose only compiler-visible mistake - forgetting the `return true` - fell through to
-    // "command not understood" at runtime.
-    return writeTag(n, "title", config.mBenchmarkTitle, out) || writeTag(n, "name", config.mBenchmarkName, out) ||
-           writeTag(n, "unit", config.mUnit, out) || writeTag(n, "batch", config.mBatch, out) ||
-           writeTag(n, "complexityN", config.mComplexityN, out) || writeTag(n, "epochs", config.mNumEpochs, out) ||
-           writeTag(n, "clockResolutionMultiple", config.mClockResolutionMultiple, out) ||
-           writeTag(n, "maxEpochTime", d(config.mMaxEpochTime), out) || writeTag(n, "minEpochTime", d(config.mMinEpochTime), out) ||
-           writeTag(n, "minEpochIterations", config.mMinEpochIterations, out) ||
-           writeTag(n, "epochIterations", config.mEpochIterations, out) || writeTag(n, "warmup", config.mWarmup, out) ||
-           writeTag(n, "relative", config.mIsRelative, out);
-}
-
-// NOLINTNEXTLINE(readability-function-cognitive-complexity)
 // `elapsed` is seconds, which is rarely the unit anyone wants in a report, and the template language
 // has no arithmetic to fix that afterwards (issue #107). So a time measure may carry a unit suffix -
 // `elapsedms`, `elapsedus`, `elapsedns` - and this resolves it to the measure plus the factor to
@@ -2275,141 +4000,768 @@ static Result::Measure measureFromString(std::string const& str, double& scale)
     return Result::Measure::_size;
 }
 
-// The one-argument measure commands - {{median(elapsed)}} and friends. Split out of
-// generateResultTag so that adding the unit-scaled measures did not push its cognitive complexity
-// past what clang-tidy accepts.
-static bool generateMeasureTag(std::string const& command, Result const& r, Result::Measure m, double scale, std::ostream& out) {
+// One config tag: sets `tag` when the node names it, and reports whether it did.
+template <size_t N>
+// NOLINTNEXTLINE(hicpp-avoid-c-arrays,modernize-avoid-c-arrays,cppcoreguidelines-avoid-c-arrays)
+static bool configTag(Node const& n, char const (&tagName)[N], Op::Tag value, Op::Tag& tag) {
+    if (!(n == tagName)) {
+        return false;
+    }
+    tag = value;
+    return true;
+}
+
+// '||' short-circuits, so at most one of these sets anything. Written out as fourteen stanzas, the
+// only compiler-visible mistake - forgetting the `return true` - fell through to "command not
+// understood" at render time.
+static bool configTagOf(Node const& n, Op::Tag& tag) {
+    return configTag(n, "title", Op::Tag::title, tag) || configTag(n, "name", Op::Tag::name, tag) ||
+           configTag(n, "unit", Op::Tag::unit, tag) || configTag(n, "batch", Op::Tag::batch, tag) ||
+           configTag(n, "complexityN", Op::Tag::complexityN, tag) || configTag(n, "epochs", Op::Tag::epochs, tag) ||
+           configTag(n, "clockResolution", Op::Tag::clockResolution, tag) ||
+           configTag(n, "clockResolutionMultiple", Op::Tag::clockResolutionMultiple, tag) ||
+           configTag(n, "maxEpochTime", Op::Tag::maxEpochTime, tag) || configTag(n, "minEpochTime", Op::Tag::minEpochTime, tag) ||
+           configTag(n, "minEpochIterations", Op::Tag::minEpochIterations, tag) ||
+           configTag(n, "epochIterations", Op::Tag::epochIterations, tag) || configTag(n, "warmup", Op::Tag::warmup, tag) ||
+           configTag(n, "relative", Op::Tag::relative, tag);
+}
+
+// The one-argument measure commands - {{median(elapsed)}} and friends.
+static Op::Tag measureCommandOf(std::string const& command) {
     if (command == "median") {
-        out << r.median(m) * scale;
-        return true;
+        return Op::Tag::median;
     }
     if (command == "average") {
-        out << r.average(m) * scale;
-        return true;
+        return Op::Tag::average;
     }
     if (command == "medianAbsolutePercentError") {
-        // a relative error is the same number whatever the unit, so this one is not scaled
-        out << r.medianAbsolutePercentError(m);
-        return true;
+        return Op::Tag::medianAbsolutePercentError;
     }
     if (command == "sum") {
-        out << r.sum(m) * scale;
-        return true;
+        return Op::Tag::sum;
     }
     if (command == "minimum") {
-        out << r.minimum(m) * scale;
-        return true;
+        return Op::Tag::minimum;
     }
     if (command == "maximum") {
-        out << r.maximum(m) * scale;
-        return true;
+        return Op::Tag::maximum;
     }
-    return false;
+    return Op::Tag::notUnderstood;
 }
 
-static std::ostream& generateResultTag(Node const& n, Result const& r, std::ostream& out) {
-    if (generateConfigTag(n, r.config(), out)) {
-        return out;
+// A tag where there is a result: a config value, {{outliers}}, or a command. A command on a name that
+// is not a measure writes 0, whatever the command - that is what it has always done.
+static Op compileResultTag(Node const& n) {
+    auto op = makeOp(Op::Kind::tag, text(n));
+    if (configTagOf(n, op.tag)) {
+        return op;
+    }
+    if (n == "outliers") {
+        op.tag = Op::Tag::outliers;
+        return op;
     }
-    // match e.g. "median(elapsed)"
+
+    // match e.g. "median(elapsed)" or "sumProduct(iterations, elapsed)"
     // g++ 4.8 doesn't implement std::regex :(
-    // static std::regex const regOpArg1("^([a-zA-Z]+)\\(([a-zA-Z]*)\\)$");
-    // std::cmatch matchResult;
-    // if (std::regex_match(n.begin, n.end, matchResult, regOpArg1)) {
     std::vector<std::string> matchResult;
-    if (matchCmdArgs(text(n), matchResult)) {
-        if (matchResult.size() == 2) {
-            if (matchResult[0] == "context") {
-                return out << r.context(matchResult[1]);
-            }
+    if (!matchCmdArgs(op.text, matchResult)) {
+        return op;
+    }
+    if (matchResult.size() == 2) {
+        if (matchResult[0] == "context") {
+            op.tag = Op::Tag::context;
+            op.variable = matchResult[1];
+            return op;
+        }
+        op.measure = measureFromString(matchResult[1], op.scale);
+        op.tag = op.measure == Result::Measure::_size ? Op::Tag::zero : measureCommandOf(matchResult[0]);
+    } else if (matchResult.size() == 3) {
+        op.measure = measureFromString(matchResult[1], op.scale);
+        op.measure2 = measureFromString(matchResult[2], op.scale2);
+        if (op.measure == Result::Measure::_size || op.measure2 == Result::Measure::_size) {
+            op.tag = Op::Tag::zero;
+        } else if (matchResult[0] == "sumProduct") {
+            op.tag = Op::Tag::sumProduct;
+        }
+    }
+    return op;
+}
+
+// A tag inside {{#measurement}}: a measure of that one epoch, {{outlier}}, or one of the result's
+// config values and context variables - a format with a record per epoch repeats those in each.
+// Anything else is 0.
+static Op compileMeasurementTag(Node const& n) {
+    auto op = makeOp(Op::Kind::tag, text(n));
+    op.tag = Op::Tag::zero;
+    if (n == "outlier") {
+        op.tag = Op::Tag::outlier;
+        return op;
+    }
+    op.measure = measureFromString(op.text, op.scale);
+    if (op.measure != Result::Measure::_size) {
+        op.tag = Op::Tag::measure;
+        return op;
+    }
+    auto resultOp = compileResultTag(n);
+    if (Op::Tag::context == resultOp.tag || configTagOf(n, resultOp.tag)) {
+        return resultOp;
+    }
+    return op;
+}
+
+// A tag inside {{#context}}: the variable's name or value, or whatever the result around it has.
+static Op compileContextTag(Node const& n) {
+    if (n == "variable" || n == "value") {
+        auto op = makeOp(Op::Kind::tag, text(n));
+        op.tag = n == "variable" ? Op::Tag::variable : Op::Tag::value;
+        return op;
+    }
+    return compileResultTag(n);
+}
+
+// The comparison's own tags, which mean the same at the top and in every {{#entry}}.
+static bool compareTagOf(Node const& n, Op::Tag& tag) {
+    return configTag(n, "rounds", Op::Tag::rounds, tag) || configTag(n, "comparisons", Op::Tag::comparisons, tag) ||
+           configTag(n, "confidence", Op::Tag::confidence, tag) || configTag(n, "looks", Op::Tag::looks, tag) ||
+           configTag(n, "fastest", Op::Tag::fastest, tag) || configTag(n, "equivalenceMargin", Op::Tag::equivalenceMargin, tag);
+}
+
+// A tag at the top: one of the comparison's, or the config value it has always been.
+static Op compileTopTag(Node const& n) {
+    auto op = makeOp(Op::Kind::tag, text(n));
+    if (compareTagOf(n, op.tag)) {
+        return op;
+    }
+    return compileResultTag(n);
+}
+
+// A tag inside {{#entry}}: how this alternative compares to the baseline, one of the comparison's
+// tags, or whatever its result has. {{name}} and {{relative}} are the entry's, not the config's - the
+// alternative's name, and its ratio to the baseline. {{relative(<name>)}} and its interval are the
+// ratio of any other measure; they are parsed as the result's commands are, so a name that is not a
+// measure writes 0 here too.
+static Op compileEntryTag(Node const& n) {
+    auto op = makeOp(Op::Kind::tag, text(n));
+    if (configTag(n, "name", Op::Tag::entryName, op.tag) || configTag(n, "relative", Op::Tag::entryRelative, op.tag) ||
+        configTag(n, "relativeLow", Op::Tag::entryRelativeLow, op.tag) ||
+        configTag(n, "relativeHigh", Op::Tag::entryRelativeHigh, op.tag) ||
+        configTag(n, "isSignificant", Op::Tag::isSignificant, op.tag) || configTag(n, "isDropped", Op::Tag::isDropped, op.tag) ||
+        configTag(n, "tiedRounds", Op::Tag::tiedRounds, op.tag) || configTag(n, "equivalence", Op::Tag::equivalence, op.tag) ||
+        compareTagOf(n, op.tag)) {
+        return op;
+    }
+
+    op = compileResultTag(n);
+    if (Op::Tag::notUnderstood == op.tag && Result::Measure::_size != op.measure && Result::Measure::_size == op.measure2) {
+        auto const command = op.text.substr(0, op.text.find('('));
+        if (command == "relative") {
+            op.tag = Op::Tag::ratio;
+        } else if (command == "relativeLow") {
+            op.tag = Op::Tag::ratioLow;
+        } else if (command == "relativeHigh") {
+            op.tag = Op::Tag::ratioHigh;
+        }
+    }
+    return op;
+}
 
-            double scale = 1.0;
-            auto m = measureFromString(matchResult[1], scale);
-            if (m == Result::Measure::_size) {
-                return out << 0.0;
-            }
-            if (generateMeasureTag(matchResult[0], r, m, scale, out)) {
-                return out;
-            }
-        } else if (matchResult.size() == 3) {
-            double scale1 = 1.0;
-            double scale2 = 1.0;
-            auto m1 = measureFromString(matchResult[1], scale1);
-            auto m2 = measureFromString(matchResult[2], scale2);
-            if (m1 == Result::Measure::_size || m2 == Result::Measure::_size) {
-                return out << 0.0;
-            }
+// A tag inside {{#bigO}}: the fit's name, its constant, or its error. There is nothing else to write.
+static Op compileBigOTag(Node const& n) {
+    auto op = makeOp(Op::Kind::tag, text(n));
+    if (!configTag(n, "name", Op::Tag::bigOName, op.tag) && !configTag(n, "constant", Op::Tag::constant, op.tag)) {
+        configTag(n, "normalizedRootMeanSquare", Op::Tag::normalizedRootMeanSquare, op.tag);
+    }
+    return op;
+}
 
-            if (matchResult[0] == "sumProduct") {
-                return out << r.sumProduct(m1, m2) * scale1 * scale2;
-            }
+// {{#-first}}, {{^-last}} and the like only ever write their text, so that is all they keep. Inside a
+// layer a node with one of these names is never anything else, whatever its type.
+static bool compileFirstLast(Node const& n, std::vector<Op>& ops) {
+    bool const matchFirst = n == "-first";
+    bool const matchLast = n == "-last";
+    if (!matchFirst && !matchLast) {
+        return false;
+    }
+    if (n.type != Node::Type::section && n.type != Node::Type::inverted_section) {
+        return true;
+    }
+
+    auto const inverted = n.type == Node::Type::inverted_section;
+    auto kind = matchFirst ? (inverted ? Op::Kind::notFirst : Op::Kind::first) : (inverted ? Op::Kind::notLast : Op::Kind::last);
+    std::string content;
+    for (auto const& child : n.children) {
+        if (child.type == Node::Type::content) {
+            content += text(child);
         }
     }
+    ops.emplace_back(makeOp(kind, std::move(content)));
+    return true;
+}
+
+static std::vector<Op> compile(std::vector<Node> const& nodes, Scope scope);
+
+// NOLINTNEXTLINE(misc-no-recursion)
+static Op compileSection(Node const& n, Scope scope) {
+    auto const name = text(n);
+    if (n.type == Node::Type::inverted_section) {
+        switch (scope) {
+        case Scope::top:
+            return makeOp(Op::Kind::error, "unknown list '" + name + "'");
+        case Scope::result:
+            return makeOp(Op::Kind::error, "got a inverted section inside result");
+        case Scope::context:
+            return makeOp(Op::Kind::error, "got a inverted section inside context");
+        case Scope::entry:
+            return makeOp(Op::Kind::error, "got a inverted section inside entry");
+        case Scope::bigO:
+            return makeOp(Op::Kind::error, "got a inverted section inside bigO");
+        case Scope::measurement:
+            break;
+        }
+        return makeOp(Op::Kind::error, "got a inverted section inside measurement");
+    }
+
+    // the context variables are a list of their own wherever there is a result
+    if (n == "context" && (Scope::result == scope || Scope::measurement == scope || Scope::entry == scope)) {
+        auto op = makeOp(Op::Kind::context, name);
+        op.children = compile(n.children, Scope::context);
+        return op;
+    }
+
+    Op op = makeOp(Op::Kind::error, "got a section inside measurement");
+    switch (scope) {
+    case Scope::top:
+        if (n == "result") {
+            op = makeOp(Op::Kind::result, name);
+            op.children = compile(n.children, Scope::result);
+        } else if (n == "measurement") {
+            op = makeOp(Op::Kind::onlyMeasurement, name);
+            op.children = compile(n.children, Scope::measurement);
+        } else if (n == "entry") {
+            op = makeOp(Op::Kind::entry, name);
+            op.children = compile(n.children, Scope::entry);
+        } else if (n == "bigO") {
+            op = makeOp(Op::Kind::bigO, name);
+            op.children = compile(n.children, Scope::bigO);
+        } else {
+            op.text = "render: unknown section '" + name + "'";
+        }
+        break;
+
+    case Scope::result:
+    case Scope::entry:
+        // an entry is a result with a ratio, so it has the same layers - and keeps its own tags in them
+        if (n == "measurement") {
+            op = makeOp(Op::Kind::measurement, name);
+            op.children = compile(n.children, Scope::measurement);
+        } else if (n == "filtered") {
+            op = makeOp(Op::Kind::filtered, name);
+            op.children = compile(n.children, scope);
+        } else {
+            op.text = Scope::entry == scope ? "got a section inside entry" : "got a section inside result";
+        }
+        break;
+
+    case Scope::context:
+        op.text = "got a section inside context";
+        break;
 
-    // match e.g. "sumProduct(elapsed, iterations)"
-    // static std::regex const regOpArg2("^([a-zA-Z]+)\\(([a-zA-Z]*)\\s*,\\s+([a-zA-Z]*)\\)$");
+    case Scope::bigO:
+        op.text = "got a section inside bigO";
+        break;
 
-    // nothing matches :(
-    ANKERL_NANOBENCH_THROW(std::runtime_error("command '" + text(n) + "' not understood"));
+    case Scope::measurement:
+        break;
+    }
+    return op;
 }
 
-static void generateResultMeasurement(std::vector<Node> const& nodes, size_t idx, Result const& r, std::ostream& out) {
+// NOLINTNEXTLINE(misc-no-recursion)
+static std::vector<Op> compile(std::vector<Node> const& nodes, Scope scope) {
+    std::vector<Op> ops;
     for (auto const& n : nodes) {
-        if (!generateFirstLast(n, idx, r.size(), out)) {
-            ANKERL_NANOBENCH_LOG("n.type=" << static_cast<int>(n.type));
-            switch (n.type) {
-            case Node::Type::content:
-                writeTo(n, out);
-                break;
-
-            case Node::Type::inverted_section:
-                ANKERL_NANOBENCH_THROW(std::runtime_error("got a inverted section inside measurement"));
+        if (scope != Scope::top && compileFirstLast(n, ops)) {
+            continue;
+        }
+        switch (n.type) {
+        case Node::Type::content:
+            ops.emplace_back(makeOp(Op::Kind::content, text(n)));
+            break;
 
-            case Node::Type::section:
-                ANKERL_NANOBENCH_THROW(std::runtime_error("got a section inside measurement"));
+        case Node::Type::section:
+        case Node::Type::inverted_section:
+            ops.emplace_back(compileSection(n, scope));
+            break;
 
-            case Node::Type::tag: {
-                double scale = 1.0;
-                auto m = measureFromString(text(n), scale);
-                if (m == Result::Measure::_size || !r.has(m)) {
-                    out << 0.0;
-                } else {
-                    out << r.get(idx, m) * scale;
-                }
+        case Node::Type::tag:
+            switch (scope) {
+            case Scope::measurement:
+                ops.emplace_back(compileMeasurementTag(n));
+                break;
+            case Scope::context:
+                ops.emplace_back(compileContextTag(n));
+                break;
+            case Scope::entry:
+                ops.emplace_back(compileEntryTag(n));
+                break;
+            case Scope::bigO:
+                ops.emplace_back(compileBigOTag(n));
+                break;
+            case Scope::top:
+                ops.emplace_back(compileTopTag(n));
+                break;
+            case Scope::result:
+                ops.emplace_back(compileResultTag(n));
                 break;
             }
-            }
+            break;
         }
     }
+    return ops;
 }
 
-static void generateResult(std::vector<Node> const& nodes, size_t idx, std::vector<Result> const& results, std::ostream& out) {
-    auto const& r = results[idx];
-    for (auto const& n : nodes) {
-        if (!generateFirstLast(n, idx, results.size(), out)) {
-            ANKERL_NANOBENCH_LOG("n.type=" << static_cast<int>(n.type));
-            switch (n.type) {
-            case Node::Type::content:
-                writeTo(n, out);
-                break;
+// Where rendering is: the result a tag is about, and the position in the layer for {{#-first}} and
+// {{#-last}} - in {{#measurement}} that is the epoch, the one its measures are read from, in
+// {{#context}} the variable, in {{#entry}} the alternative and in {{#bigO}} the fit.
+ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
+struct Frame {
+    std::vector<Result> const* results;
+    Result const* result; // nullptr at the top level, unless there is exactly one result
+    std::vector<bool> const* outliers;
+    size_t idx;
+    size_t size;
+    std::pair<std::string, std::string> const* variable; // only in {{#context}}
+    CompareResult const* compare;                        // only when rendering a comparison
+    std::vector<BigO> const* bigOs;                      // only when rendering complexity fits
+};
+ANKERL_NANOBENCH(IGNORE_PADDED_POP)
 
-            case Node::Type::inverted_section:
-                ANKERL_NANOBENCH_THROW(std::runtime_error("got a inverted section inside result"));
+static bool writeConfigValue(Op::Tag tag, Config const& config, std::ostream& out) {
+    using detail::d;
 
-            case Node::Type::section:
-                if (n == "measurement") {
-                    for (size_t i = 0; i < r.size(); ++i) {
-                        generateResultMeasurement(n.children, i, r, out);
-                    }
-                } else {
-                    ANKERL_NANOBENCH_THROW(std::runtime_error("got a section inside result"));
-                }
-                break;
+    switch (tag) {
+    case Op::Tag::title:
+        out << config.mBenchmarkTitle;
+        return true;
+    case Op::Tag::name:
+        out << config.mBenchmarkName;
+        return true;
+    case Op::Tag::unit:
+        out << config.mUnit;
+        return true;
+    case Op::Tag::batch:
+        out << config.mBatch;
+        return true;
+    case Op::Tag::complexityN:
+        out << config.mComplexityN;
+        return true;
+    case Op::Tag::epochs:
+        out << config.mNumEpochs;
+        return true;
+    case Op::Tag::clockResolution:
+        out << d(detail::clockResolution());
+        return true;
+    case Op::Tag::clockResolutionMultiple:
+        out << config.mClockResolutionMultiple;
+        return true;
+    case Op::Tag::maxEpochTime:
+        out << d(config.mMaxEpochTime);
+        return true;
+    case Op::Tag::minEpochTime:
+        out << d(config.mMinEpochTime);
+        return true;
+    case Op::Tag::minEpochIterations:
+        out << config.mMinEpochIterations;
+        return true;
+    case Op::Tag::epochIterations:
+        out << config.mEpochIterations;
+        return true;
+    case Op::Tag::warmup:
+        out << config.mWarmup;
+        return true;
+    case Op::Tag::relative:
+        out << config.mIsRelative;
+        return true;
 
-            case Node::Type::tag:
-                generateResultTag(n, r, out);
-                break;
+    case Op::Tag::outliers:
+    case Op::Tag::context:
+    case Op::Tag::median:
+    case Op::Tag::average:
+    case Op::Tag::medianAbsolutePercentError:
+    case Op::Tag::sum:
+    case Op::Tag::minimum:
+    case Op::Tag::maximum:
+    case Op::Tag::sumProduct:
+    case Op::Tag::zero:
+    case Op::Tag::notUnderstood:
+    case Op::Tag::measure:
+    case Op::Tag::outlier:
+    case Op::Tag::variable:
+    case Op::Tag::value:
+    case Op::Tag::rounds:
+    case Op::Tag::comparisons:
+    case Op::Tag::confidence:
+    case Op::Tag::looks:
+    case Op::Tag::fastest:
+    case Op::Tag::equivalenceMargin:
+    case Op::Tag::entryName:
+    case Op::Tag::entryRelative:
+    case Op::Tag::entryRelativeLow:
+    case Op::Tag::entryRelativeHigh:
+    case Op::Tag::isSignificant:
+    case Op::Tag::isDropped:
+    case Op::Tag::tiedRounds:
+    case Op::Tag::equivalence:
+    case Op::Tag::ratio:
+    case Op::Tag::ratioLow:
+    case Op::Tag::ratioHigh:
+    case Op::Tag::bigOName:
+    case Op::Tag::constant:
+    case Op::Tag::normalizedRootMeanSquare:
+        break;
+    }
+    return false;
+}
+
+// The comparison's tags need a comparison, which only render() with a CompareResult has. Without one
+// they are as unknown as any other name.
+static CompareResult const& compareOf(Op const& op, Frame const& frame) {
+    if (frame.compare == nullptr) {
+        ANKERL_NANOBENCH_THROW(std::runtime_error("unknown tag '" + op.text + "'"));
+    }
+    return *frame.compare;
+}
+
+// The comparison's and the complexity fits' tags. They read from the frame instead of from a result,
+// so that the top of a comparison, which has no result, can write them too.
+static bool writeListValue(Op const& op, Frame const& frame, std::ostream& out) {
+    switch (op.tag) {
+    case Op::Tag::rounds:
+        out << compareOf(op, frame).rounds();
+        return true;
+    case Op::Tag::comparisons:
+        out << compareOf(op, frame).comparisons();
+        return true;
+    case Op::Tag::confidence:
+        out << compareOf(op, frame).confidence();
+        return true;
+    case Op::Tag::looks:
+        out << compareOf(op, frame).looks();
+        return true;
+    case Op::Tag::fastest:
+        out << compareOf(op, frame).fastest();
+        return true;
+    case Op::Tag::equivalenceMargin:
+        out << compareOf(op, frame).equivalenceMargin();
+        return true;
+
+    case Op::Tag::entryName:
+        out << compareOf(op, frame)[frame.idx].name;
+        return true;
+    case Op::Tag::entryRelative:
+        out << compareOf(op, frame)[frame.idx].relative;
+        return true;
+    case Op::Tag::entryRelativeLow:
+        out << compareOf(op, frame)[frame.idx].relativeLow;
+        return true;
+    case Op::Tag::entryRelativeHigh:
+        out << compareOf(op, frame)[frame.idx].relativeHigh;
+        return true;
+    case Op::Tag::isSignificant:
+        out << (compareOf(op, frame).isSignificant(frame.idx) ? 1 : 0);
+        return true;
+    case Op::Tag::isDropped:
+        out << (compareOf(op, frame).isDropped(frame.idx) ? 1 : 0);
+        return true;
+    case Op::Tag::tiedRounds:
+        out << compareOf(op, frame)[frame.idx].tiedRounds;
+        return true;
+    case Op::Tag::equivalence: {
+        auto const equivalence = compareOf(op, frame).equivalence(frame.idx);
+        out << (Equivalence::equivalent == equivalence      ? "equivalent"
+                : Equivalence::notEquivalent == equivalence ? "notEquivalent"
+                                                            : "inconclusive");
+        return true;
+    }
+    case Op::Tag::ratio:
+        out << compareOf(op, frame)[frame.idx].ratio(op.measure).relative;
+        return true;
+    case Op::Tag::ratioLow:
+        out << compareOf(op, frame)[frame.idx].ratio(op.measure).relativeLow;
+        return true;
+    case Op::Tag::ratioHigh:
+        out << compareOf(op, frame)[frame.idx].ratio(op.measure).relativeHigh;
+        return true;
+
+    case Op::Tag::bigOName:
+        out << (*frame.bigOs)[frame.idx].name();
+        return true;
+    case Op::Tag::constant:
+        out << (*frame.bigOs)[frame.idx].constant();
+        return true;
+    case Op::Tag::normalizedRootMeanSquare:
+        out << (*frame.bigOs)[frame.idx].normalizedRootMeanSquare();
+        return true;
+
+    case Op::Tag::title:
+    case Op::Tag::name:
+    case Op::Tag::unit:
+    case Op::Tag::batch:
+    case Op::Tag::complexityN:
+    case Op::Tag::epochs:
+    case Op::Tag::clockResolution:
+    case Op::Tag::clockResolutionMultiple:
+    case Op::Tag::maxEpochTime:
+    case Op::Tag::minEpochTime:
+    case Op::Tag::minEpochIterations:
+    case Op::Tag::epochIterations:
+    case Op::Tag::warmup:
+    case Op::Tag::relative:
+    case Op::Tag::outliers:
+    case Op::Tag::context:
+    case Op::Tag::median:
+    case Op::Tag::average:
+    case Op::Tag::medianAbsolutePercentError:
+    case Op::Tag::sum:
+    case Op::Tag::minimum:
+    case Op::Tag::maximum:
+    case Op::Tag::sumProduct:
+    case Op::Tag::zero:
+    case Op::Tag::notUnderstood:
+    case Op::Tag::measure:
+    case Op::Tag::outlier:
+    case Op::Tag::variable:
+    case Op::Tag::value:
+        break;
+    }
+    return false;
+}
+
+static void writeValue(Op const& op, Frame const& frame, std::ostream& out) {
+    if (writeListValue(op, frame, out)) {
+        return;
+    }
+    if (frame.result == nullptr) {
+        // Several results, or none: a tag out here can only be a config value, and this just uses the
+        // last result's config - or for a comparison, the baseline's.
+        Result const* last = nullptr;
+        if (!frame.results->empty()) {
+            last = &frame.results->back();
+        } else if (frame.compare != nullptr && frame.compare->size() != 0) {
+            last = &(*frame.compare)[0].result;
+        }
+        if (last == nullptr || !writeConfigValue(op.tag, last->config(), out)) {
+            ANKERL_NANOBENCH_THROW(std::runtime_error("unknown tag '" + op.text + "'"));
+        }
+        return;
+    }
+
+    auto const& r = *frame.result;
+    switch (op.tag) {
+    case Op::Tag::outliers:
+        out << r.numOutliers();
+        return;
+    case Op::Tag::context:
+        out << r.context(op.variable);
+        return;
+    case Op::Tag::median:
+        out << r.median(op.measure) * op.scale;
+        return;
+    case Op::Tag::average:
+        out << r.average(op.measure) * op.scale;
+        return;
+    case Op::Tag::medianAbsolutePercentError:
+        // a relative error is the same number whatever the unit, so this one is not scaled
+        out << r.medianAbsolutePercentError(op.measure);
+        return;
+    case Op::Tag::sum:
+        out << r.sum(op.measure) * op.scale;
+        return;
+    case Op::Tag::minimum:
+        out << r.minimum(op.measure) * op.scale;
+        return;
+    case Op::Tag::maximum:
+        out << r.maximum(op.measure) * op.scale;
+        return;
+    case Op::Tag::sumProduct:
+        out << r.sumProduct(op.measure, op.measure2) * op.scale * op.scale2;
+        return;
+    case Op::Tag::zero:
+        out << 0.0;
+        return;
+    case Op::Tag::notUnderstood:
+        ANKERL_NANOBENCH_THROW(std::runtime_error("command '" + op.text + "' not understood"));
+    case Op::Tag::measure:
+        if (r.has(op.measure) && isMissing(r.get(frame.idx, op.measure))) {
+            // what JSON has for a value that is not there, where a bare nan would be no JSON at all
+            out << "null";
+        } else if (r.has(op.measure)) {
+            out << r.get(frame.idx, op.measure) * op.scale;
+        } else {
+            out << 0.0;
+        }
+        return;
+    case Op::Tag::outlier:
+        out << ((*frame.outliers)[frame.idx] ? 1 : 0);
+        return;
+    case Op::Tag::variable:
+        out << frame.variable->first;
+        return;
+    case Op::Tag::value:
+        out << frame.variable->second;
+        return;
+    case Op::Tag::rounds:
+    case Op::Tag::comparisons:
+    case Op::Tag::confidence:
+    case Op::Tag::looks:
+    case Op::Tag::fastest:
+    case Op::Tag::equivalenceMargin:
+    case Op::Tag::entryName:
+    case Op::Tag::entryRelative:
+    case Op::Tag::entryRelativeLow:
+    case Op::Tag::entryRelativeHigh:
+    case Op::Tag::isSignificant:
+    case Op::Tag::isDropped:
+    case Op::Tag::tiedRounds:
+    case Op::Tag::equivalence:
+    case Op::Tag::ratio:
+    case Op::Tag::ratioLow:
+    case Op::Tag::ratioHigh:
+    case Op::Tag::bigOName:
+    case Op::Tag::constant:
+    case Op::Tag::normalizedRootMeanSquare:
+        // written by writeListValue() already
+        return;
+
+    case Op::Tag::title:
+    case Op::Tag::name:
+    case Op::Tag::unit:
+    case Op::Tag::batch:
+    case Op::Tag::complexityN:
+    case Op::Tag::epochs:
+    case Op::Tag::clockResolution:
+    case Op::Tag::clockResolutionMultiple:
+    case Op::Tag::maxEpochTime:
+    case Op::Tag::minEpochTime:
+    case Op::Tag::minEpochIterations:
+    case Op::Tag::epochIterations:
+    case Op::Tag::warmup:
+    case Op::Tag::relative:
+        writeConfigValue(op.tag, r.config(), out);
+        return;
+    }
+}
+
+static void run(std::vector<Op> const& ops, Frame const& frame, std::ostream& out);
+
+// NOLINTNEXTLINE(misc-no-recursion)
+static void runMeasurements(std::vector<Op> const& ops, Frame const& frame, std::ostream& out) {
+    auto const& r = *frame.result;
+    // a streaming result has no epochs to list, only its statistics
+    auto const numEpochs = r.streaming() ? 0U : r.size();
+    auto const outliers = r.outlierEpochs();
+    for (size_t i = 0; i < numEpochs; ++i) {
+        run(ops, Frame{frame.results, &r, &outliers, i, r.size(), nullptr, frame.compare, frame.bigOs}, out);
+    }
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+static void run(std::vector<Op> const& ops, Frame const& frame, std::ostream& out) {
+    for (auto const& op : ops) {
+        switch (op.kind) {
+        case Op::Kind::content:
+            out << op.text;
+            break;
+
+        case Op::Kind::tag:
+            writeValue(op, frame, out);
+            break;
+
+        case Op::Kind::error:
+            ANKERL_NANOBENCH_THROW(std::runtime_error(op.text));
+
+        case Op::Kind::first:
+            if (frame.idx == 0) {
+                out << op.text;
+            }
+            break;
+        case Op::Kind::notFirst:
+            if (frame.idx != 0) {
+                out << op.text;
+            }
+            break;
+        case Op::Kind::last:
+            if (frame.idx == frame.size - 1) {
+                out << op.text;
+            }
+            break;
+        case Op::Kind::notLast:
+            if (frame.idx != frame.size - 1) {
+                out << op.text;
             }
+            break;
+
+        case Op::Kind::result: {
+            auto const& results = *frame.results;
+            for (size_t i = 0; i < results.size(); ++i) {
+                run(op.children, Frame{&results, &results[i], nullptr, i, results.size(), nullptr, frame.compare, frame.bigOs}, out);
+            }
+            break;
+        }
+
+        case Op::Kind::onlyMeasurement:
+            // when we only have a single result, we can immediately go into its measurement.
+            if (frame.results->size() != 1) {
+                ANKERL_NANOBENCH_THROW(std::runtime_error(
+                    "render: can only use section 'measurement' here if there is a single result, but there are " +
+                    detail::fmt::to_s(frame.results->size())));
+            }
+            runMeasurements(op.children, frame, out);
+            break;
+
+        case Op::Kind::measurement:
+            runMeasurements(op.children, frame, out);
+            break;
+
+        case Op::Kind::filtered: {
+            // the same body against the result without its outliers, at the same position
+            auto const filtered = frame.result->withoutOutliers();
+            run(op.children, Frame{frame.results, &filtered, frame.outliers, frame.idx, frame.size, nullptr, frame.compare, frame.bigOs},
+                out);
+            break;
+        }
+
+        case Op::Kind::context: {
+            auto const variables = detail::sortedContext(frame.result->config());
+            for (size_t i = 0; i < variables.size(); ++i) {
+                run(op.children,
+                    Frame{frame.results, frame.result, frame.outliers, i, variables.size(), &variables[i], frame.compare, frame.bigOs},
+                    out);
+            }
+            break;
+        }
+
+        case Op::Kind::entry: {
+            if (frame.compare == nullptr) {
+                ANKERL_NANOBENCH_THROW(std::runtime_error("render: section 'entry' needs a CompareResult"));
+            }
+            auto const& compare = *frame.compare;
+            for (size_t i = 0; i < compare.size(); ++i) {
+                run(op.children, Frame{frame.results, &compare[i].result, nullptr, i, compare.size(), nullptr, &compare, nullptr}, out);
+            }
+            break;
+        }
+
+        case Op::Kind::bigO: {
+            if (frame.bigOs == nullptr) {
+                ANKERL_NANOBENCH_THROW(std::runtime_error("render: section 'bigO' needs a list of BigO"));
+            }
+            auto const& bigOs = *frame.bigOs;
+            for (size_t i = 0; i < bigOs.size(); ++i) {
+                run(op.children, Frame{frame.results, nullptr, nullptr, i, bigOs.size(), nullptr, nullptr, &bigOs}, out);
+            }
+            break;
+        }
         }
     }
 }
@@ -2422,6 +4774,7 @@ namespace detail {
 char const* getEnv(char const* name);
 bool isEndlessRunning(std::string const& name);
 bool isWarningsEnabled();
+bool isBaselineUpdateRequested();
 
 // Applies NANOBENCH_CONFIG to a freshly built Bench, printing whatever it could not use. Every Bench
 // re-reads and re-parses the variable; only the complaining is once per process.
@@ -2479,9 +4832,6 @@ private:
     double mValue;
 };
 
-// helper replacement for std::to_string of signed/unsigned numbers so we are locale independent
-std::string to_s(uint64_t n);
-
 std::ostream& operator<<(std::ostream& os, Number const& n);
 
 ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
@@ -2533,70 +4883,72 @@ std::ostream& operator<<(std::ostream& os, MarkDownCode const& mdCode);
 namespace ankerl {
 namespace nanobench {
 
-// NOLINTNEXTLINE(readability-function-cognitive-complexity)
-void render(char const* mustacheTemplate, std::vector<Result> const& results, std::ostream& out) {
+Template::Template(char const* mustacheTemplate)
+    : mOps(std::make_shared<std::vector<templates::Op>>(
+          templates::compile(templates::parseMustacheTemplate(&mustacheTemplate), templates::Scope::top))) {}
+
+Template::Template(std::string const& mustacheTemplate)
+    : Template(mustacheTemplate.c_str()) {}
+
+void render(Template const& tpl, std::vector<Result> const& results, std::ostream& out) {
     detail::fmt::StreamStateRestorer const restorer(out);
 
     out.precision(std::numeric_limits<double>::digits10);
-    auto nodes = templates::parseMustacheTemplate(&mustacheTemplate);
+    templates::run(*tpl.mOps,
+                   templates::Frame{&results, results.size() == 1 ? &results.front() : nullptr, nullptr, 0, 0, nullptr, nullptr, nullptr},
+                   out);
+}
 
-    for (auto const& n : nodes) {
-        ANKERL_NANOBENCH_LOG("n.type=" << static_cast<int>(n.type));
-        switch (n.type) {
-        case templates::Node::Type::content:
-            templates::writeTo(n, out);
-            break;
+void render(Template const& tpl, CompareResult const& compareResult, std::ostream& out) {
+    detail::fmt::StreamStateRestorer const restorer(out);
 
-        case templates::Node::Type::inverted_section:
-            ANKERL_NANOBENCH_THROW(std::runtime_error("unknown list '" + templates::text(n) + "'"));
+    out.precision(std::numeric_limits<double>::digits10);
+    std::vector<Result> const noResults;
+    templates::run(*tpl.mOps, templates::Frame{&noResults, nullptr, nullptr, 0, 0, nullptr, &compareResult, nullptr}, out);
+}
 
-        case templates::Node::Type::section:
-            if (n == "result") {
-                const size_t nbResults = results.size();
-                for (size_t i = 0; i < nbResults; ++i) {
-                    generateResult(n.children, i, results, out);
-                }
-            } else if (n == "measurement") {
-                if (results.size() != 1) {
-                    ANKERL_NANOBENCH_THROW(std::runtime_error(
-                        "render: can only use section 'measurement' here if there is a single result, but there are " +
-                        detail::fmt::to_s(results.size())));
-                }
-                // when we only have a single result, we can immediately go into its measurement.
-                auto const& r = results.front();
-                for (size_t i = 0; i < r.size(); ++i) {
-                    generateResultMeasurement(n.children, i, r, out);
-                }
-            } else {
-                ANKERL_NANOBENCH_THROW(std::runtime_error("render: unknown section '" + templates::text(n) + "'"));
-            }
-            break;
+void render(Template const& tpl, std::vector<BigO> const& bigOs, std::ostream& out) {
+    detail::fmt::StreamStateRestorer const restorer(out);
 
-        case templates::Node::Type::tag:
-            if (results.size() == 1) {
-                // result & config are both supported there
-                generateResultTag(n, results.front(), out);
-            } else {
-                // This just uses the last result's config.
-                if (!generateConfigTag(n, results.back().config(), out)) {
-                    ANKERL_NANOBENCH_THROW(std::runtime_error("unknown tag '" + templates::text(n) + "'"));
-                }
-            }
-            break;
-        }
-    }
+    out.precision(std::numeric_limits<double>::digits10);
+    std::vector<Result> const noResults;
+    templates::run(*tpl.mOps, templates::Frame{&noResults, nullptr, nullptr, 0, 0, nullptr, nullptr, &bigOs}, out);
+}
+
+void render(Template const& tpl, Bench const& bench, std::ostream& out) {
+    render(tpl, bench.results(), out);
+}
+
+void render(char const* mustacheTemplate, std::vector<Result> const& results, std::ostream& out) {
+    render(Template(mustacheTemplate), results, out);
 }
 
 void render(std::string const& mustacheTemplate, std::vector<Result> const& results, std::ostream& out) {
-    render(mustacheTemplate.c_str(), results, out);
+    render(Template(mustacheTemplate), results, out);
+}
+
+void render(char const* mustacheTemplate, CompareResult const& compareResult, std::ostream& out) {
+    render(Template(mustacheTemplate), compareResult, out);
+}
+
+void render(std::string const& mustacheTemplate, CompareResult const& compareResult, std::ostream& out) {
+    render(Template(mustacheTemplate), compareResult, out);
+}
+
+void render(char const* mustacheTemplate, std::vector<BigO> const& bigOs, std::ostream& out) {
+    render(Template(mustacheTemplate), bigOs, out);
+}
+
+void render(std::string const& mustacheTemplate, std::vector<BigO> const& bigOs, std::ostream& out) {
+    render(Template(mustacheTemplate), bigOs, out);
 }
 
 void render(char const* mustacheTemplate, const Bench& bench, std::ostream& out) {
-    render(mustacheTemplate, bench.results(), out);
+    render(Template(mustacheTemplate), bench.results(), out);
 }
 
 void render(std::string const& mustacheTemplate, const Bench& bench, std::ostream& out) {
-    render(mustacheTemplate.c_str(), bench.results(), out);
+    render(Template(mustacheTemplate), bench.results(), out);
 }
 
 namespace detail {
@@ -2671,6 +5023,12 @@ bool isWarningsEnabled() {
     return nullptr == suppression || suppression == std::string("0");
 }
 
+// True when environment variable NANOBENCH_UPDATE_BASELINE is set to anything but "0"
+bool isBaselineUpdateRequested() {
+    auto const* const update = getEnv("NANOBENCH_UPDATE_BASELINE");
+    return nullptr != update && update != std::string("0");
+}
+
 // NANOBENCH_CONFIG ///////////////////////////////////////////////////////////////////////////////
 //
 // The parsing below reports a bad value by returning the reason for it as a string, empty when the
@@ -2845,12 +5203,13 @@ static bool setDuration(Bench& bench, std::string const& key, char const* name,
 // Everything NANOBENCH_CONFIG understands, each key named exactly once. '||' short-circuits, so at
 // most one of these runs and nothing past the match is even evaluated.
 //
-// This is the shape generateConfigTag() uses for the same seven names in the other direction, and
+// This is the shape configTagOf() uses for the same seven names in a template, and
 // for the reason its comment gives: as a stanza per key, the one mistake the compiler cannot see is
 // a key you classified and then forgot to assign, which falls through to whichever branch was last.
 static bool applyKnownKey(Bench& bench, std::string const& key, std::string const& value, std::string& reason) {
     return setDuration(bench, key, "minEpochTime", &Bench::minEpochTime, value, reason) ||
            setDuration(bench, key, "maxEpochTime", &Bench::maxEpochTime, value, reason) ||
+           setDuration(bench, key, "progress", &Bench::progress, value, reason) ||
            setCount<size_t>(bench, key, "epochs", &Bench::epochs, value, reason) ||
            setCount<uint64_t>(bench, key, "warmup", &Bench::warmup, value, reason) ||
            setCount<uint64_t>(bench, key, "minEpochIterations", &Bench::minEpochIterations, value, reason) ||
@@ -2859,11 +5218,11 @@ static bool applyKnownKey(Bench& bench, std::string const& key, std::string cons
 }
 
 // Sorted, and next to the chain above so that a key added to one and not the other is visible on one
-// screen. Only tuning knobs are there at all: name, title, unit, batch and timeUnit say what a
-// benchmark *is*, and letting a shell variable change those for a whole process would change what
-// the numbers mean rather than how long they take.
+// screen. Only tuning knobs are there at all, and progress, which only writes to stderr: name, title,
+// unit, batch and timeUnit say what a benchmark *is*, and letting a shell variable change those for a
+// whole process would change what the numbers mean rather than how long they take.
 static char const* configKeyList() {
-    return "clockResolutionMultiple, epochIterations, epochs, maxEpochTime, minEpochIterations, minEpochTime, warmup";
+    return "clockResolutionMultiple, epochIterations, epochs, maxEpochTime, minEpochIterations, minEpochTime, progress, warmup";
 }
 
 static void applyConfigEntry(Bench& bench, std::string const& key, std::string const& value, std::vector<std::string>& errors) {
@@ -3026,21 +5385,69 @@ void printPerformanceCounterHintOnce(std::ostream* outStream, bool wantsPerforma
     }
     shouldPrint = false;
 
-    auto const& has = performanceCounters().has();
-    if (has.instructions || has.cpuCycles || has.branchInstructions || has.branchMisses) {
-        return;
-    }
-
-    *outStream << "Note: perf_event_open failed, so the ins/op, cyc/op, IPC, bra/op and miss% columns are missing." << std::endl
-               << "This is usually a container or VM without virtualized performance counters, or" << std::endl
-               << "/proc/sys/kernel/perf_event_paranoid being too restrictive." << std::endl
-               << std::endl;
+    *outStream << performanceCounterNote(performanceCounters().has(), performanceCounters().opened()) << std::flush;
 #    else
     (void)outStream;
     (void)wantsPerformanceCounters;
 #    endif
 }
 
+std::string performanceCounterNote(PerfCountSet<bool> const& has, PerfCountSet<bool> const& opened) {
+    if (!has.instructions && !has.cpuCycles && !has.branchInstructions && !has.branchMisses) {
+        if (!opened.instructions && !opened.cpuCycles && !opened.branchInstructions && !opened.branchMisses) {
+            return "Note: perf_event_open failed, so the ins/op, cyc/op, IPC, bra/op and miss% columns are missing.\n"
+                   "This is usually a container or VM without virtualized performance counters, or\n"
+                   "/proc/sys/kernel/perf_event_paranoid being too restrictive.\n\n";
+        }
+        return "Note: the kernel never ran the hardware performance counters, so the ins/op, cyc/op, IPC, bra/op and\n"
+               "miss% columns are missing. This is usually another user of the PMU, such as perf or the NMI\n"
+               "watchdog, or a VM that offers counters it does not back.\n\n";
+    }
+
+    // named the way the templates name them, so the note says which {{...}} will come out as 0
+    struct Counter {
+        char const* name;
+        bool isLive;
+        bool isOpened;
+    };
+    Counter const counters[] = {{"cpucycles", has.cpuCycles, opened.cpuCycles},
+                                {"instructions", has.instructions, opened.instructions},
+                                {"branchinstructions", has.branchInstructions, opened.branchInstructions},
+                                {"branchmisses", has.branchMisses, opened.branchMisses},
+                                {"pagefaults", has.pageFaults, opened.pageFaults},
+                                {"contextswitches", has.contextSwitches, opened.contextSwitches}};
+    std::string live;
+    std::string failed;
+    std::string unscheduled;
+    for (auto const& counter : counters) {
+        auto& list = counter.isLive ? live : counter.isOpened ? unscheduled : failed;
+        if (!list.empty()) {
+            list += ", ";
+        }
+        list += counter.name;
+    }
+    if (failed.empty() && unscheduled.empty()) {
+        return {};
+    }
+
+    std::string note = "Note: ";
+    if (!failed.empty()) {
+        note += "perf_event_open failed for " + failed;
+    }
+    if (!unscheduled.empty()) {
+        note += (failed.empty() ? "" : ", and ") + std::string("the kernel never ran ") + unscheduled;
+    }
+    note += ", so only " + live + " are measured.\n";
+    if (!failed.empty()) {
+        note += "This is usually a VM that virtualizes only part of the performance monitoring unit.\n";
+    }
+    if (!unscheduled.empty()) {
+        note += "A counter that opens but never runs is usually taken by another user of the PMU, such as perf\n"
+                "or the NMI watchdog.\n";
+    }
+    return note + "\n";
+}
+
 // Which index of the pword/iword array every stream carries is ours. Allocated once per process.
 static int streamHeaderHashIndex() {
     static int const index = std::ios_base::xalloc();
@@ -3170,6 +5577,57 @@ static std::vector<fmt::MarkDownColumn> counterColumns(Config const& config, Res
     return columns;
 }
 
+// What the table's statistics are taken over: the epochs that are left when outliers are excluded or
+// were measured again, every epoch otherwise. One place, so that the columns, the relative column and
+// the :wavy_dash: marker cannot disagree about which epochs count.
+//
+// Every row of every table asks for this, so it is `result` itself unless epochs are actually
+// filtered out. Only then is there a copy, kept alive in `filtered` for as long as the caller needs it.
+static Result const& tableStatistics(Result const& result, std::unique_ptr<Result>& filtered) {
+    auto const& config = result.config();
+    if (OutlierMethod::none == config.mOutlierMethod || OutlierAction::count == config.mOutlierAction) {
+        return result;
+    }
+    filtered.reset(new Result(result.withoutOutliers()));
+    return *filtered;
+}
+
+// Every epoch's elapsed time, in the order they were measured. Empty for a streaming result, which
+// kept none.
+static std::vector<double> epochTimes(Result const& result) {
+    std::vector<double> times;
+    if (result.streaming()) {
+        return times;
+    }
+    times.reserve(result.size());
+    for (size_t i = 0; i < result.size(); ++i) {
+        times.push_back(result.get(i, Result::Measure::elapsed));
+    }
+    return times;
+}
+
+// "-0.8% .. +1.2%" from two offsets in percent, the way both interval columns spell them.
+static std::string intervalText(double lowPercent, double highPercent, bool isSigned) {
+    std::ostringstream ss;
+    ss << (isSigned && lowPercent >= 0.0 ? "+" : "") << fmt::Number(1, 1, lowPercent) << "% .. "
+       << (isSigned && highPercent >= 0.0 ? "+" : "") << fmt::Number(1, 1, highPercent) << "%";
+    return ss.str();
+}
+
+std::string medianIntervalText(Result const& shown) {
+    auto const times = epochTimes(shown);
+    auto const indices = medianIntervalIndices(times.size(), 0.95);
+    if (indices.first > indices.second) {
+        return {};
+    }
+    auto const median = medianOf(times);
+    if (!(median > 0.0)) {
+        return {};
+    }
+    auto const interval = medianInterval(times, 0.95);
+    return intervalText((interval.first / median - 1.0) * 100.0, (interval.second / median - 1.0) * 100.0, true);
+}
+
 // The columns that describe what was measured, as opposed to how one row relates to another. Both
 // table writers are built out of these: IterationLogic prepends `relative`, a comparison prepends
 // `relative` and `95% CI`, and everything from here on is the same table in both.
@@ -3184,7 +5642,11 @@ static std::vector<fmt::MarkDownColumn> counterColumns(Config const& config, Res
 static std::vector<fmt::MarkDownColumn> measurementColumns(Config const& config, Result const& result) {
     std::vector<fmt::MarkDownColumn> columns;
 
-    auto const median = result.median(Result::Measure::elapsed);
+    // `total` stays the sum over all epochs: that is time that was spent either way
+    std::unique_ptr<Result> filtered;
+    auto const& shown = tableStatistics(result, filtered);
+
+    auto const median = shown.median(Result::Measure::elapsed);
 
     if (config.mComplexityN > 0.0) {
         addColumn(columns, config, Column::complexityN, 14, 0, "complexityN", "", config.mComplexityN);
@@ -3202,9 +5664,15 @@ static std::vector<fmt::MarkDownColumn> measurementColumns(Config const& config,
     addColumn(columns, config, Column::timePerUnit, 22, 2, config.mTimeUnitName + "/" + config.mUnit, "",
               median / (config.mTimeUnit.count() * config.mBatch));
     addColumn(columns, config, Column::unitPerSecond, 22, 2, config.mUnit + "/s", "", median <= 0.0 ? 0.0 : config.mBatch / median);
-    addColumn(columns, config, Column::error, 10, 1, "err%", "%", result.medianAbsolutePercentError(Result::Measure::elapsed) * 100.0);
+    addColumn(columns, config, Column::error, 10, 1, "err%", "%", shown.medianAbsolutePercentError(Result::Measure::elapsed) * 100.0);
+    if (config.mShowConfidenceIntervals && isColumnVisible(config, Column::medianInterval)) {
+        columns.emplace_back(18, "median 95% CI", medianIntervalText(shown));
+    }
+    if (OutlierMethod::none != config.mOutlierMethod) {
+        addColumn(columns, config, Column::outliers, 7, 0, "outl", "", d(result.numOutliers()));
+    }
 
-    auto const counters = counterColumns(config, result);
+    auto const counters = counterColumns(config, shown);
     columns.insert(columns.end(), counters.begin(), counters.end());
 
     addColumn(columns, config, Column::total, 12, 2, "total", "",
@@ -3232,24 +5700,101 @@ static void writeTableHeaderLines(std::ostream& os, std::vector<fmt::MarkDownCol
     os << "|:" << std::string(title.size() + 1U, '-') << std::endl;
 }
 
+static Config streamingConfig(Config config) {
+    config.mStreaming = true;
+    return config;
+}
+
+// How often a live report is printed, 0 for never. An endless run never gets to its final row, so it
+// reports every 10 seconds unless told otherwise.
+static std::chrono::nanoseconds liveReportInterval(Bench const& bench, bool isEndless) {
+    if (!isEndless || bench.liveReport().count() > 0) {
+        return bench.liveReport();
+    }
+    return std::chrono::seconds(10);
+}
+
+// The columns of a live report row: the statistics of every epoch so far, and the median of the epochs
+// since the previous row next to it. drift% is how far that window is off the overall median, so a
+// soak run that gets slower over the hours shows it while it happens, not after.
+static std::vector<fmt::MarkDownColumn> liveReportColumns(Config const& config, Result const& overall, Result const& window) {
+    auto const perUnit = config.mTimeUnit.count() * config.mBatch;
+    auto const median = overall.median(Result::Measure::elapsed);
+    auto const windowMedian = window.median(Result::Measure::elapsed);
+
+    std::vector<fmt::MarkDownColumn> columns;
+    columns.emplace_back(12, 0, "epochs", "", d(overall.size()));
+    columns.emplace_back(22, 2, config.mTimeUnitName + "/" + config.mUnit, "", median / perUnit);
+    columns.emplace_back(10, 1, "err%", "%", overall.medianAbsolutePercentError(Result::Measure::elapsed) * 100.0);
+    columns.emplace_back(22, 2, "window " + config.mTimeUnitName + "/" + config.mUnit, "", windowMedian / perUnit);
+    columns.emplace_back(10, 1, "drift%", "%", median <= 0.0 ? 0.0 : (windowMedian / median - 1.0) * 100.0);
+    return columns;
+}
+
+// When the process last wrote a progress line, so that several benches in a row keep to one interval.
+static Clock::time_point& progressLastShown() {
+    static Clock::time_point lastShown{};
+    return lastShown;
+}
+
+// The trace files this process has started, see Bench::trace().
+static std::vector<std::string>& traceStartedPaths() {
+#    if defined(__clang__)
+#        pragma clang diagnostic push
+#        pragma clang diagnostic ignored "-Wexit-time-destructors"
+#    endif
+    static std::vector<std::string> paths;
+#    if defined(__clang__)
+#        pragma clang diagnostic pop
+#    endif
+    return paths;
+}
+
 ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
 struct IterationLogic::Impl {
-    enum class State { warmup, upscaling_runtime, measuring, endless };
+    enum class State { warmup, upscaling_runtime, measuring };
 
-    explicit Impl(Bench const& bench)
+    // The result shares the snapshot of the bench's config. An endless run keeps running statistics
+    // instead of its epochs, or it would run out of memory long before anyone stops it; and the
+    // window, which only sees epochs when there is live reporting, always does.
+    Impl(Bench const& bench, std::shared_ptr<Config const> const& config)
         : mBench(bench)
-        , mResult(bench.config()) {
+        , mResult(isEndlessRunning(bench.name()) ? Result(streamingConfig(*config)) : Result(config))
+        , mIsEndless(isEndlessRunning(bench.name()))
+        , mLiveReportInterval(liveReportInterval(bench, mIsEndless))
+        , mWindow(0 == mLiveReportInterval.count() ? Result(config) : Result(streamingConfig(*config)))
+        , mLastLiveReport(Clock::now())
+        , mTracePath(tracePath(*config)) {
+        if (!mTracePath.empty()) {
+            traceOrigin();
+            mTraceBegin = Clock::now();
+        }
+
         printStabilityInformationOnce(mBench.output());
         printPerformanceCounterHintOnce(mBench.output(), mBench.performanceCounters());
 
         // determine target runtime per epoch
         mTargetRuntimePerEpoch = detail::targetRuntimePerEpoch(mBench);
 
-        if (isEndlessRunning(mBench.name())) {
+        if (mIsEndless) {
             std::cerr << "NANOBENCH_ENDLESS set: running '" << mBench.name() << "' endlessly" << std::endl;
-            mNumIters = (std::numeric_limits<uint64_t>::max)();
-            mState = State::endless;
-        } else if (0 != mBench.warmup()) {
+        }
+
+        if (hasBaselineFile()) {
+            auto const key = baselineKey(*config);
+            for (auto const& entry : baselineEntries(*mBench.mBaselineFile, config->mBaselinePath)) {
+                if (entry.first == key) {
+                    mBaselineEpochs = entry.second;
+                    mHasBaseline = true;
+                }
+            }
+        }
+
+        if (!mIsEndless && restoreFromCheckpoint(*config)) {
+            return;
+        }
+
+        if (0 != mBench.warmup()) {
             mNumIters = mBench.warmup();
             mState = State::warmup;
         } else if (hasExactNumIters()) {
@@ -3259,6 +5804,33 @@ struct IterationLogic::Impl {
             mNumIters = mBench.minEpochIterations();
             mState = State::upscaling_runtime;
         }
+
+        // the clock's resolution, the counters and the baseline are all set up by now
+        if (!mTracePath.empty()) {
+            mTraceSpans.push_back(TraceSpan{"calibration", mTraceBegin, Clock::now(), 0, 0, {}});
+        }
+        if (0 != mBench.progress().count()) {
+            mProgressBegin = Clock::now();
+            showProgress();
+        }
+    }
+
+    // A benchmark the checkpoint file already has is not run again: its saved epochs finish it right
+    // away, the way its last epoch would have, so that its row and baseline comparison are the same as
+    // the first time.
+    bool restoreFromCheckpoint(Config const& config) {
+        auto const path = checkpointPath(config);
+        if (path.empty() || !CheckpointLog::of(path).restore(config, mResult)) {
+            return false;
+        }
+        mTotalNumIters = static_cast<uint64_t>(mResult.sum(Result::Measure::iterations));
+        mIsRestored = true;
+        mNumEpochsNeeded = mResult.size();
+        mState = State::measuring;
+        mNumIters = 0;
+        compareToBaseline();
+        showResult("");
+        return true;
     }
 
     // True when an exact number of iterations per epoch was requested, which overrides any calculated one.
@@ -3305,6 +5877,27 @@ struct IterationLogic::Impl {
         }
     }
 
+    // The same as add() with the epoch's duration, and when tracing it also puts the epoch on the
+    // timeline. What the epoch was is decided by add(), so the phase is taken before and the result's
+    // size compared after: an upscaling epoch that turned out close enough is a measured one.
+    void add(Clock::time_point before, Clock::time_point after, PerformanceCounters const& pc) noexcept {
+        auto const elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(after - before);
+        if (mTracePath.empty()) {
+            add(elapsed, pc);
+            return;
+        }
+
+        auto const* phase = State::warmup == mState ? "warmup" : "upscaling_runtime";
+        auto const numIters = mNumIters;
+        auto const numEpochs = mResult.size();
+        add(elapsed, pc);
+        if (mResult.size() != numEpochs) {
+            phase = "measuring";
+        }
+        mTraceHas = mBench.performanceCounters() ? pc.has() : PerfCountSet<bool>{};
+        mTraceSpans.push_back(TraceSpan{phase, before, after, numIters, numEpochs, pc.val()});
+    }
+
     void add(std::chrono::nanoseconds elapsed, PerformanceCounters const& pc) noexcept {
 #    if defined(ANKERL_NANOBENCH_LOG_ENABLED)
         auto oldIters = mNumIters;
@@ -3329,9 +5922,7 @@ struct IterationLogic::Impl {
             if (isCloseEnoughForMeasurements(elapsed)) {
                 // if we are close enough, add measurement and switch to always measuring
                 mState = State::measuring;
-                mTotalElapsed += elapsed;
-                mTotalNumIters += mNumIters;
-                mResult.add(elapsed, mNumIters, pc);
+                addMeasurement(elapsed, pc);
                 mNumIters = calcNextNumIters(mTotalElapsed, mTotalNumIters);
             } else {
                 upscale(elapsed);
@@ -3341,21 +5932,21 @@ struct IterationLogic::Impl {
         case State::measuring:
             // just add measurements - no questions asked. Even when runtime is low. But we can't ignore
             // that fluctuation, or else we would bias the result
-            mTotalElapsed += elapsed;
-            mTotalNumIters += mNumIters;
-            mResult.add(elapsed, mNumIters, pc);
+            addMeasurement(elapsed, pc);
             mNumIters = calcNextNumIters(mTotalElapsed, mTotalNumIters);
             break;
-
-        case State::endless:
-            mNumIters = (std::numeric_limits<uint64_t>::max)();
-            break;
         }
 
-        if (static_cast<uint64_t>(mResult.size()) == mBench.epochs()) {
+        if (!mIsEndless && mNumEpochsNeeded == (std::numeric_limits<size_t>::max)() && mResult.size() >= mBench.epochs()) {
+            decideNumEpochs();
+        }
+        if (hasAllEpochs()) {
             // we got all the results that we need, finish it
+            compareToBaseline();
             showResult("");
             mNumIters = 0;
+        } else if (0 != mBench.progress().count()) {
+            showProgress();
         }
 
         ANKERL_NANOBENCH_LOG(mBench.name() << ": " << detail::fmt::Number(20, 3, d(elapsed.count())) << " elapsed, "
@@ -3363,6 +5954,270 @@ struct IterationLogic::Impl {
                                            << oldIters << ", mNumIters=" << mNumIters << ", mState=" << static_cast<int>(mState));
     }
 
+    // How many epochs measuring takes, decided once the epochs asked for are there. With
+    // OutlierAction::remeasure each outlier among them is made up for by another epoch, but only up to
+    // twice the epochs asked for: an operation whose every other epoch is an outlier is not going to
+    // settle down, and a result that says so beats one that never arrives. Classifying sorts all the
+    // epochs, so it is done this once rather than again after every extra epoch.
+    void decideNumEpochs() {
+        auto const wanted = mBench.epochs();
+        mNumEpochsNeeded = wanted;
+        if (OutlierAction::remeasure == mBench.outlierAction()) {
+            mNumEpochsNeeded += (std::min)(mResult.numOutliers(), wanted);
+        }
+    }
+
+    // Whether measuring is done, see decideNumEpochs().
+    ANKERL_NANOBENCH(NODISCARD) bool hasAllEpochs() const noexcept {
+        return !mIsEndless && mResult.size() >= mNumEpochsNeeded;
+    }
+
+    // A streaming result has no epochs to compare or save.
+    ANKERL_NANOBENCH(NODISCARD) bool hasBaselineFile() const {
+        return !mResult.config().mBaselinePath.empty() && !mResult.streaming();
+    }
+
+    // The interval for the relative column: unpaired, as for a baseline, and turned around because
+    // `relative` is the first run's time over this one's. Empty for the first run itself, and when
+    // either run kept no epochs.
+    ANKERL_NANOBENCH(NODISCARD) std::string relativeIntervalText() const {
+        if (mBench.results().empty()) {
+            return {};
+        }
+        auto const& baseline = mBench.results().front();
+        std::unique_ptr<Result> filtered;
+        auto const baselineTimes = epochTimes(tableStatistics(baseline, filtered));
+        auto const times = epochTimes(tableStatistics(mResult, filtered));
+        if (baselineTimes.empty() || times.empty()) {
+            return {};
+        }
+        auto const comparison = detail::compareToBaseline(mBench.name(), baselineTimes, times, 0.0);
+        // per unit, as the relative column is
+        auto const perUnit = mBench.batch() / baseline.config().mBatch * 100.0;
+        return intervalText(perUnit / comparison.relativeHigh, perUnit / comparison.relativeLow, false);
+    }
+
+    // Per unit, like the ns/op column, so that a different batch() does not look like a change.
+    ANKERL_NANOBENCH(NODISCARD) std::vector<double> epochTimesPerUnit() const {
+        std::vector<double> times;
+        times.reserve(mResult.size());
+        for (size_t i = 0; i < mResult.size(); ++i) {
+            times.push_back(mResult.get(i, Result::Measure::elapsed) / mResult.config().mBatch);
+        }
+        return times;
+    }
+
+    void compareToBaseline() {
+        if (!mHasBaseline) {
+            return;
+        }
+        mBaselineComparison = detail::compareToBaseline(mBench.name(), mBaselineEpochs, epochTimesPerUnit(),
+                                                        mResult.config().mBaselineTolerance);
+        mIsCompared = true;
+    }
+
+    // Saves this run's epochs unless the file already has some and they are not to be updated. A new
+    // benchmark is one line appended to the file; only an update, a file that has no entries yet, or
+    // one that ends in a line cut short, writes all of it.
+    void saveBaselineEntry() const {
+        if (!hasBaselineFile() || !hasAllEpochs()) {
+            return;
+        }
+        auto const& config = mResult.config();
+        bool const isUpdate = config.mBaselineUpdate || isBaselineUpdateRequested();
+        auto const key = baselineKey(config);
+        auto& entries = baselineEntries(*mBench.mBaselineFile, config.mBaselinePath);
+        auto const find = [&] {
+            return std::find_if(entries.begin(), entries.end(), [&](BaselineEntries::value_type const& entry) {
+                return entry.first == key;
+            });
+        };
+        auto it = find();
+        if (it != entries.end() && !isUpdate) {
+            return;
+        }
+        bool isSaved = false;
+        if (it == entries.end() && !entries.empty() && endsInNewline(config.mBaselinePath)) {
+            // the file has its header, so a new entry goes at the end of it
+            entries.emplace_back(key, epochTimesPerUnit());
+            isSaved = appendBaseline(config.mBaselinePath, entries.back());
+        } else {
+            // Anything else rewrites the whole file: an update, a file that may not have the header
+            // yet, or one whose last line was cut short and would swallow an appended entry. It is
+            // read again first, since another bench may have saved to it after this one read it, and
+            // writing this one's copy back would undo that.
+            entries = loadBaseline(config.mBaselinePath);
+            it = find();
+            if (it == entries.end()) {
+                entries.emplace_back(key, epochTimesPerUnit());
+            } else {
+                it->second = epochTimesPerUnit();
+            }
+            isSaved = saveBaseline(config.mBaselinePath, entries);
+        }
+        if (!isSaved) {
+            std::cerr << "nanobench: could not save the baseline to '" << config.mBaselinePath << "'" << std::endl;
+        }
+    }
+
+    // Appends this result to the checkpoint file. Being killed in the middle of it leaves a result cut
+    // short at the end, which the next process to open the file drops.
+    void saveCheckpoint() const {
+        auto const path = checkpointPath(mResult.config());
+        if (path.empty() || mIsRestored || !hasAllEpochs() || mResult.streaming()) {
+            return;
+        }
+        if (!CheckpointLog::of(path).append(mResult)) {
+            std::cerr << "nanobench: could not write to '" << path << "'" << std::endl;
+        }
+    }
+
+    // Appends this result to the JSON Lines file, if there is one. Opened and closed again for every
+    // result, so that each line is on disk as soon as its benchmark is done and a crash later on
+    // loses nothing already written.
+    void appendJsonLine() const {
+        auto const path = jsonLinesPath(mResult.config());
+        if (path.empty()) {
+            return;
+        }
+        std::ofstream out(path, std::ios::app);
+        writeJsonLine(out, mResult, mResult.config().mJsonLinesMeasurements);
+        if (!out) {
+            std::cerr << "nanobench: could not write to '" << path << "'" << std::endl;
+        }
+    }
+
+    // Appends this benchmark's timeline to the trace file, if there is one. The first benchmark of the
+    // process to trace into a file starts it over, with the '[' that opens the array and an event
+    // naming the process - so that every event after it can start with its comma.
+    void appendTrace() const {
+        if (mTracePath.empty()) {
+            return;
+        }
+        auto& started = traceStartedPaths();
+        bool const isNew = std::find(started.begin(), started.end(), mTracePath) == started.end();
+        std::ofstream out(mTracePath, isNew ? std::ios::trunc : std::ios::app);
+        if (isNew) {
+            started.push_back(mTracePath);
+            out << R"([{"name":"process_name","ph":"M","pid":1,"tid":1,"args":{"name":"nanobench"}})";
+        }
+        writeTraceEvents(out, mResult, mTraceBegin, Clock::now(), mTraceSpans, mTraceHas);
+        if (!out) {
+            std::cerr << "nanobench: could not write to '" << mTracePath << "'" << std::endl;
+        }
+    }
+
+    // The text of the `vs. base` column
+    ANKERL_NANOBENCH(NODISCARD) std::string baselineText() const {
+        if (!mIsCompared) {
+            return "new";
+        }
+        std::stringstream ss;
+        ss.imbue(std::locale::classic());
+        ss << std::showpos << std::fixed << std::setprecision(1) << (mBaselineComparison.relative - 1.0) * 100.0 << '%';
+        if (BaselineVerdict::slower == mBaselineComparison.verdict) {
+            ss << " slower";
+        } else if (BaselineVerdict::faster == mBaselineComparison.verdict) {
+            ss << " faster";
+        }
+        return ss.str();
+    }
+
+    void addMeasurement(std::chrono::nanoseconds elapsed, PerformanceCounters const& pc) {
+        mTotalElapsed += elapsed;
+        mTotalNumIters += mNumIters;
+        mResult.add(elapsed, mNumIters, pc);
+
+        if (0 == mLiveReportInterval.count()) {
+            return;
+        }
+        mWindow.add(elapsed, mNumIters, pc);
+        auto const now = Clock::now();
+        if (now - mLastLiveReport >= mLiveReportInterval) {
+            showLiveReport();
+            mWindow = Result(mWindow.config());
+            mLastLiveReport = now;
+        }
+    }
+
+    // How long the rest of this benchmark is going to take: the epochs still to go, at the target time
+    // of an epoch until there are measured ones to average. The target is stretched by the 10% that
+    // calcBestNumIters() adds on average.
+    ANKERL_NANOBENCH(NODISCARD) std::chrono::nanoseconds progressTimeLeft() const {
+        auto const numEpochs = mResult.size();
+        auto const wanted = (std::max)(mBench.epochs(), numEpochs);
+        auto const perEpoch = 0U == numEpochs ? d(mTargetRuntimePerEpoch) * 1.1 : d(mTotalElapsed) / d(numEpochs);
+        return std::chrono::nanoseconds(static_cast<int64_t>(perEpoch * d(wanted - numEpochs)));
+    }
+
+    // One line on stderr, when the interval since the process's last one has passed. Only ever called
+    // between epochs, so writing it is never part of what is measured.
+    void showProgress() const {
+        auto const now = Clock::now();
+        auto& lastShown = progressLastShown();
+        if (now - lastShown < mBench.progress()) {
+            return;
+        }
+        lastShown = now;
+
+        auto const numDone = mBench.results().size();
+        auto const total = mBench.progressTotal();
+        std::ostringstream line;
+        line << "nanobench: ";
+        if (0U != total) {
+            line << '[' << numDone + 1U << '/' << (std::max)(total, numDone + 1U) << "] ";
+        }
+        line << mBench.title() << " / " << mBench.name() << ": ";
+        if (State::measuring != mState) {
+            line << "calibrating";
+        } else if (mIsEndless) {
+            line << "epoch " << mResult.size() + 1U;
+        } else {
+            line << "epoch " << mResult.size() + 1U << '/' << (std::max)(mBench.epochs(), mResult.size() + 1U);
+        }
+
+        if (!mIsEndless) {
+            auto const left = progressTimeLeft();
+            line << ", ~" << progressDuration(left) << " left";
+            if (numDone + 1U < total) {
+                // the benchmarks still to come take as long as the ones before did, or as this one
+                // does when it is the first
+                auto const perBenchmark = 0U == mBench.mProgressBenchmarks
+                                              ? d((now - mProgressBegin) + left)
+                                              : d(mBench.mProgressElapsed) / d(mBench.mProgressBenchmarks);
+                auto const suiteLeft = d(left) + perBenchmark * d(total - numDone - 1U);
+                line << ", ~" << progressDuration(std::chrono::nanoseconds(static_cast<int64_t>(suiteLeft)))
+                     << " left in the suite";
+            }
+        }
+        std::cerr << line.str() << std::endl;
+    }
+
+    void showLiveReport() const {
+        if (nullptr == mBench.output()) {
+            return;
+        }
+        auto const columns = liveReportColumns(mResult.config(), mResult, mWindow);
+        auto& os = *mBench.output();
+
+        // same rule as showResult(): a new header whenever the columns change, so the final row gets its own
+        uint64_t hash = 0;
+        hash = hash_combine(std::hash<std::string>{}(mBench.title()), hash);
+        for (auto const& col : columns) {
+            hash = hash_combine(std::hash<std::string>{}(col.title()), hash);
+        }
+        auto& lastHeaderHash = streamHeaderHash(os);
+        if (hash != lastHeaderHash) {
+            lastHeaderHash = hash;
+            writeTableHeaderLines(os, columns, mBench.title());
+        }
+
+        for (auto const& col : columns) {
+            os << col.value();
+        }
+        os << "| " << fmt::MarkDownCode(mBench.name()) << std::endl;
+    }
+
     void showResult(std::string const& errorMessage) const {
         ANKERL_NANOBENCH_LOG(errorMessage);
 
@@ -3380,22 +6235,31 @@ struct IterationLogic::Impl {
                 // give a skewed percentage as soon as the baseline was run with a different batch size.
                 // See https://github.com/martinus/nanobench/issues/131
                 // This is (baseline / baselineBatch) / (rMedian / batch) as a single fraction, so one guard does.
-                auto const rMedian = mResult.median(Result::Measure::elapsed);
+                std::unique_ptr<Result> filtered;
+                auto const rMedian = tableStatistics(mResult, filtered).median(Result::Measure::elapsed);
                 auto const& baseline = mBench.results().front();
-                auto const num = baseline.median(Result::Measure::elapsed) * mBench.batch();
+                auto const num = tableStatistics(baseline, filtered).median(Result::Measure::elapsed) * mBench.batch();
                 auto const den = rMedian * baseline.config().mBatch;
                 relativePercent = den <= 0.0 ? 0.0 : num / den * 100.0;
             }
             if (isColumnVisible(mBench.config(), Column::relative)) {
                 columns.push_back(relativeColumn(relativePercent));
             }
+            if (mBench.confidenceIntervals() && isColumnVisible(mBench.config(), Column::relativeInterval)) {
+                columns.emplace_back(20, "relative 95% CI", relativeIntervalText());
+            }
         }
 
         // everything a comparison table shows too
         auto const measurements = measurementColumns(mResult.config(), mResult);
         columns.insert(columns.end(), measurements.begin(), measurements.end());
 
-        double const rErrorMedian = mResult.medianAbsolutePercentError(Result::Measure::elapsed);
+        if (hasBaselineFile() && isColumnVisible(mBench.config(), Column::baseline)) {
+            columns.emplace_back(17, "vs. base", errorMessage.empty() ? baselineText() : std::string());
+        }
+
+        std::unique_ptr<Result> filtered;
+        double const rErrorMedian = tableStatistics(mResult, filtered).medianAbsolutePercentError(Result::Measure::elapsed);
 
         // write everything
         auto& os = *mBench.output();
@@ -3435,7 +6299,7 @@ struct IterationLogic::Impl {
         }
         os << fmt::MarkDownCode(mBench.name());
         if (showUnstable) {
-            auto avgIters = d(mTotalNumIters) / d(mBench.epochs());
+            auto avgIters = d(mTotalNumIters) / d(mResult.size());
             auto suggestedIters = u64(avgIters * 10);
 
             os << " (Unstable with ~" << detail::fmt::Number(1, 1, avgIters) << " iters. Increase `minEpochIterations` to e.g. "
@@ -3456,11 +6320,27 @@ struct IterationLogic::Impl {
     std::chrono::nanoseconds mTotalElapsed{};          // NOLINT(misc-non-private-member-variables-in-classes)
     uint64_t mTotalNumIters = 0;                       // NOLINT(misc-non-private-member-variables-in-classes)
     State mState = State::upscaling_runtime;           // NOLINT(misc-non-private-member-variables-in-classes)
+    bool mIsEndless;                                   // NOLINT(misc-non-private-member-variables-in-classes)
+    std::chrono::nanoseconds mLiveReportInterval;      // NOLINT(misc-non-private-member-variables-in-classes)
+    Result mWindow;                                    // NOLINT(misc-non-private-member-variables-in-classes)
+    Clock::time_point mLastLiveReport;                 // NOLINT(misc-non-private-member-variables-in-classes)
+    std::vector<double> mBaselineEpochs{};             // NOLINT(misc-non-private-member-variables-in-classes)
+    bool mHasBaseline = false;                         // NOLINT(misc-non-private-member-variables-in-classes)
+    BaselineComparison mBaselineComparison{};          // NOLINT(misc-non-private-member-variables-in-classes)
+    bool mIsCompared = false;                          // NOLINT(misc-non-private-member-variables-in-classes)
+    std::string mTracePath;                            // NOLINT(misc-non-private-member-variables-in-classes)
+    std::vector<TraceSpan> mTraceSpans{};              // NOLINT(misc-non-private-member-variables-in-classes)
+    PerfCountSet<bool> mTraceHas{};                    // NOLINT(misc-non-private-member-variables-in-classes)
+    Clock::time_point mTraceBegin{};                   // NOLINT(misc-non-private-member-variables-in-classes)
+    Clock::time_point mProgressBegin{};                // NOLINT(misc-non-private-member-variables-in-classes)
+    bool mIsRestored = false;                          // NOLINT(misc-non-private-member-variables-in-classes)
+    // not decided yet, see decideNumEpochs()
+    size_t mNumEpochsNeeded = (std::numeric_limits<size_t>::max)(); // NOLINT(misc-non-private-member-variables-in-classes)
 };
 ANKERL_NANOBENCH(IGNORE_PADDED_POP)
 
-IterationLogic::IterationLogic(Bench const& bench)
-    : mPimpl(new Impl(bench)) {}
+IterationLogic::IterationLogic(Bench& bench)
+    : mPimpl(new Impl(bench, bench.sharedConfig())) {}
 
 IterationLogic::~IterationLogic() {
     delete mPimpl;
@@ -3471,12 +6351,29 @@ uint64_t IterationLogic::numIters() const noexcept {
     return mPimpl->mNumIters;
 }
 
-void IterationLogic::add(std::chrono::nanoseconds elapsed, PerformanceCounters const& pc) noexcept {
-    mPimpl->add(elapsed, pc);
+void IterationLogic::add(Clock::time_point before, Clock::time_point after, PerformanceCounters const& pc) noexcept {
+    mPimpl->add(before, after, pc);
+}
+
+void IterationLogic::writeResultFiles() {
+    mPimpl->saveBaselineEntry();
+    mPimpl->saveCheckpoint();
+    // the interrupted run that saved a restored result has written it to these already
+    if (!mPimpl->mIsRestored) {
+        mPimpl->appendJsonLine();
+        mPimpl->appendTrace();
+    }
 }
 
-void IterationLogic::moveResultTo(std::vector<Result>& results) noexcept {
-    results.emplace_back(std::move(mPimpl->mResult));
+void IterationLogic::moveResultTo(Bench& bench) {
+    if (mPimpl->mIsCompared) {
+        bench.mBaselineComparisons.push_back(mPimpl->mBaselineComparison);
+    }
+    if (0 != bench.progress().count() && !mPimpl->mIsRestored) {
+        bench.mProgressElapsed += Clock::now() - mPimpl->mProgressBegin;
+        ++bench.mProgressBenchmarks;
+    }
+    bench.mResults.emplace_back(std::move(mPimpl->mResult));
 }
 
 // The counter arithmetic, deliberately outside the PERF_COUNTERS guard - see the declarations.
@@ -3601,64 +6498,39 @@ public:
     bool monitor(perf_sw_ids swId, Target target);
     bool monitor(perf_hw_id hwId, Target target);
 
-    ANKERL_NANOBENCH(NODISCARD) bool hasError() const noexcept {
-        return mHasError;
-    }
+    // Whether the event writing to `targetValue` was opened, and its group has neither failed nor been
+    // left unscheduled by the kernel since. Only meaningful after calibrate().
+    ANKERL_NANOBENCH(NODISCARD) bool isLive(uint64_t const* targetValue) const noexcept;
+
+    // Splits every group of several events that the kernel never once scheduled into groups of one
+    // event each. A group is scheduled as a whole or not at all, so a single event the PMU cannot
+    // place - e.g. a VM that virtualizes two of the four hardware counters - would otherwise take all
+    // the others down with it. Returns true when something was split; calibrate() again afterwards.
+    bool splitUnscheduledGroups();
 
     // Just reading data is faster than enable & disabling.
     // we subtract data ourselves.
     inline void beginMeasure() {
-        if (mHasError) {
-            return;
-        }
-
-        mHasError = -1 == perfIoctl(mFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
-        if (mHasError) {
-            return;
+        for (auto& group : mGroups) {
+            group.beginMeasure();
         }
-
-        mHasError = -1 == perfIoctl(mFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
     }
 
-    inline void endMeasure() {
-        if (mHasError) {
-            return;
-        }
-
-        mHasError = (-1 == perfIoctl(mFd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP));
-        if (mHasError) {
-            return;
-        }
-
-        auto const numBytes = sizeof(uint64_t) * mCounters.size();
-        auto ret = read(mFd, mCounters.data(), numBytes);
-        mHasError = ret != static_cast<ssize_t>(numBytes);
-        if (!mHasError) {
-            scaleCounters();
+    // In reverse, so the measurement of each group is nested inside that of the groups started before it.
+    // True when a group failed since the last time, and with it the events in it.
+    inline bool endMeasure() {
+        size_t numFailed = 0;
+        for (auto it = mGroups.rbegin(); it != mGroups.rend(); ++it) {
+            it->endMeasure();
+            numFailed += it->mHasError ? 1U : 0U;
         }
+        auto const hasFailed = numFailed != mNumFailed;
+        mNumFailed = numFailed;
+        return hasFailed;
     }
 
     void updateResults(uint64_t numIters);
 
-    // Compensates the counters that were just read for multiplexing.
-    //
-    // When more events are monitored than the hardware can count at the same time, the kernel time-shares the counters
-    // between them. An event is then only active for a fraction of the measurement, and the value read back is just what
-    // happened while it was active. Scaling it up by enabled/running extrapolates to the whole measurement, which is
-    // exactly what `perf stat` does. Without this, cycles/instructions/branches are silently underreported - e.g. when
-    // the NMI watchdog occupies one of the counters, or in a VM that exposes a restricted PMU.
-    inline void scaleCounters() noexcept {
-        auto const enabled = timeEnabled() - mTotalTimeEnabledNanos;
-        auto const running = timeRunning() - mTotalTimeRunningNanos;
-        mTotalTimeEnabledNanos = timeEnabled();
-        mTotalTimeRunningNanos = timeRunning();
-
-        for (uint64_t i = 0; i < numEvents(); ++i) {
-            auto const idx = perfValueIndex(i);
-            mCounters[idx] = scaleMultiplexed(mCounters[idx], enabled, running);
-        }
-    }
-
     ANKERL_NANOBENCH_NO_SANITIZE("integer", "undefined")
     static inline uint32_t mix(uint32_t x) noexcept {
         x ^= x << 13U;
@@ -3672,27 +6544,37 @@ public:
     void calibrate(Op&& op) {
         // clear current calibration data, so a measurement that fails below subtracts nothing rather
         // than something stale
-        for (auto& v : mCalibratedOverhead) {
-            v = UINT64_C(0);
+        for (auto& group : mGroups) {
+            for (auto& v : group.mCalibratedOverhead) {
+                v = UINT64_C(0);
+            }
         }
 
         // the new data is a minimum over 100 runs, so it starts at the maximum
-        std::vector<uint64_t> newCalibration(mCalibratedOverhead.size(), (std::numeric_limits<uint64_t>::max)());
+        std::vector<std::vector<uint64_t>> newCalibration;
+        for (auto const& group : mGroups) {
+            newCalibration.emplace_back(group.mCalibratedOverhead.size(), (std::numeric_limits<uint64_t>::max)());
+        }
         for (size_t iter = 0; iter < 100; ++iter) {
             beginMeasure();
             op();
             endMeasure();
-            if (mHasError) {
-                return;
+            for (size_t g = 0; g < mGroups.size(); ++g) {
+                auto const& counters = mGroups[g].mCounters;
+                auto& calibration = newCalibration[g];
+                for (size_t i = 0; i < calibration.size(); ++i) {
+                    calibration[i] = (std::min)(calibration[i], counters[i]);
+                }
             }
+        }
 
-            for (size_t i = 0; i < newCalibration.size(); ++i) {
-                newCalibration[i] = (std::min)(newCalibration[i], mCounters[i]);
+        // a group that failed along the way keeps the zeros: it does not report anything anyways
+        for (size_t g = 0; g < mGroups.size(); ++g) {
+            if (!mGroups[g].mHasError) {
+                mGroups[g].mCalibratedOverhead = std::move(newCalibration[g]);
             }
         }
 
-        mCalibratedOverhead = std::move(newCalibration);
-
         {
             // calibrate loop overhead. For branches & instructions this makes sense, not so much for everything else like cycles.
             // marsaglia's xorshift: mov, sal/shr, xor. Times 3.
@@ -3708,7 +6590,10 @@ public:
             }
             endMeasure();
             detail::doNotOptimizeAway(x);
-            auto measure1 = mCounters;
+            std::vector<std::vector<uint64_t>> measure1;
+            for (auto const& group : mGroups) {
+                measure1.push_back(group.mCounters);
+            }
 
             n = numIters;
             beginMeasure();
@@ -3719,91 +6604,138 @@ public:
             }
             endMeasure();
             detail::doNotOptimizeAway(x);
-            auto measure2 = mCounters;
 
-            for (size_t i = 0; i < mCounters.size(); ++i) {
-                mLoopOverhead[i] = loopOverheadPerIteration(measure1[i], measure2[i], mCalibratedOverhead[i], numIters);
+            for (size_t g = 0; g < mGroups.size(); ++g) {
+                auto& group = mGroups[g];
+                if (group.mHasError) {
+                    continue;
+                }
+                for (size_t i = 0; i < group.mCounters.size(); ++i) {
+                    group.mLoopOverhead[i] =
+                        loopOverheadPerIteration(measure1[g][i], group.mCounters[i], group.mCalibratedOverhead[i], numIters);
+                }
             }
         }
     }
 
 private:
-    bool monitor(uint32_t type, uint64_t eventid, Target target);
+    // One event as it was asked for, so that it can be opened again in a group of its own.
+    struct Event {
+        uint32_t type;
+        uint64_t eventid;
+        Target target;
+    };
 
-    // The three header words of the last read, by name rather than by index.
-    ANKERL_NANOBENCH(NODISCARD) uint64_t numEvents() const noexcept {
-        return mCounters[0];
-    }
-    ANKERL_NANOBENCH(NODISCARD) uint64_t timeEnabled() const noexcept {
-        return mCounters[1];
-    }
-    ANKERL_NANOBENCH(NODISCARD) uint64_t timeRunning() const noexcept {
-        return mCounters[2];
-    }
+    // Events that the kernel enables, disables and reads together through their leader's fd. Hardware
+    // and software events never share a group: the PMU refusing one hardware event must not cost the
+    // page faults and context switches, which the kernel counts itself and can always schedule.
+    //
+    // Plain data without a destructor, so the vector holding the groups can move them around freely;
+    // LinuxPerformanceCounters closes the fds.
+    struct Group {
+        explicit Group(uint32_t type)
+            : mType(type) {}
 
-    std::map<uint64_t, Target> mIdToTarget{};
+        bool add(Event const& event);
+        void close() noexcept;
 
-    // no events monitored yet, so just the read_format header
-    std::vector<uint64_t> mCounters = std::vector<uint64_t>(perfReadFormatSize(0));
-    std::vector<uint64_t> mCalibratedOverhead = std::vector<uint64_t>(perfReadFormatSize(0));
-    std::vector<uint64_t> mLoopOverhead = std::vector<uint64_t>(perfReadFormatSize(0));
+        inline void beginMeasure() {
+            if (mHasError) {
+                return;
+            }
 
-    // PERF_EVENT_IOC_RESET resets the counters, but not time_enabled/time_running: those keep accumulating over the
-    // whole lifetime of the event. So the times of a single measurement are the difference to the previous read.
-    uint64_t mTotalTimeEnabledNanos = 0;
-    uint64_t mTotalTimeRunningNanos = 0;
-    int mFd = -1;
-    bool mHasError = false;
-};
-ANKERL_NANOBENCH(IGNORE_PADDED_POP)
-
-LinuxPerformanceCounters::~LinuxPerformanceCounters() {
-    if (-1 != mFd) {
-        close(mFd);
-    }
-}
+            mHasError = -1 == perfIoctl(mFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            if (mHasError) {
+                return;
+            }
 
-bool LinuxPerformanceCounters::monitor(perf_sw_ids swId, LinuxPerformanceCounters::Target target) {
-    return monitor(PERF_TYPE_SOFTWARE, swId, target);
-}
+            mHasError = -1 == perfIoctl(mFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
 
-bool LinuxPerformanceCounters::monitor(perf_hw_id hwId, LinuxPerformanceCounters::Target target) {
-    return monitor(PERF_TYPE_HARDWARE, hwId, target);
-}
+        inline void endMeasure() {
+            if (mHasError) {
+                return;
+            }
 
-// overflow is ok, it's checked
-ANKERL_NANOBENCH_NO_SANITIZE("integer", "undefined")
-void LinuxPerformanceCounters::updateResults(uint64_t numIters) {
-    // clear old data
-    for (auto& id_value : mIdToTarget) {
-        *id_value.second.targetValue = UINT64_C(0);
-    }
+            mHasError = (-1 == perfIoctl(mFd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP));
+            if (mHasError) {
+                return;
+            }
 
-    if (mHasError) {
-        return;
-    }
+            auto const numBytes = sizeof(uint64_t) * mCounters.size();
+            auto ret = read(mFd, mCounters.data(), numBytes);
+            mHasError = ret != static_cast<ssize_t>(numBytes);
+            if (!mHasError) {
+                scaleCounters();
+            }
+        }
 
-    // mCounters has already been compensated for multiplexing in endMeasure(), and so has mCalibratedOverhead
-    for (uint64_t i = 0; i < numEvents(); ++i) {
-        auto idx = perfValueIndex(i);
-        auto id = mCounters[idx + 1U];
+        // Compensates the counters that were just read for multiplexing.
+        //
+        // When more events are monitored than the hardware can count at the same time, the kernel time-shares the counters
+        // between them. An event is then only active for a fraction of the measurement, and the value read back is just what
+        // happened while it was active. Scaling it up by enabled/running extrapolates to the whole measurement, which is
+        // exactly what `perf stat` does. Without this, cycles/instructions/branches are silently underreported - e.g. when
+        // the NMI watchdog occupies one of the counters, or in a VM that exposes a restricted PMU.
+        inline void scaleCounters() noexcept {
+            auto const enabled = timeEnabled() - mTotalTimeEnabledNanos;
+            auto const running = timeRunning() - mTotalTimeRunningNanos;
+            mTotalTimeEnabledNanos = timeEnabled();
+            mTotalTimeRunningNanos = timeRunning();
+
+            for (uint64_t i = 0; i < numEvents(); ++i) {
+                auto const idx = perfValueIndex(i);
+                mCounters[idx] = scaleMultiplexed(mCounters[idx], enabled, running);
+            }
+        }
 
-        auto it = mIdToTarget.find(id);
-        if (it != mIdToTarget.end()) {
-            auto& tgt = it->second;
-            // a correction the target did not ask for is applied as a correction of zero
-            *tgt.targetValue = correctOverhead(mCounters[idx], tgt.correctMeasuringOverhead ? mCalibratedOverhead[idx] : UINT64_C(0),
-                                               tgt.correctLoopOverhead ? mLoopOverhead[idx] : UINT64_C(0), numIters);
+        // The three header words of the last read, by name rather than by index.
+        ANKERL_NANOBENCH(NODISCARD) uint64_t numEvents() const noexcept {
+            return mCounters[0];
+        }
+        ANKERL_NANOBENCH(NODISCARD) uint64_t timeEnabled() const noexcept {
+            return mCounters[1];
+        }
+        ANKERL_NANOBENCH(NODISCARD) uint64_t timeRunning() const noexcept {
+            return mCounters[2];
         }
-    }
-}
 
-bool LinuxPerformanceCounters::monitor(uint32_t type, uint64_t eventid, Target target) {
-    *target.targetValue = (std::numeric_limits<uint64_t>::max)();
-    if (mHasError) {
-        return false;
-    }
+        // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+        std::vector<Event> mEvents{};
+        // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+        std::map<uint64_t, Target> mIdToTarget{};
+
+        // no events monitored yet, so just the read_format header
+        // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+        std::vector<uint64_t> mCounters = std::vector<uint64_t>(perfReadFormatSize(0));
+        // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+        std::vector<uint64_t> mCalibratedOverhead = std::vector<uint64_t>(perfReadFormatSize(0));
+        // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+        std::vector<uint64_t> mLoopOverhead = std::vector<uint64_t>(perfReadFormatSize(0));
+
+        // the members' fds, which the leader's fd does not close
+        // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+        std::vector<int> mMemberFds{};
+
+        // PERF_EVENT_IOC_RESET resets the counters, but not time_enabled/time_running: those keep accumulating over the
+        // whole lifetime of the event. So the times of a single measurement are the difference to the previous read.
+        uint64_t mTotalTimeEnabledNanos = 0; // NOLINT(misc-non-private-member-variables-in-classes)
+        uint64_t mTotalTimeRunningNanos = 0; // NOLINT(misc-non-private-member-variables-in-classes)
+        uint32_t mType;                      // NOLINT(misc-non-private-member-variables-in-classes)
+        int mFd = -1;                        // NOLINT(misc-non-private-member-variables-in-classes)
+        bool mHasError = false;              // NOLINT(misc-non-private-member-variables-in-classes)
+    };
+
+    bool monitor(uint32_t type, uint64_t eventid, Target target);
 
+    std::vector<Group> mGroups{};
+    // how many of them had failed at the last endMeasure()
+    size_t mNumFailed = 0;
+};
+ANKERL_NANOBENCH(IGNORE_PADDED_POP)
+
+// Opens an event for the current process. With `groupFd` -1 it becomes the leader of a new group.
+static int perfEventOpen(uint32_t type, uint64_t eventid, int groupFd) {
     auto pea = perf_event_attr();
     std::memset(&pea, 0, sizeof(perf_event_attr));
     pea.type = type;
@@ -3825,36 +6757,179 @@ bool LinuxPerformanceCounters::monitor(uint32_t type, uint64_t eventid, Target t
 #        endif
 
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
-    auto fd = static_cast<int>(syscall(__NR_perf_event_open, &pea, pid, cpu, mFd, flags));
+    return static_cast<int>(syscall(__NR_perf_event_open, &pea, pid, cpu, groupFd, flags));
+}
+
+// Whether the event can be counted at all: opened on its own, reset, enabled, disabled and read once.
+// Some hypervisors accept perf_event_open for an event they then fail to count, and such an event
+// must not join a group, where its first failing ioctl would take every other event down with it.
+static bool perfEventWorks(uint32_t type, uint64_t eventid) {
+    auto fd = perfEventOpen(type, eventid, -1);
     if (-1 == fd) {
         return false;
     }
-    if (-1 == mFd) {
-        // first call: set to fd, and use this from now on
-        mFd = fd;
+    std::vector<uint64_t> counters(perfReadFormatSize(1));
+    auto const numBytes = sizeof(uint64_t) * counters.size();
+    auto works = -1 != perfIoctl(fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP) &&
+                 -1 != perfIoctl(fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) &&
+                 -1 != perfIoctl(fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP) &&
+                 read(fd, counters.data(), numBytes) == static_cast<ssize_t>(numBytes);
+    close(fd);
+    return works;
+}
+
+bool LinuxPerformanceCounters::Group::add(Event const& event) {
+    auto fd = perfEventOpen(event.type, event.eventid, mFd);
+    if (-1 == fd) {
+        return false;
     }
     uint64_t id = 0;
     if (-1 == perfIoctl(fd, PERF_EVENT_IOC_ID, &id)) {
         // couldn't get id
+        ::close(fd);
         return false;
     }
+    if (-1 == mFd) {
+        // first event: it leads the group from now on
+        mFd = fd;
+    } else {
+        mMemberFds.push_back(fd);
+    }
 
     // insert into map, rely on the fact that map's references are constant.
-    mIdToTarget.emplace(id, target);
+    mEvents.push_back(event);
+    mIdToTarget.emplace(id, event.target);
 
     // prepare readformat with the correct size (after the insert)
     auto size = perfReadFormatSize(mIdToTarget.size());
     mCounters.resize(size);
     mCalibratedOverhead.resize(size);
     mLoopOverhead.resize(size);
-
     return true;
 }
 
+void LinuxPerformanceCounters::Group::close() noexcept {
+    for (auto fd : mMemberFds) {
+        ::close(fd);
+    }
+    mMemberFds.clear();
+    if (-1 != mFd) {
+        ::close(mFd);
+        mFd = -1;
+    }
+}
+
+LinuxPerformanceCounters::~LinuxPerformanceCounters() {
+    for (auto& group : mGroups) {
+        group.close();
+    }
+}
+
+bool LinuxPerformanceCounters::monitor(perf_sw_ids swId, LinuxPerformanceCounters::Target target) {
+    return monitor(PERF_TYPE_SOFTWARE, swId, target);
+}
+
+bool LinuxPerformanceCounters::monitor(perf_hw_id hwId, LinuxPerformanceCounters::Target target) {
+    return monitor(PERF_TYPE_HARDWARE, hwId, target);
+}
+
+bool LinuxPerformanceCounters::isLive(uint64_t const* targetValue) const noexcept {
+    for (auto const& group : mGroups) {
+        for (auto const& event : group.mEvents) {
+            if (event.target.targetValue == targetValue) {
+                // a group the kernel never scheduled reads back zeros, which are not a measurement
+                return !group.mHasError && group.mTotalTimeRunningNanos > 0;
+            }
+        }
+    }
+    return false;
+}
+
+bool LinuxPerformanceCounters::splitUnscheduledGroups() {
+    std::vector<Group> groups;
+    bool hasSplit = false;
+    for (auto& group : mGroups) {
+        if (group.mEvents.size() < 2 || group.mHasError || group.mTotalTimeRunningNanos > 0) {
+            groups.push_back(std::move(group));
+            continue;
+        }
+        hasSplit = true;
+        group.close();
+        for (auto const& event : group.mEvents) {
+            Group single(event.type);
+            if (single.add(event)) {
+                groups.push_back(std::move(single));
+            }
+        }
+    }
+    mGroups = std::move(groups);
+    return hasSplit;
+}
+
+// overflow is ok, it's checked
+ANKERL_NANOBENCH_NO_SANITIZE("integer", "undefined")
+void LinuxPerformanceCounters::updateResults(uint64_t numIters) {
+    for (auto const& group : mGroups) {
+        // clear old data
+        for (auto const& id_value : group.mIdToTarget) {
+            *id_value.second.targetValue = UINT64_C(0);
+        }
+
+        // a group that failed reports zeros, but only for its own events
+        if (group.mHasError) {
+            continue;
+        }
+
+        // mCounters has already been compensated for multiplexing in endMeasure(), and so has mCalibratedOverhead
+        for (uint64_t i = 0; i < group.numEvents(); ++i) {
+            auto idx = perfValueIndex(i);
+            auto id = group.mCounters[idx + 1U];
+
+            auto it = group.mIdToTarget.find(id);
+            if (it != group.mIdToTarget.end()) {
+                auto const& tgt = it->second;
+                // a correction the target did not ask for is applied as a correction of zero
+                *tgt.targetValue =
+                    correctOverhead(group.mCounters[idx], tgt.correctMeasuringOverhead ? group.mCalibratedOverhead[idx] : UINT64_C(0),
+                                    tgt.correctLoopOverhead ? group.mLoopOverhead[idx] : UINT64_C(0), numIters);
+            }
+        }
+    }
+}
+
+bool LinuxPerformanceCounters::monitor(uint32_t type, uint64_t eventid, Target target) {
+    *target.targetValue = (std::numeric_limits<uint64_t>::max)();
+
+    // A second attempt, because the probe can fail transiently: e.g. with EBUSY while another
+    // process briefly holds the counter exclusively.
+    if (!perfEventWorks(type, eventid) && !perfEventWorks(type, eventid)) {
+        return false;
+    }
+
+    Event const event{type, eventid, target};
+    for (auto& group : mGroups) {
+        if (group.mType == type) {
+            if (group.add(event)) {
+                return true;
+            }
+            // works on its own, but not together with the others: it gets a group of its own
+            break;
+        }
+    }
+
+    mGroups.emplace_back(type);
+    if (mGroups.back().add(event)) {
+        return true;
+    }
+    mGroups.pop_back();
+    return false;
+}
+
 PerformanceCounters::PerformanceCounters()
     : mPc(new LinuxPerformanceCounters())
     , mVal()
-    , mHas() {
+    , mHas()
+    , mOpened() {
 
     // HW events
     mHas.cpuCycles = mPc->monitor(PERF_COUNT_HW_REF_CPU_CYCLES, LinuxPerformanceCounters::Target(&mVal.cpuCycles, true, false));
@@ -3872,17 +6947,27 @@ PerformanceCounters::PerformanceCounters()
     mHas.contextSwitches =
         mPc->monitor(PERF_COUNT_SW_CONTEXT_SWITCHES, LinuxPerformanceCounters::Target(&mVal.contextSwitches, true, false));
 
-    mPc->calibrate([] {
+    mOpened = mHas;
+
+    auto const calibrationOp = [] {
         auto before = ankerl::nanobench::Clock::now();
         auto after = ankerl::nanobench::Clock::now();
         (void)before;
         (void)after;
-    });
-
-    if (mPc->hasError()) {
-        // something failed, don't monitor anything.
-        mHas = PerfCountSet<bool>{};
+    };
+    mPc->calibrate(calibrationOp);
+    if (mPc->splitUnscheduledGroups()) {
+        mPc->calibrate(calibrationOp);
     }
+
+    // Each counter that failed is dropped on its own; the others keep their columns.
+    dropFailedCounters();
+}
+
+void PerformanceCounters::dropFailedCounters() {
+    mHas = liveCounters(mHas, mVal, [this](uint64_t const* targetValue) {
+        return mPc->isLive(targetValue);
+    });
 }
 
 PerformanceCounters::~PerformanceCounters() {
@@ -3895,7 +6980,9 @@ void PerformanceCounters::beginMeasure() {
 }
 
 void PerformanceCounters::endMeasure() {
-    mPc->endMeasure();
+    if (mPc->endMeasure()) {
+        dropFailedCounters();
+    }
 }
 
 void PerformanceCounters::updateResults(uint64_t numIters) {
@@ -3918,6 +7005,9 @@ ANKERL_NANOBENCH(NODISCARD) PerfCountSet<uint64_t> const& PerformanceCounters::v
 ANKERL_NANOBENCH(NODISCARD) PerfCountSet<bool> const& PerformanceCounters::has() const noexcept {
     return mHas;
 }
+ANKERL_NANOBENCH(NODISCARD) PerfCountSet<bool> const& PerformanceCounters::opened() const noexcept {
+    return mOpened;
+}
 
 // formatting utilities
 namespace fmt {
@@ -4103,63 +7193,208 @@ inline constexpr typename std::underlying_type<T>::type u(T val) noexcept {
 }
 } // namespace detail
 
+namespace detail {
+
+MeasurementRange::MeasurementRange(double const* first, size_t size) noexcept
+    : mFirst(first)
+    , mSize(size) {}
+
+double const* MeasurementRange::begin() const noexcept {
+    return mFirst;
+}
+
+double const* MeasurementRange::end() const noexcept {
+    return mFirst + mSize;
+}
+
+size_t MeasurementRange::size() const noexcept {
+    return mSize;
+}
+
+bool MeasurementRange::empty() const noexcept {
+    return 0U == mSize;
+}
+
+} // namespace detail
+
 // Result returned after a benchmark has finished. Can be used as a baseline for relative().
 Result::Result(Config benchmarkConfig)
-    : mConfig(std::move(benchmarkConfig))
-    // One slot per measure, plus one for _size itself. Result::fromString() returns _size for a name
-    // it does not know, so it reaches these accessors whenever a caller resolves a measure from
-    // user input - and reading one slot past the end of the storage is not the answer to a typo.
-    // With the extra slot it is a permanently empty measurement list, which reads as "nothing was
-    // measured": 0.0 from the statistics and false from has(), the same thing the mustache renderer
-    // already does with a measure it does not recognise.
-    , mNameToMeasurements{detail::u(Result::Measure::_size) + 1U} {}
+    : Result(std::make_shared<Config const>(std::move(benchmarkConfig))) {}
+
+Result::Result(std::shared_ptr<Config const> benchmarkConfig)
+    : mConfig(std::move(benchmarkConfig)) {
+    if (mConfig->mStreaming) {
+        // One slot per measure, plus one for _size itself. Result::fromString() returns _size for a
+        // name it does not know, so it reaches the accessors whenever a caller resolves a measure from
+        // user input - and reading one slot past the end of the storage is not the answer to a typo.
+        // With the extra slot it is a measure that was never recorded: 0.0 from the statistics and
+        // false from has(), the same thing measurements() answers for it when not streaming.
+        auto const numMeasures = detail::u(Result::Measure::_size) + 1U;
+        mStreamed.resize(numMeasures);
+        mStreamedProducts.resize(numMeasures * numMeasures);
+    }
+}
 
 void Result::add(Clock::duration totalElapsed, uint64_t iters, detail::PerformanceCounters const& pc) {
     using detail::d;
     using detail::u;
 
+    // this epoch's value of each measure it has
+    std::array<double, u(Result::Measure::_size)> values{};
+    std::array<bool, u(Result::Measure::_size)> has{};
+    auto const set = [&](Result::Measure m, double value) {
+        values[u(m)] = value;
+        has[u(m)] = true;
+    };
+
     double const dIters = d(iters);
-    mNameToMeasurements[u(Result::Measure::iterations)].push_back(dIters);
+    set(Result::Measure::iterations, dIters);
 
-    mNameToMeasurements[u(Result::Measure::elapsed)].push_back(d(totalElapsed) / dIters);
+    set(Result::Measure::elapsed, d(totalElapsed) / dIters);
     if (pc.has().pageFaults) {
-        mNameToMeasurements[u(Result::Measure::pagefaults)].push_back(d(pc.val().pageFaults) / dIters);
+        set(Result::Measure::pagefaults, d(pc.val().pageFaults) / dIters);
     }
     if (pc.has().cpuCycles) {
-        mNameToMeasurements[u(Result::Measure::cpucycles)].push_back(d(pc.val().cpuCycles) / dIters);
+        set(Result::Measure::cpucycles, d(pc.val().cpuCycles) / dIters);
     }
     if (pc.has().contextSwitches) {
-        mNameToMeasurements[u(Result::Measure::contextswitches)].push_back(d(pc.val().contextSwitches) / dIters);
+        set(Result::Measure::contextswitches, d(pc.val().contextSwitches) / dIters);
     }
     if (pc.has().instructions) {
-        mNameToMeasurements[u(Result::Measure::instructions)].push_back(d(pc.val().instructions) / dIters);
+        set(Result::Measure::instructions, d(pc.val().instructions) / dIters);
     }
     if (pc.has().branchInstructions) {
         double const branchInstructions = d(detail::correctBranchInstructions(pc.val().branchInstructions, iters));
-        mNameToMeasurements[u(Result::Measure::branchinstructions)].push_back(branchInstructions / dIters);
+        set(Result::Measure::branchinstructions, branchInstructions / dIters);
 
         if (pc.has().branchMisses) {
             auto const branchMisses = detail::correctBranchMisses(pc.val().branchMisses, branchInstructions);
-            mNameToMeasurements[u(Result::Measure::branchmisses)].push_back(branchMisses / dIters);
+            set(Result::Measure::branchmisses, branchMisses / dIters);
+        }
+    }
+
+    if (!mConfig->mStreaming) {
+        uint32_t present = 0;
+        for (size_t m = 0; m < values.size(); ++m) {
+            if (has[m]) {
+                present |= UINT32_C(1) << m;
+            }
+        }
+        if (0U == mNumEpochs) {
+            storeMeasures(present);
+        }
+        if (mNumEpochs == mCapacity) {
+            // the epochs asked for at once, and doubling from there for the remeasured ones
+            reserveEpochs((std::max)((std::max)(mConfig->mNumEpochs, 2U * mCapacity), size_t{1}));
+        }
+        // a measure the first epoch did not have is not in every epoch, so it has no room either
+        mHas = 0U == mNumEpochs ? present : (mHas & present);
+        for (size_t m = 0; m < values.size(); ++m) {
+            if (0U != (mHas & (UINT32_C(1) << m))) {
+                mMeasurements[slotOf(m) * mCapacity + mNumEpochs] = values[m];
+            }
+        }
+        ++mNumEpochs;
+        return;
+    }
+
+    for (size_t m = 0; m < values.size(); ++m) {
+        if (has[m]) {
+            record(static_cast<Result::Measure>(m), values[m]);
+        }
+    }
+
+    // every pair, so that sumProduct() works for any two measures without their epochs
+    auto const stride = mStreamed.size();
+    for (size_t m1 = 0; m1 < values.size(); ++m1) {
+        for (size_t m2 = 0; m2 < values.size(); ++m2) {
+            if (has[m1] && has[m2]) {
+                mStreamedProducts[m1 * stride + m2] += values[m1] * values[m2];
+            }
+        }
+    }
+}
+
+void Result::reserveEpochs(size_t numEpochs) {
+    if (numEpochs <= mCapacity) {
+        return;
+    }
+    auto const numSlots = slotOf(detail::u(Result::Measure::_size));
+    std::vector<double> grown(numSlots * numEpochs);
+    for (size_t slot = 0; slot < numSlots; ++slot) {
+        auto const* const from = mMeasurements.data() + slot * mCapacity;
+        std::copy(from, from + mNumEpochs, grown.data() + slot * numEpochs);
+    }
+    mMeasurements.swap(grown);
+    mCapacity = numEpochs;
+}
+
+void Result::storeMeasures(uint32_t measures) {
+    if (measures == mStored) {
+        return;
+    }
+    // a measure stored from now on has no value in the epochs already there, which NaN says
+    auto const slotIn = [](uint32_t stored, size_t idx) {
+        size_t slot = 0;
+        for (auto before = stored & ((UINT32_C(1) << idx) - 1U); 0U != before; before &= before - 1U) {
+            ++slot;
+        }
+        return slot;
+    };
+    std::vector<double> relaid(slotIn(measures, detail::u(Measure::_size)) * mCapacity, std::numeric_limits<double>::quiet_NaN());
+    for (size_t m = 0; m < detail::u(Measure::_size); ++m) {
+        auto const bit = UINT32_C(1) << m;
+        if (0U != (measures & bit) && 0U != (mStored & bit)) {
+            auto const* const from = mMeasurements.data() + slotIn(mStored, m) * mCapacity;
+            std::copy(from, from + mNumEpochs, relaid.data() + slotIn(measures, m) * mCapacity);
         }
     }
+    mMeasurements.swap(relaid);
+    mStored = measures;
+}
+
+size_t Result::slotOf(size_t idx) const noexcept {
+    size_t slot = 0;
+    for (auto before = mStored & ((UINT32_C(1) << idx) - 1U); 0U != before; before &= before - 1U) {
+        ++slot;
+    }
+    return slot;
+}
+
+void Result::record(Measure m, double value) {
+    auto& streamed = mStreamed[detail::u(m)];
+    streamed.stats.add(value);
+    streamed.median.add(value);
+
+    // The absolute percentage error against the median as estimated so far, which is the MdAPE's
+    // definition with the final median replaced by the current one. A value of 0 has no finite
+    // error, and an infinity would wreck the estimator's arithmetic, so it is left out.
+    if (value > 0.0) {
+        streamed.absolutePercentError.add(std::abs((value - streamed.median.value()) / value));
+    }
 }
 
 Config const& Result::config() const noexcept {
-    return mConfig;
+    return *mConfig;
 }
 
+bool Result::streaming() const noexcept {
+    return mConfig->mStreaming;
+}
+
+// Reorders data. Selects rather than sorts, since only the middle is needed: nth_element puts the
+// upper middle value in place and everything smaller in front of it, where the lower middle value of
+// an even count is the largest.
 inline double calcMedian(std::vector<double>& data) {
     if (data.empty()) {
         return 0.0;
     }
-    std::sort(data.begin(), data.end());
-
-    auto midIdx = data.size() / 2U;
+    auto const mid = data.begin() + static_cast<std::ptrdiff_t>(data.size() / 2U);
+    std::nth_element(data.begin(), mid, data.end());
     if (1U == (data.size() & 1U)) {
-        return data[midIdx];
+        return *mid;
     }
-    return (data[midIdx - 1U] + data[midIdx]) / 2U;
+    return (*std::max_element(data.begin(), mid) + *mid) / 2U;
 }
 
 namespace detail {
@@ -4179,11 +7414,18 @@ std::vector<double> pairedLogRatios(std::vector<double> const& a, std::vector<do
 }
 
 std::vector<double> pairedLogRatios(Result const& a, Result const& b) {
-    auto const perRound = [](Result const& result) {
+    return pairedLogRatios(a, b, Result::Measure::elapsed);
+}
+
+std::vector<double> pairedLogRatios(Result const& a, Result const& b, Result::Measure m) {
+    if (!a.has(m) || !b.has(m)) {
+        return {};
+    }
+    auto const perRound = [m](Result const& result) {
         std::vector<double> values;
         values.reserve(result.size());
         for (size_t r = 0; r < result.size(); ++r) {
-            values.push_back(result.get(r, Result::Measure::elapsed));
+            values.push_back(result.get(r, m));
         }
         return values;
     };
@@ -4251,531 +7493,3452 @@ std::pair<double, double> medianInterval(std::vector<double> values, double conf
     return {values[indices.first], values[indices.second]};
 }
 
-} // namespace detail
+bool isCompareNarrowEnough(std::vector<Result> const& results, double confidence, double relativeHalfWidth) {
+    auto const logHalfWidth = std::log1p(relativeHalfWidth);
+    for (size_t i = 1; i < results.size(); ++i) {
+        if (results[i].size() < results[0].size()) {
+            // dropped by racing, so no more rounds are going to narrow it
+            continue;
+        }
+        auto const logRatios = pairedLogRatios(results[0], results[i]);
+        auto const median = medianOf(logRatios);
+        auto const interval = medianInterval(logRatios, confidence);
+        if (median - interval.first > logHalfWidth || interval.second - median > logHalfWidth) {
+            return false;
+        }
+    }
+    return true;
+}
 
-CompareResult::Entry::Entry(std::string entryName, Result entryResult, double entryRelative, double entryRelativeLow,
-                            double entryRelativeHigh, size_t entryTiedRounds) noexcept
-    : name(std::move(entryName))
-    , result(std::move(entryResult))
-    , relative(entryRelative)
-    , relativeLow(entryRelativeLow)
-    , relativeHigh(entryRelativeHigh)
-    , tiedRounds(entryTiedRounds) {}
+Equivalence equivalenceOf(std::pair<double, double> const& logInterval, double margin) {
+    auto const logMargin = std::log1p(margin);
+    if (logInterval.first >= -logMargin && logInterval.second <= logMargin) {
+        return Equivalence::equivalent;
+    }
+    if (logInterval.first > logMargin || logInterval.second < -logMargin) {
+        return Equivalence::notEquivalent;
+    }
+    return Equivalence::inconclusive;
+}
 
-CompareResult::CompareResult(std::vector<Entry> entries, size_t numRounds)
-    : mEntries(std::move(entries))
-    , mRounds(numRounds) {}
+bool isCompareEquivalenceDecided(std::vector<Result> const& results, double confidence, double margin) {
+    for (size_t i = 1; i < results.size(); ++i) {
+        if (results[i].size() < results[0].size()) {
+            // dropped by racing, which is decided enough
+            continue;
+        }
+        auto const logRatios = pairedLogRatios(results[0], results[i]);
+        if (Equivalence::inconclusive == equivalenceOf(medianInterval(logRatios, confidence), margin)) {
+            return false;
+        }
+    }
+    return true;
+}
 
-size_t CompareResult::size() const noexcept {
-    return mEntries.size();
+void setUpErasedOp(ErasedOp const& op) {
+    if (nullptr != op.setUp) {
+        op.setUp(op.setupOp);
+    }
 }
 
-CompareResult::Entry const& CompareResult::operator[](size_t idx) const {
-    return mEntries.at(idx);
+double compareHalfWidth(CompareResult::Entry const& entry) {
+    if (!(entry.relative > 0.0) || !(entry.relativeLow > 0.0) || !(entry.relativeHigh > 0.0)) {
+        return 0.0;
+    }
+    auto const median = std::log(entry.relative);
+    return std::expm1((std::max)(median - std::log(entry.relativeLow), std::log(entry.relativeHigh) - median));
 }
 
-size_t CompareResult::rounds() const noexcept {
-    return mRounds;
+// The first line of a noise floor file, so that anything else is not mistaken for one.
+static char const* noiseFloorFileHeader() {
+    return "nanobench noise floor 1";
 }
 
-size_t CompareResult::comparisons() const noexcept {
-    return mEntries.empty() ? 0U : mEntries.size() - 1U;
+bool saveNoiseFloor(std::string const& path, NoiseFloor const& noiseFloor) {
+    std::ofstream out(path, std::ios::trunc);
+    out.imbue(std::locale::classic());
+    out.precision(std::numeric_limits<double>::max_digits10);
+    out << noiseFloorFileHeader() << '\n'
+        << noiseFloor.runs << ' ' << noiseFloor.rounds << ' ' << noiseFloor.falsePositives << ' ' << noiseFloor.halfWidth << '\n';
+    return static_cast<bool>(out);
 }
 
-bool CompareResult::isSignificant(size_t idx) const {
-    if (0U == idx) {
-        // the baseline is not compared against itself
+bool loadNoiseFloor(std::string const& path, NoiseFloor& noiseFloor) {
+    std::ifstream in(path);
+    in.imbue(std::locale::classic());
+    std::string line;
+    if (!std::getline(in, line) || line != noiseFloorFileHeader()) {
         return false;
     }
-    auto const& entry = mEntries.at(idx);
-    return entry.relativeLow > 1.0 || entry.relativeHigh < 1.0;
+    NoiseFloor loaded{};
+    if (!(in >> loaded.runs >> loaded.rounds >> loaded.falsePositives >> loaded.halfWidth) || 0U == loaded.runs) {
+        return false;
+    }
+    noiseFloor = loaded;
+    return true;
 }
 
-// The entry with the lowest median, ignoring index `skip` - pass size() to ignore nothing. Returns
-// size() when that leaves no entry at all. The winner and the runner-up are the same question asked
-// twice, and asking it twice is how the two answers come to disagree about ties.
-static size_t fastestExcept(CompareResult const& compareResult, size_t skip) {
-    size_t best = compareResult.size();
-    auto bestMedian = (std::numeric_limits<double>::max)();
-    for (size_t i = 0; i < compareResult.size(); ++i) {
-        if (i == skip) {
-            continue;
-        }
-        auto const median = compareResult[i].result.median(Result::Measure::elapsed);
-        if (median < bestMedian) {
-            bestMedian = median;
-            best = i;
-        }
+void writeNoiseFloorWarnings(std::ostream& os, NoiseFloor const& noiseFloor, double targetWidth) {
+    if (0U == noiseFloor.runs) {
+        return;
     }
-    return best;
-}
 
-size_t CompareResult::fastest() const {
-    auto const best = fastestExcept(*this, mEntries.size());
-    // with no entries there is nothing to pick, and 0 is what this has always answered
-    return best == mEntries.size() ? 0U : best;
-}
-
-// The table half of a comparison: an ordinary benchmark table with the ratio to the baseline and an
-// interval for it in front. Split out of operator<< because clang-tidy caps cognitive complexity at
-// 25 and the two halves together sat well over it.
-static void writeCompareTable(std::ostream& os, CompareResult const& compareResult) {
-    auto const& config = compareResult[0].result.config();
-    auto ratioText = [](double low, double high) {
-        std::ostringstream ss;
-        ss << detail::fmt::Number(1, 1, low * 100.0) << "% .. " << detail::fmt::Number(1, 1, high * 100.0) << "%";
-        return ss.str();
-    };
-
-    // The two extra columns are the comparison itself, so they are not hideable - without them this
-    // is just a table. Everything after them is the same set an ordinary table shows, performance
-    // counters included: a comparison collects them around every epoch either way, so leaving them
-    // out was paying for them and showing nothing.
-    auto columnsFor = [&](CompareResult::Entry const& entry, bool isBaseline) {
-        std::vector<detail::fmt::MarkDownColumn> columns;
-        columns.push_back(detail::relativeColumn(entry.relative * 100.0));
-        columns.emplace_back(22, "95% CI", isBaseline ? std::string() : ratioText(entry.relativeLow, entry.relativeHigh));
-        auto const measurements = detail::measurementColumns(entry.result.config(), entry.result);
-        columns.insert(columns.end(), measurements.begin(), measurements.end());
-        return columns;
-    };
-
-    // An ordinary table only reprints its header when the shape changes, and that state lives on the
-    // stream. A comparison table always prints its own header, so the remembered shape is now wrong:
-    // clear it, or the next run() on this stream matches against a header it never wrote and streams
-    // its rows straight under the comparison's summary with no header of their own.
-    detail::streamHeaderHash(os) = 0;
-
-    detail::writeTableHeaderLines(os, columnsFor(compareResult[0], true), config.mBenchmarkTitle);
+    // A rate out of 40 runs is itself a noisy estimate - an honest 5% produces 5 of 40 one time in
+    // seven - so the warning is for a count that 5% makes less likely than 1%: 7 of 40, 4 of 10.
+    double atLeast = 1.0;
+    double pmf = std::pow(0.95, d(noiseFloor.runs));
+    for (size_t k = 0; k < noiseFloor.falsePositives && k < noiseFloor.runs; ++k) {
+        atLeast -= pmf;
+        pmf *= d(noiseFloor.runs - k) / d(k + 1U) * (0.05 / 0.95);
+    }
+    if (0U != noiseFloor.falsePositives && atLeast < 0.01) {
+        os << "    warning: identical code compared as different in " << noiseFloor.falsePositives << " of "
+           << noiseFloor.runs << " calibration runs on this machine, so a resolved difference here is less certain than 95%"
+           << std::endl;
+    }
 
-    for (size_t i = 0; i < compareResult.size(); ++i) {
-        auto const columns = columnsFor(compareResult[i], 0U == i);
-        for (auto const& col : columns) {
-            os << col.value();
-        }
-        os << "| " << detail::fmt::MarkDownCode(compareResult[i].name) << std::endl;
+    // The width falls with the square root of the rounds, so this is roughly what the target costs.
+    if (targetWidth > 0.0 && targetWidth < noiseFloor.halfWidth) {
+        auto const factor = noiseFloor.halfWidth / targetWidth;
+        os << "    warning: the noise floor here is +-" << fmt::Number(1, 1, noiseFloor.halfWidth * 100.0) << "% at "
+           << noiseFloor.rounds << " rounds, so +-" << fmt::Number(1, 1, targetWidth * 100.0) << "% takes about "
+           << u64(d(noiseFloor.rounds) * factor * factor) << " rounds" << std::endl;
     }
 }
 
-// Two alternatives read better as a sentence than as a row to look up.
-// One spelling of the interval, so the table and the two summary shapes cannot drift apart.
-static void writeCompareInterval(std::ostream& os, double low, double high) {
-    os << "95% CI [" << detail::fmt::Number(1, 2, low) << " .. " << detail::fmt::Number(1, 2, high) << "]";
+std::vector<CompareResult::Ratio> compareMeasureRatios(Result const& baseline, Result const& alternative, double confidence) {
+    std::vector<CompareResult::Ratio> ratios(u(Result::Measure::_size), CompareResult::Ratio{0.0, 0.0, 0.0});
+    for (size_t m = 0; m < ratios.size(); ++m) {
+        auto const logRatios = pairedLogRatios(baseline, alternative, static_cast<Result::Measure>(m));
+        if (logRatios.empty()) {
+            continue;
+        }
+        // the same sign test as for the time, so the counters' intervals mean exactly what its does
+        auto const interval = medianInterval(logRatios, confidence);
+        ratios[m] = CompareResult::Ratio{std::exp(medianOf(logRatios)), std::exp(interval.first), std::exp(interval.second)};
+    }
+    return ratios;
 }
 
-static void writeComparePair(std::ostream& os, CompareResult const& compareResult) {
-    auto const baseline = detail::fmt::MarkDownCode(compareResult[0].name);
-    auto const& entry = compareResult[1];
-    auto const other = detail::fmt::MarkDownCode(entry.name);
+void dropSlowerThanLeader(std::vector<Result> const& results, std::vector<uint32_t>& running, double confidence) {
+    auto leader = running.front();
+    for (auto i : running) {
+        if (results[i].median(Result::Measure::elapsed) < results[leader].median(Result::Measure::elapsed)) {
+            leader = i;
+        }
+    }
 
-    if (!compareResult.isSignificant(1)) {
-        os << "    no difference resolved between " << baseline << " and " << other << std::endl
-           << "    ratio " << detail::fmt::Number(1, 2, entry.relative) << "x, ";
-        writeCompareInterval(os, entry.relativeLow, entry.relativeHigh);
-        return;
+    std::vector<uint32_t> kept;
+    for (auto i : running) {
+        // ln(t_leader) - ln(t_i), so an interval entirely below 0 is an alternative slower than the
+        // leader in every plausible reading of the data
+        bool const isSlower = 0U != i && leader != i &&
+                              medianInterval(pairedLogRatios(results[leader], results[i]), confidence).second < 0.0;
+        if (!isSlower) {
+            kept.push_back(i);
+        }
     }
+    running = std::move(kept);
+}
 
-    // stated the way round the reader asked the question, so the interval inverts with it
-    auto const faster = entry.relative > 1.0;
-    os << "    " << other << " ran " << detail::fmt::Number(1, 2, faster ? entry.relative : 1.0 / entry.relative)
-       << (faster ? "x faster than " : "x slower than ") << baseline << std::endl
-       << "    ";
-    writeCompareInterval(os, faster ? entry.relativeLow : 1.0 / entry.relativeHigh,
-                         faster ? entry.relativeHigh : 1.0 / entry.relativeLow);
+// Linear interpolation between the two order statistics around p * (n - 1), the usual definition of
+// a sample quantile (R's type 7). `sorted` must not be empty.
+static double sortedQuantile(std::vector<double> const& sorted, double p) {
+    auto const pos = p * d(sorted.size() - 1U);
+    auto const lo = static_cast<size_t>(pos);
+    auto const hi = (std::min)(lo + 1U, sorted.size() - 1U);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * (pos - d(lo));
 }
 
-// Picking the winner out of many is a selection, not a test: whichever came first is flattered by the
-// same luck that made it first. So the claim is not "this one is fastest" on its own, it is how far
-// ahead of the *runner-up* it is - and if that interval contains 1, the top two were not separated.
-static void writeCompareWinner(std::ostream& os, CompareResult const& compareResult) {
-    auto const best = compareResult.fastest();
-    auto runnerUp = fastestExcept(compareResult, best);
-    if (runnerUp == compareResult.size()) {
-        // a comparison of one: there is nothing to be ahead of, so it is compared against itself and
-        // the empty interval that comes out reads as "not separated"
-        runnerUp = best;
+std::vector<bool> outlierFlags(std::vector<double> const& values, OutlierMethod method) {
+    std::vector<bool> flags(values.size(), false);
+    if (OutlierMethod::none == method || values.size() < 4U) {
+        return flags;
     }
 
-    // The rounds are paired for every alternative, not only against the baseline, so the top two can
-    // be compared to each other after the fact from the per-round measurements.
-    auto const logRatios = detail::pairedLogRatios(compareResult[runnerUp].result, compareResult[best].result);
-    auto const confidence = detail::bonferroniConfidence(compareResult.comparisons());
-    auto const interval = detail::medianInterval(logRatios, confidence);
-    auto const lead = std::exp(detail::medianOf(logRatios));
-    auto const leadLow = std::exp(interval.first);
-    auto const leadHigh = std::exp(interval.second);
-
-    auto const bestCode = detail::fmt::MarkDownCode(compareResult[best].name);
-    auto const runnerUpCode = detail::fmt::MarkDownCode(compareResult[runnerUp].name);
-    if (leadLow > 1.0) {
-        os << "    " << bestCode << " is fastest of " << compareResult.size() << ", " << detail::fmt::Number(1, 2, lead)
-           << "x ahead of " << runnerUpCode << std::endl;
+    double low = 0.0;
+    double high = 0.0;
+    if (OutlierMethod::tukey == method) {
+        auto sorted = values;
+        std::sort(sorted.begin(), sorted.end());
+        auto const q1 = sortedQuantile(sorted, 0.25);
+        auto const q3 = sortedQuantile(sorted, 0.75);
+        auto const iqr = q3 - q1;
+        if (!(iqr > 0.0)) {
+            return flags;
+        }
+        low = q1 - 1.5 * iqr;
+        high = q3 + 1.5 * iqr;
     } else {
-        os << "    " << bestCode << " and " << runnerUpCode << " are the two fastest of " << compareResult.size()
-           << ", and were not separated" << std::endl;
+        // Iglewicz and Hoaglin's modified z-score, 0.6745 * (x - median) / MAD, above 3.5. The
+        // 0.6745 makes the MAD comparable to a standard deviation for normal data.
+        auto const median = medianOf(values);
+        std::vector<double> deviations;
+        deviations.reserve(values.size());
+        for (auto v : values) {
+            deviations.push_back(std::abs(v - median));
+        }
+        auto const mad = medianOf(std::move(deviations));
+        if (!(mad > 0.0)) {
+            return flags;
+        }
+        auto const reach = 3.5 / 0.6745 * mad;
+        low = median - reach;
+        high = median + reach;
     }
-    os << "    ";
-    writeCompareInterval(os, leadLow, leadHigh);
-    os << ", intervals corrected for " << compareResult.comparisons() << " comparisons";
-}
 
-std::ostream& operator<<(std::ostream& os, CompareResult const& compareResult) {
-    detail::fmt::StreamStateRestorer const restorer(os);
-    if (0U == compareResult.size()) {
-        return os;
+    for (size_t i = 0; i < values.size(); ++i) {
+        flags[i] = values[i] < low || values[i] > high;
     }
+    return flags;
+}
 
-    // The same table an ordinary benchmark prints, plus the ratio to the baseline and an interval for
-    // it. A ratio with no scale beside it cannot be told from the same ratio on a completely
-    // different scale, and a side that was wildly unstable is invisible in one - so the absolute
-    // numbers come first and the verdict after.
-    writeCompareTable(os, compareResult);
-
-    os << std::endl << "  Summary" << std::endl;
-    if (2U == compareResult.size()) {
-        writeComparePair(os, compareResult);
+void RunningStats::add(double x) noexcept {
+    ++mCount;
+    mSum += x;
+    if (1U == mCount) {
+        mMinimum = x;
+        mMaximum = x;
     } else {
-        writeCompareWinner(os, compareResult);
+        mMinimum = (std::min)(mMinimum, x);
+        mMaximum = (std::max)(mMaximum, x);
     }
-    os << ", " << compareResult.rounds() << " paired rounds, interleaved" << std::endl;
 
-    size_t tied = 0;
-    for (size_t i = 1; i < compareResult.size(); ++i) {
-        tied = (std::max)(tied, compareResult[i].tiedRounds);
-    }
-    if (0U != tied) {
-        os << "    up to " << tied << " of " << compareResult.rounds() << " rounds tied at the clock's resolution" << std::endl;
-    }
-    return os;
+    auto const delta = x - mMean;
+    mMean += delta / d(mCount);
+    mSumSquaredDeviations += delta * (x - mMean);
 }
 
-uint64_t Bench::compareIterations(std::vector<detail::ErasedOp> const& ops) const {
-    // An exact epochIterations() overrides any calculated count, exactly as it does in a normal run.
-    if (0 != epochIterations()) {
-        return epochIterations();
-    }
+size_t RunningStats::count() const noexcept {
+    return mCount;
+}
 
-    // The count that fills a normal epoch, per alternative. The smallest of them belongs to the
-    // slowest alternative - it needs the fewest iterations to fill an epoch - and the largest to the
-    // fastest.
-    auto const target = detail::targetRuntimePerEpoch(*this);
-    auto fewest = (std::numeric_limits<uint64_t>::max)();
-    uint64_t most = 0;
-    for (auto const& op : ops) {
-        auto const calibrated = compareCalibrate(op, target);
-        fewest = (std::min)(fewest, calibrated);
-        most = (std::max)(most, calibrated);
-    }
+double RunningStats::sum() const noexcept {
+    return mSum;
+}
 
-    // Every count above fills the same target, so they are inversely proportional to the
-    // per-iteration times and convert to any other epoch length by scaling: a count that fills
-    // `target` times `wanted / target` is the count that fills `wanted`. Calibration stops at the
-    // first count that reaches the target rather than at the exact one, so the per-iteration time
-    // behind it is if anything underestimated and the scaled counts err upwards.
-    auto const targetSeconds = detail::d(target);
-    if (!(targetSeconds > 0.0)) {
-        // Nothing to scale by. A maxEpochTime of zero gets here, and every alternative then ran
-        // minEpochIterations during calibration, which is what `fewest` holds.
-        return fewest;
-    }
-    auto const scaled = [&](uint64_t iters, Clock::duration wanted) {
-        return detail::u64(detail::d(iters) * (detail::d(wanted) / targetSeconds));
-    };
+double RunningStats::mean() const noexcept {
+    return mMean;
+}
 
-    // Taking `fewest` is what keeps the slowest alternative inside maxEpochTime, but on its own it
-    // makes every faster alternative run an epoch shorter than asked for by however much faster it
-    // is - a 1ns operation against a 50ns one gets a fiftieth of an epoch. So the count is raised
-    // until the *fastest* alternative clears the epoch this library calls long enough to measure:
-    // the clock's resolution times the multiple, which is where targetRuntimePerEpoch() starts from.
-    // That sits far below minEpochTime wherever the clock is good, so this binds only when the
-    // alternatives are orders of magnitude apart or the clock is coarse.
-    auto const measurable = scaled(most, detail::clockResolution() * clockResolutionMultiple());
+double RunningStats::variance() const noexcept {
+    if (mCount < 2U) {
+        return 0.0;
+    }
+    return mSumSquaredDeviations / d(mCount - 1U);
+}
 
-    // Raising it stretches the slowest alternative's epoch by the same factor, and maxEpochTime is
-    // the bound on that. A 1ns operation against a 1ms one cannot have both, and epochs a million
-    // times longer than asked for are the worse of the two failures.
-    auto const affordable = scaled(fewest, maxEpochTime());
+double RunningStats::minimum() const noexcept {
+    return mMinimum;
+}
 
-    return (std::max)(fewest, (std::min)(measurable, affordable));
+double RunningStats::maximum() const noexcept {
+    return mMaximum;
 }
 
-uint64_t Bench::compareCalibrate(detail::ErasedOp const& op, Clock::duration target) const {
-    uint64_t numIters = minEpochIterations();
-    uint64_t reached = 0;
-    for (size_t attempt = 0; attempt < 64; ++attempt) {
-        Clock::time_point const before = Clock::now();
-        op.run(op.op, numIters);
-        auto const elapsed = Clock::now() - before;
-        if (elapsed >= target) {
-            // Measured again at the same count before it is believed. A single reading is one
-            // interruption away from being far too high, and this loop grows in steps of up to 10x -
-            // so one preempted attempt ends the search an order of magnitude early, and every
-            // alternative then runs epochs that much shorter than they were asked to be. That is not
-            // hypothetical: an Alpine leg on a shared two core runner returned 11111 for an operation
-            // whose 11111 iterations take 14us against a 100us target, because one attempt was
-            // interrupted for 86us. Two readings in a row have to cross.
-            if (reached == numIters) {
-                return numIters;
-            }
-            reached = numIters;
-            continue;
-        }
-        reached = 0;
+P2Quantile::P2Quantile(double p) noexcept
+    : mP(p) {}
 
-        // grow towards the target, but never by more than 10x at once - the same shape as the normal
-        // upscaling, so a wildly wrong first guess still converges in a few steps
-        auto const elapsedSeconds = detail::d(elapsed);
-        auto factor = elapsedSeconds > 0.0 ? detail::d(target) / elapsedSeconds : 10.0;
-        factor = (std::min)(10.0, (std::max)(1.5, factor));
-        if (numIters > (std::numeric_limits<uint64_t>::max)() / 16U) {
-            break;
+void P2Quantile::add(double x) noexcept {
+    // the first five values are kept as they are, and become the initial markers once sorted
+    if (mCount < mHeights.size()) {
+        mHeights[mCount] = x;
+        ++mCount;
+        if (mHeights.size() == mCount) {
+            std::sort(mHeights.begin(), mHeights.end());
+            mPositions = {{0.0, 1.0, 2.0, 3.0, 4.0}};
+            mDesired = {{0.0, 2.0 * mP, 4.0 * mP, 2.0 + 2.0 * mP, 4.0}};
+            mIncrements = {{0.0, mP / 2.0, mP, (1.0 + mP) / 2.0, 1.0}};
         }
-        numIters = detail::u64(detail::d(numIters) * factor) + 1U;
+        return;
     }
-    return numIters;
-}
+    ++mCount;
 
-CompareResult Bench::compareImpl(std::vector<std::string> const& names, std::vector<detail::ErasedOp> const& ops) {
-    auto const numOps = ops.size();
+    // the cell the value falls into; a new extreme moves the outer marker along with it
+    size_t k = 0;
+    if (x < mHeights[0]) {
+        mHeights[0] = x;
+    } else if (!(x < mHeights[4])) {
+        mHeights[4] = x;
+        k = 3;
+    } else {
+        while (!(x < mHeights[k + 1])) {
+            ++k;
+        }
+    }
 
-    // A comparison on a machine with frequency scaling on needs these at least as much as a run()
-    // does, and a program that only ever calls compare() would otherwise never see them.
-    detail::printStabilityInformationOnce(output());
-    detail::printPerformanceCounterHintOnce(output(), performanceCounters());
+    for (size_t i = k + 1; i < mPositions.size(); ++i) {
+        mPositions[i] += 1.0;
+    }
+    for (size_t i = 0; i < mDesired.size(); ++i) {
+        mDesired[i] += mIncrements[i];
+    }
 
-    // Honored, though it is not the tool it looks like here: calibration below already runs each side
-    // for about a full epoch, and the serial correlation a warmup would be aimed at is removed by the
-    // pairing rather than by running longer first. Measured over 200 rounds, the raw per-round times
-    // carry a lag-1 autocorrelation around +0.10 while the paired differences carry -0.01 to -0.08,
-    // and dropping the first twenty rounds changes neither.
-    for (auto const& op : ops) {
-        op.run(op.op, warmup());
+    // move each middle marker that is a whole position off where it should be, as long as that
+    // does not run it into a neighbour
+    for (size_t i = 1; i < 4U; ++i) {
+        auto const offset = mDesired[i] - mPositions[i];
+        if ((offset >= 1.0 && mPositions[i + 1] - mPositions[i] > 1.0) ||
+            (offset <= -1.0 && mPositions[i - 1] - mPositions[i] < -1.0)) {
+            auto const sign = offset < 0.0 ? -1.0 : 1.0;
+            auto const height = parabolic(i, sign);
+            if (mHeights[i - 1] < height && height < mHeights[i + 1]) {
+                mHeights[i] = height;
+            } else {
+                mHeights[i] = linear(i, sign);
+            }
+            mPositions[i] += sign;
+        }
     }
+}
 
-    // One count for every alternative - see compareIterations() for why that matters so much.
-    auto const iters = compareIterations(ops);
+double P2Quantile::parabolic(size_t i, double sign) const noexcept {
+    auto const& n = mPositions;
+    auto const& q = mHeights;
+    return q[i] + sign / (n[i + 1] - n[i - 1]) *
+                      ((n[i] - n[i - 1] + sign) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) +
+                       (n[i + 1] - n[i] - sign) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+}
 
-    std::vector<Result> results;
-    results.reserve(numOps);
-    for (auto const& name : names) {
-        Config entryConfig = mConfig;
-        entryConfig.mBenchmarkName = name;
-        results.emplace_back(std::move(entryConfig));
+double P2Quantile::linear(size_t i, double sign) const noexcept {
+    auto const j = sign < 0.0 ? i - 1U : i + 1U;
+    return mHeights[i] + sign * (mHeights[j] - mHeights[i]) / (mPositions[j] - mPositions[i]);
+}
+
+size_t P2Quantile::count() const noexcept {
+    return mCount;
+}
+
+double P2Quantile::value() const noexcept {
+    if (0U == mCount) {
+        return 0.0;
+    }
+    if (mCount < mHeights.size()) {
+        std::array<double, 5> sorted = mHeights;
+        std::sort(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(mCount));
+        auto const pos = mP * d(mCount - 1U);
+        auto const lo = static_cast<size_t>(pos);
+        auto const hi = (std::min)(lo + 1U, mCount - 1U);
+        return sorted[lo] + (sorted[hi] - sorted[lo]) * (pos - d(lo));
     }
+    return mHeights[2];
+}
 
-    // Every alternative besides the baseline is one more chance to be wrong, so the intervals are
-    // widened to keep the whole table at 95% rather than each row separately.
-    auto const confidence = detail::bonferroniConfidence(numOps - 1U);
+// The first line of a baseline file, so that anything else is not mistaken for one.
+static char const* baselineFileHeader() {
+    return "nanobench baseline 1";
+}
 
-    // Rounds come in blocks of one epoch per alternative, and the count is raised until the interval
-    // is possible at all - with many alternatives the corrected confidence needs more rounds before
-    // any pair of order statistics reaches it.
-    auto numRounds = ((epochs() + numOps - 1U) / numOps) * numOps;
-    while (true) {
-        auto const indices = detail::medianIntervalIndices(numRounds, confidence);
-        if (indices.first <= indices.second) {
+// Escapes what would end a key early: the tab in front of the epochs, and the end of the line.
+static std::string escapeBaselineKey(std::string const& key) {
+    std::string escaped;
+    for (auto c : key) {
+        switch (c) {
+        case '\\':
+            escaped += "\\\\";
             break;
+        case '\t':
+            escaped += "\\t";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        default:
+            escaped += c;
         }
-        numRounds += numOps;
-    }
-
-    Rng orderRng;
-    std::vector<uint32_t> order(numOps);
-    for (size_t i = 0; i < numOps; ++i) {
-        order[i] = static_cast<uint32_t>(i);
     }
+    return escaped;
+}
 
-    for (size_t round = 0; round < numRounds; ++round) {
-        auto const positionInBlock = round % numOps;
-        if (0 == positionInBlock) {
-            // A fresh random permutation per block, then rotated one step per round: every
-            // alternative occupies every position exactly once over the block, so their mean
-            // positions are equal and a drift that is linear over the block cancels. For two
-            // alternatives this produces exactly ABBA or BAAB.
-            orderRng.shuffle(order);
-        }
-        for (size_t slot = 0; slot < numOps; ++slot) {
-            auto const which = order[(slot + positionInBlock) % numOps];
-            compareEpoch(ops[which], iters, results[which]);
+static std::string unescapeBaselineKey(std::string const& escaped) {
+    std::string key;
+    for (size_t i = 0; i < escaped.size(); ++i) {
+        if ('\\' != escaped[i] || i + 1 == escaped.size()) {
+            key += escaped[i];
+            continue;
         }
+        ++i;
+        key += 't' == escaped[i] ? '\t' : 'n' == escaped[i] ? '\n' : escaped[i];
     }
+    return key;
+}
+
+std::string baselineKey(Config const& config) {
+    std::ostringstream key;
+    key.imbue(std::locale::classic());
+    key.precision(std::numeric_limits<double>::max_digits10);
+    key << config.mBenchmarkTitle << " / " << config.mBenchmarkName;
+
+    for (auto const& variable : sortedContext(config)) {
+        key << " [" << variable.first << '=' << variable.second << ']';
+    }
+    if (config.mComplexityN > 0.0) {
+        key << " [N=" << config.mComplexityN << ']';
+    }
+    return key.str();
+}
+
+BaselineEntries loadBaseline(std::string const& path) {
+    BaselineEntries entries;
+    std::ifstream in(path);
+    std::string line;
+    if (!std::getline(in, line) || line != baselineFileHeader()) {
+        return entries;
+    }
+    while (std::getline(in, line)) {
+        auto const tab = line.find('\t');
+        if (std::string::npos == tab || in.eof()) {
+            // no tab, or no newline after it: not an entry, or not a whole one
+            continue;
+        }
+        std::istringstream valueStream(line.substr(tab + 1));
+        valueStream.imbue(std::locale::classic());
+        std::vector<double> values;
+        double value{};
+        while (valueStream >> value) {
+            values.push_back(value);
+        }
+        entries.emplace_back(unescapeBaselineKey(line.substr(0, tab)), std::move(values));
+    }
+    return entries;
+}
+
+// One entry as a line, built in memory so that appending it is a single write.
+static std::string baselineLine(BaselineEntries::value_type const& entry) {
+    std::ostringstream line;
+    line.imbue(std::locale::classic());
+    line.precision(std::numeric_limits<double>::max_digits10);
+    line << escapeBaselineKey(entry.first) << '\t';
+    for (size_t i = 0; i < entry.second.size(); ++i) {
+        line << (0U == i ? "" : " ") << entry.second[i];
+    }
+    line << '\n';
+    return line.str();
+}
+
+bool saveBaseline(std::string const& path, BaselineEntries const& entries) {
+    auto const tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::trunc);
+        out << baselineFileHeader() << '\n';
+        for (auto const& entry : entries) {
+            out << baselineLine(entry);
+        }
+        if (!out.flush()) {
+            return false;
+        }
+    }
+    return renameOver(tmpPath, path);
+}
+
+bool appendBaseline(std::string const& path, BaselineEntries::value_type const& entry) {
+    std::ofstream out(path, std::ios::app);
+    out << baselineLine(entry);
+    return static_cast<bool>(out.flush());
+}
+
+bool endsInNewline(std::string const& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in || static_cast<std::streamoff>(in.tellg()) <= 0) {
+        return false;
+    }
+    in.seekg(-1, std::ios::end);
+    char last = '\0';
+    return static_cast<bool>(in.get(last)) && '\n' == last;
+}
+
+BaselineEntries& baselineEntries(BaselineFile& file, std::string const& path) {
+    if (!file.isLoaded || file.path != path) {
+        file.entries = loadBaseline(path);
+        file.path = path;
+        file.isLoaded = true;
+    }
+    return file.entries;
+}
+
+bool renameOver(std::string const& from, std::string const& to) {
+    if (0 == std::rename(from.c_str(), to.c_str())) {
+        return true;
+    }
+    // rename() does not replace an existing file everywhere
+    std::remove(to.c_str());
+    return 0 == std::rename(from.c_str(), to.c_str());
+}
+
+std::string jsonLinesPath(Config const& config) {
+    if (!config.mJsonLinesPath.empty()) {
+        return config.mJsonLinesPath;
+    }
+    auto const* const path = getEnv("NANOBENCH_JSON_LINES");
+    return nullptr == path ? std::string() : std::string(path);
+}
+
+char const* measureName(Result::Measure measure) noexcept {
+    switch (measure) {
+    case Result::Measure::elapsed:
+        return "elapsed";
+    case Result::Measure::iterations:
+        return "iterations";
+    case Result::Measure::pagefaults:
+        return "pagefaults";
+    case Result::Measure::cpucycles:
+        return "cpucycles";
+    case Result::Measure::contextswitches:
+        return "contextswitches";
+    case Result::Measure::instructions:
+        return "instructions";
+    case Result::Measure::branchinstructions:
+        return "branchinstructions";
+    case Result::Measure::branchmisses:
+        return "branchmisses";
+    case Result::Measure::_size:
+        break;
+    }
+    return "";
+}
+
+// A name or a context value can hold anything, and one stray quote would make the whole line
+// unreadable - unlike the json template, which writes them as they are.
+static void writeJsonString(std::ostream& os, std::string const& str) {
+    os << '"';
+    for (auto c : str) {
+        switch (c) {
+        case '"':
+            os << "\\\"";
+            break;
+        case '\\':
+            os << "\\\\";
+            break;
+        case '\n':
+            os << "\\n";
+            break;
+        case '\t':
+            os << "\\t";
+            break;
+        case '\r':
+            os << "\\r";
+            break;
+        default: {
+            auto const u = static_cast<unsigned char>(c);
+            if (u < 0x20U) {
+                os << "\\u00" << "0123456789abcdef"[u >> 4U] << "0123456789abcdef"[u & 0xfU];
+            } else {
+                os << c;
+            }
+        }
+        }
+    }
+    os << '"';
+}
+
+void writeJsonLine(std::ostream& os, Result const& result, bool withMeasurements) {
+    using M = Result::Measure;
+    auto const& config = result.config();
+
+    // built whole and written at once, so that a reader never sees half a line for long
+    std::ostringstream line;
+    line.imbue(std::locale::classic());
+    line.precision(std::numeric_limits<double>::max_digits10);
+
+    line << "{\"title\":";
+    writeJsonString(line, config.mBenchmarkTitle);
+    line << ",\"name\":";
+    writeJsonString(line, config.mBenchmarkName);
+    line << ",\"unit\":";
+    writeJsonString(line, config.mUnit);
+    line << ",\"batch\":" << config.mBatch << ",\"complexityN\":" << config.mComplexityN << ",\"epochs\":" << config.mNumEpochs
+         << ",\"clockResolution\":" << d(clockResolution()) << ",\"clockResolutionMultiple\":" << config.mClockResolutionMultiple
+         << ",\"maxEpochTime\":" << d(config.mMaxEpochTime) << ",\"minEpochTime\":" << d(config.mMinEpochTime)
+         << ",\"minEpochIterations\":" << config.mMinEpochIterations << ",\"epochIterations\":" << config.mEpochIterations
+         << ",\"warmup\":" << config.mWarmup << ",\"relative\":" << config.mIsRelative;
+
+    auto const context = sortedContext(config);
+    line << ",\"context\":{";
+    for (size_t i = 0; i < context.size(); ++i) {
+        line << (0U == i ? "" : ",");
+        writeJsonString(line, context[i].first);
+        line << ':';
+        writeJsonString(line, context[i].second);
+    }
+    line << '}';
+
+    line << ",\"median(elapsed)\":" << result.median(M::elapsed)
+         << ",\"medianAbsolutePercentError(elapsed)\":" << result.medianAbsolutePercentError(M::elapsed)
+         << ",\"median(instructions)\":" << result.median(M::instructions)
+         << ",\"medianAbsolutePercentError(instructions)\":" << result.medianAbsolutePercentError(M::instructions)
+         << ",\"median(cpucycles)\":" << result.median(M::cpucycles) << ",\"median(contextswitches)\":" << result.median(M::contextswitches)
+         << ",\"median(pagefaults)\":" << result.median(M::pagefaults)
+         << ",\"median(branchinstructions)\":" << result.median(M::branchinstructions)
+         << ",\"median(branchmisses)\":" << result.median(M::branchmisses)
+         << ",\"totalTime\":" << result.sumProduct(M::iterations, M::elapsed) << ",\"outliers\":" << result.numOutliers();
+
+    if (withMeasurements) {
+        // a streaming result has no epochs to list, only its statistics
+        auto const numEpochs = result.streaming() ? 0U : result.size();
+        line << ",\"measurements\":[";
+        for (size_t i = 0; i < numEpochs; ++i) {
+            line << (0U == i ? "" : ",") << '{';
+            // the keys of the json template's measurements, in its order, 0 for what was not recorded and
+            // null for an epoch a merged result has no value for
+            char const* separator = "";
+            for (auto m : {M::iterations, M::elapsed, M::pagefaults, M::cpucycles, M::contextswitches, M::instructions,
+                           M::branchinstructions, M::branchmisses}) {
+                line << separator << '"' << measureName(m) << "\":";
+                auto const value = result.has(m) ? result.get(i, m) : 0.0;
+                if (isMissing(value)) {
+                    line << "null";
+                } else {
+                    line << value;
+                }
+                separator = ",";
+            }
+            line << '}';
+        }
+        line << ']';
+    }
+    line << "}\n";
+    os << line.str();
+}
+
+std::string progressDuration(std::chrono::nanoseconds duration) {
+    auto const seconds = std::chrono::duration<double>(duration).count();
+    std::ostringstream text;
+    text.imbue(std::locale::classic());
+    if (seconds < 10.0) {
+        text << std::fixed << std::setprecision(1) << (std::max)(seconds, 0.0) << 's';
+        return text.str();
+    }
+    auto const wholeSeconds = static_cast<uint64_t>(seconds + 0.5);
+    if (wholeSeconds < 60U) {
+        text << wholeSeconds << 's';
+    } else if (wholeSeconds < 3600U) {
+        text << wholeSeconds / 60U << "m " << wholeSeconds % 60U << 's';
+    } else {
+        text << wholeSeconds / 3600U << "h " << std::setw(2) << std::setfill('0') << wholeSeconds % 3600U / 60U << 'm';
+    }
+    return text.str();
+}
+
+std::string tracePath(Config const& config) {
+    if (!config.mTracePath.empty()) {
+        return config.mTracePath;
+    }
+    auto const* const path = getEnv("NANOBENCH_TRACE");
+    return nullptr == path ? std::string() : std::string(path);
+}
+
+std::string checkpointPath(Config const& config) {
+    if (!config.mCheckpointPath.empty()) {
+        return config.mCheckpointPath;
+    }
+    auto const* const path = getEnv("NANOBENCH_CHECKPOINT");
+    return nullptr == path ? std::string() : std::string(path);
+}
+
+std::string checkpointKey(Config const& config) {
+    uint64_t hash = 0;
+    hash = hash_combine(hash, config.mNumEpochs);
+    hash = hash_combine(hash, config.mClockResolutionMultiple);
+    hash = hash_combine(hash, static_cast<uint64_t>(config.mMaxEpochTime.count()));
+    hash = hash_combine(hash, static_cast<uint64_t>(config.mMinEpochTime.count()));
+    hash = hash_combine(hash, config.mMinEpochIterations);
+    hash = hash_combine(hash, config.mEpochIterations);
+    hash = hash_combine(hash, config.mWarmup);
+    hash = hash_combine(hash, static_cast<uint64_t>(u(config.mOutlierMethod)));
+    hash = hash_combine(hash, std::hash<double>{}(config.mBatch));
+    hash = hash_combine(hash, std::hash<std::string>{}(config.mUnit));
+
+    std::ostringstream key;
+    key << baselineKey(config) << " [config=" << std::hex << std::setw(16) << std::setfill('0') << hash << ']';
+    return key.str();
+}
+
+Result withEpochsOf(Config const& config, Result const& stored) {
+    auto const numEpochs = stored.size();
+    auto const numMeasures = u(Result::Measure::_size);
+    std::vector<double> epochs(numMeasures * numEpochs);
+    uint32_t has = 0;
+    for (size_t m = 0; m < numMeasures; ++m) {
+        auto const measure = static_cast<Result::Measure>(m);
+        if (stored.has(measure)) {
+            has |= UINT32_C(1) << m;
+            for (size_t i = 0; i < numEpochs; ++i) {
+                epochs[m * numEpochs + i] = stored.get(i, measure);
+            }
+        }
+    }
+    return resultOfEpochs(config, epochs, numEpochs, has);
+}
+
+Clock::time_point traceOrigin() {
+    static Clock::time_point const origin = Clock::now();
+    return origin;
+}
+
+// A complete event, "X": everything but its args, which the caller writes and closes.
+static void writeTraceEventStart(std::ostream& os, std::string const& name, char const* category, Clock::time_point begin,
+                                 Clock::time_point end) {
+    using Micros = std::chrono::duration<double, std::micro>;
+    os << ",\n{\"name\":";
+    writeJsonString(os, name);
+    os << ",\"cat\":\"" << category << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << Micros(begin - traceOrigin()).count()
+       << ",\"dur\":" << Micros(end - begin).count() << ",\"args\":{";
+}
+
+void writeTraceEvents(std::ostream& os, Result const& result, Clock::time_point begin, Clock::time_point end,
+                      std::vector<TraceSpan> const& spans, PerfCountSet<bool> const& has) {
+    using Micros = std::chrono::duration<double, std::micro>;
+    auto const& config = result.config();
+
+    // built whole and written at once, like a JSON line, so the file never ends in half an event
+    std::ostringstream events;
+    events.imbue(std::locale::classic());
+    events << std::fixed << std::setprecision(3);
+
+    writeTraceEventStart(events, config.mBenchmarkName, "benchmark", begin, end);
+    events << "\"title\":";
+    writeJsonString(events, config.mBenchmarkTitle);
+    events << ",\"epochs\":" << result.size();
+    for (auto const& variable : sortedContext(config)) {
+        events << ',';
+        writeJsonString(events, variable.first);
+        events << ':';
+        writeJsonString(events, variable.second);
+    }
+    events << "}}";
+
+    auto previousEnd = begin;
+    for (auto const& span : spans) {
+        if (span.begin > previousEnd) {
+            writeTraceEventStart(events, "between epochs", "gap", previousEnd, span.begin);
+            events << "}}";
+        }
+        previousEnd = span.end;
+        if (0U == span.iterations) {
+            writeTraceEventStart(events, span.phase, span.phase, span.begin, span.end);
+            events << "}}";
+            continue;
+        }
+
+        bool const isMeasured = std::strcmp(span.phase, "measuring") == 0;
+        auto const nsPerIteration = d(std::chrono::duration_cast<std::chrono::nanoseconds>(span.end - span.begin).count()) /
+                                    d((std::max)(span.iterations, uint64_t(1)));
+        writeTraceEventStart(events, isMeasured ? "epoch " + fmt::to_s(span.epoch + 1U) : std::string(span.phase), span.phase,
+                             span.begin, span.end);
+        events << "\"iterations\":" << span.iterations << ",\"ns_per_iteration\":" << nsPerIteration;
+        // NOLINTNEXTLINE(hicpp-avoid-c-arrays,modernize-avoid-c-arrays,cppcoreguidelines-avoid-c-arrays)
+        std::pair<bool, std::pair<char const*, uint64_t>> const counters[] = {
+            {has.pageFaults, {"pagefaults", span.counters.pageFaults}},
+            {has.cpuCycles, {"cpucycles", span.counters.cpuCycles}},
+            {has.contextSwitches, {"contextswitches", span.counters.contextSwitches}},
+            {has.instructions, {"instructions", span.counters.instructions}},
+            {has.branchInstructions, {"branchinstructions", span.counters.branchInstructions}},
+            {has.branchMisses, {"branchmisses", span.counters.branchMisses}}};
+        for (auto const& counter : counters) {
+            if (counter.first) {
+                events << ",\"" << counter.second.first << "\":" << counter.second.second;
+            }
+        }
+        events << "}}";
+
+        // a track of its own in the viewer, so that a drift over the epochs is a slope and not a guess
+        events << ",\n{\"name\":\"ns per iteration\",\"ph\":\"C\",\"pid\":1,\"tid\":1,\"ts\":"
+               << Micros(span.begin - traceOrigin()).count() << ",\"args\":{\"ns\":" << nsPerIteration << "}}";
+    }
+    os << events.str();
+}
+
+static std::vector<double> positiveLogs(std::vector<double> const& values) {
+    std::vector<double> logs;
+    logs.reserve(values.size());
+    for (auto v : values) {
+        if (v > 0.0) {
+            logs.push_back(std::log(v));
+        }
+    }
+    return logs;
+}
+
+BaselineComparison compareToBaseline(std::string name, std::vector<double> const& baseline, std::vector<double> const& current,
+                                     double tolerance) {
+    BaselineComparison comparison{std::move(name), 1.0, 1.0, 1.0, BaselineVerdict::unchanged};
+    auto const logBaseline = positiveLogs(baseline);
+    auto const logCurrent = positiveLogs(current);
+    if (logBaseline.empty() || logCurrent.empty()) {
+        return comparison;
+    }
+
+    // Hodges-Lehmann: the median of every difference between one epoch of each run. On the log
+    // scale, so the difference is a ratio and a slow epoch weighs as much as a fast one.
+    std::vector<double> differences;
+    differences.reserve(logBaseline.size() * logCurrent.size());
+    for (auto c : logCurrent) {
+        for (auto b : logBaseline) {
+            differences.push_back(c - b);
+        }
+    }
+    std::sort(differences.begin(), differences.end());
+    auto const numDifferences = differences.size();
+    auto const mid = numDifferences / 2U;
+    auto const shift = 1U == (numDifferences & 1U) ? differences[mid] : (differences[mid - 1U] + differences[mid]) / 2.0;
+
+    // The interval runs from the C-th smallest to the C-th largest difference, with C the lower
+    // critical value of the Mann-Whitney U statistic at 95% - the normal approximation, which is
+    // good from about five epochs per run on. With fewer there is no 95% interval at all, and the
+    // whole range of differences stands in for it without ever being decisive.
+    auto const n = d(logCurrent.size());
+    auto const m = d(logBaseline.size());
+    auto const critical = std::floor(n * m / 2.0 - 1.959964 * std::sqrt(n * m * (n + m + 1.0) / 12.0));
+    auto low = differences.front();
+    auto high = differences.back();
+    bool const hasInterval = critical >= 1.0;
+    if (hasInterval) {
+        auto const c = static_cast<size_t>(critical);
+        low = differences[c - 1U];
+        high = differences[numDifferences - c];
+    }
+
+    comparison.relative = std::exp(shift);
+    comparison.relativeLow = std::exp(low);
+    comparison.relativeHigh = std::exp(high);
+
+    auto const threshold = std::log1p(tolerance);
+    if (hasInterval && low > 0.0 && shift > threshold) {
+        comparison.verdict = BaselineVerdict::slower;
+    } else if (hasInterval && high < 0.0 && shift < -threshold) {
+        comparison.verdict = BaselineVerdict::faster;
+    }
+    return comparison;
+}
+
+} // namespace detail
+
+CompareResult::Entry::Entry(std::string entryName, Result entryResult, double entryRelative, double entryRelativeLow,
+                            double entryRelativeHigh, size_t entryTiedRounds) noexcept
+    : name(std::move(entryName))
+    , result(std::move(entryResult))
+    , relative(entryRelative)
+    , relativeLow(entryRelativeLow)
+    , relativeHigh(entryRelativeHigh)
+    , tiedRounds(entryTiedRounds) {}
+
+CompareResult::Ratio CompareResult::Entry::ratio(Result::Measure measure) const noexcept {
+    auto const idx = detail::u(measure);
+    return idx < measureRatios.size() ? measureRatios[idx] : Ratio{0.0, 0.0, 0.0};
+}
+
+CompareResult::CompareResult(std::vector<Entry> entries, size_t numRounds)
+    : CompareResult(std::move(entries), numRounds, 0.0, 1U) {
+    mConfidence = detail::bonferroniConfidence(comparisons());
+}
+
+CompareResult::CompareResult(std::vector<Entry> entries, size_t numRounds, double confidence, size_t looks)
+    : mEntries(std::move(entries))
+    , mRounds(numRounds)
+    , mConfidence(confidence)
+    , mLooks(looks) {}
+
+size_t CompareResult::size() const noexcept {
+    return mEntries.size();
+}
+
+CompareResult::Entry const& CompareResult::operator[](size_t idx) const {
+    return mEntries.at(idx);
+}
+
+size_t CompareResult::rounds() const noexcept {
+    return mRounds;
+}
+
+size_t CompareResult::comparisons() const noexcept {
+    return mEntries.empty() ? 0U : mEntries.size() - 1U;
+}
+
+double CompareResult::confidence() const noexcept {
+    return mConfidence;
+}
+
+size_t CompareResult::looks() const noexcept {
+    return mLooks;
+}
+
+bool CompareResult::isDropped(size_t idx) const {
+    // the baseline is never dropped, so it ran every round
+    return mEntries.at(idx).result.size() < mEntries.at(0).result.size();
+}
+
+bool CompareResult::isSignificant(size_t idx) const {
+    if (0U == idx) {
+        // the baseline is not compared against itself
+        return false;
+    }
+    auto const& entry = mEntries.at(idx);
+    return entry.relativeLow > 1.0 || entry.relativeHigh < 1.0;
+}
+
+// The entry with the lowest median, ignoring index `skip` - pass size() to ignore nothing. Returns
+// size() when that leaves no entry at all. The winner and the runner-up are the same question asked
+// twice, and asking it twice is how the two answers come to disagree about ties.
+static size_t fastestExcept(CompareResult const& compareResult, size_t skip) {
+    size_t best = compareResult.size();
+    auto bestMedian = (std::numeric_limits<double>::max)();
+    for (size_t i = 0; i < compareResult.size(); ++i) {
+        if (i == skip) {
+            continue;
+        }
+        auto const median = compareResult[i].result.median(Result::Measure::elapsed);
+        if (median < bestMedian) {
+            bestMedian = median;
+            best = i;
+        }
+    }
+    return best;
+}
+
+size_t CompareResult::fastest() const {
+    auto const best = fastestExcept(*this, mEntries.size());
+    // with no entries there is nothing to pick, and 0 is what this has always answered
+    return best == mEntries.size() ? 0U : best;
+}
+
+double CompareResult::equivalenceMargin() const {
+    // every entry was measured under the same config, the baseline's included
+    return mEntries.empty() ? 0.0 : mEntries.front().result.config().mCompareEquivalenceMargin;
+}
+
+Equivalence CompareResult::equivalence(size_t idx) const {
+    auto const& entry = mEntries.at(idx);
+    if (0U == idx) {
+        return Equivalence::equivalent;
+    }
+    auto const margin = equivalenceMargin();
+    if (!(margin > 0.0) || !(entry.relativeLow > 0.0) || !(entry.relativeHigh > 0.0)) {
+        return Equivalence::inconclusive;
+    }
+    // relative is baseline over alternative, the other way round from the log ratios - but the margin
+    // is symmetric on the log scale, so which way round does not matter
+    return detail::equivalenceOf({std::log(entry.relativeLow), std::log(entry.relativeHigh)}, margin);
+}
+
+// The table half of a comparison: an ordinary benchmark table with the ratio to the baseline and an
+// interval for it in front. Split out of operator<< because clang-tidy caps cognitive complexity at
+// 25 and the two halves together sat well over it.
+static void writeCompareTable(std::ostream& os, CompareResult const& compareResult) {
+    auto const& config = compareResult[0].result.config();
+    auto ratioText = [](double low, double high) {
+        std::ostringstream ss;
+        ss << detail::fmt::Number(1, 1, low * 100.0) << "% .. " << detail::fmt::Number(1, 1, high * 100.0) << "%";
+        return ss.str();
+    };
+
+    // The two extra columns are the comparison itself, so they are not hideable - without them this
+    // is just a table. Everything after them is the same set an ordinary table shows, performance
+    // counters included: a comparison collects them around every epoch either way, so leaving them
+    // out was paying for them and showing nothing.
+    auto columnsFor = [&](CompareResult::Entry const& entry, bool isBaseline) {
+        std::vector<detail::fmt::MarkDownColumn> columns;
+        columns.push_back(detail::relativeColumn(entry.relative * 100.0));
+        columns.emplace_back(22, "95% CI", isBaseline ? std::string() : ratioText(entry.relativeLow, entry.relativeHigh));
+        auto const measurements = detail::measurementColumns(entry.result.config(), entry.result);
+        columns.insert(columns.end(), measurements.begin(), measurements.end());
+        return columns;
+    };
+
+    // An ordinary table only reprints its header when the shape changes, and that state lives on the
+    // stream. A comparison table always prints its own header, so the remembered shape is now wrong:
+    // clear it, or the next run() on this stream matches against a header it never wrote and streams
+    // its rows straight under the comparison's summary with no header of their own.
+    detail::streamHeaderHash(os) = 0;
+
+    detail::writeTableHeaderLines(os, columnsFor(compareResult[0], true), config.mBenchmarkTitle);
+
+    for (size_t i = 0; i < compareResult.size(); ++i) {
+        auto const columns = columnsFor(compareResult[i], 0U == i);
+        for (auto const& col : columns) {
+            os << col.value();
+        }
+        os << "| " << detail::fmt::MarkDownCode(compareResult[i].name);
+        if (compareResult.isDropped(i)) {
+            os << " (dropped after " << compareResult[i].result.size() << " rounds)";
+        }
+        os << std::endl;
+    }
+}
+
+// Two alternatives read better as a sentence than as a row to look up.
+// One spelling of the interval, so the table and the two summary shapes cannot drift apart.
+static void writeCompareInterval(std::ostream& os, double low, double high) {
+    os << "95% CI [" << detail::fmt::Number(1, 2, low) << " .. " << detail::fmt::Number(1, 2, high) << "]";
+}
+
+static void writeComparePair(std::ostream& os, CompareResult const& compareResult) {
+    auto const baseline = detail::fmt::MarkDownCode(compareResult[0].name);
+    auto const& entry = compareResult[1];
+    auto const other = detail::fmt::MarkDownCode(entry.name);
+
+    if (!compareResult.isSignificant(1)) {
+        os << "    no difference resolved between " << baseline << " and " << other << std::endl
+           << "    ratio " << detail::fmt::Number(1, 2, entry.relative) << "x, ";
+        writeCompareInterval(os, entry.relativeLow, entry.relativeHigh);
+        return;
+    }
+
+    // stated the way round the reader asked the question, so the interval inverts with it
+    auto const faster = entry.relative > 1.0;
+    os << "    " << other << " ran " << detail::fmt::Number(1, 2, faster ? entry.relative : 1.0 / entry.relative)
+       << (faster ? "x faster than " : "x slower than ") << baseline << std::endl
+       << "    ";
+    writeCompareInterval(os, faster ? entry.relativeLow : 1.0 / entry.relativeHigh,
+                         faster ? entry.relativeHigh : 1.0 / entry.relativeLow);
+}
+
+namespace detail {
+
+// The fastest alternative, the runner-up, and how far the one is ahead of the other.
+struct CompareLead {
+    size_t best;     // NOLINT(misc-non-private-member-variables-in-classes)
+    size_t runnerUp; // NOLINT(misc-non-private-member-variables-in-classes)
+    double lead;     // NOLINT(misc-non-private-member-variables-in-classes)
+    double low;      // NOLINT(misc-non-private-member-variables-in-classes)
+    double high;     // NOLINT(misc-non-private-member-variables-in-classes)
+};
+
+} // namespace detail
+
+// Picking the winner out of many is a selection, not a test: whichever came first is flattered by the
+// same luck that made it first. So the claim is not "this one is fastest" on its own, it is how far
+// ahead of the *runner-up* it is - and if that interval contains 1, the top two were not separated.
+static detail::CompareLead compareLead(CompareResult const& compareResult) {
+    auto const best = compareResult.fastest();
+    auto runnerUp = fastestExcept(compareResult, best);
+    if (runnerUp == compareResult.size()) {
+        // a comparison of one: there is nothing to be ahead of, so it is compared against itself and
+        // the empty interval that comes out reads as "not separated"
+        runnerUp = best;
+    }
+
+    // The rounds are paired for every alternative, not only against the baseline, so the top two can
+    // be compared to each other after the fact from the per-round measurements.
+    auto const logRatios = detail::pairedLogRatios(compareResult[runnerUp].result, compareResult[best].result);
+    auto const interval = detail::medianInterval(logRatios, compareResult.confidence());
+    return detail::CompareLead{best, runnerUp, std::exp(detail::medianOf(logRatios)), std::exp(interval.first),
+                               std::exp(interval.second)};
+}
+
+static void writeCompareWinner(std::ostream& os, CompareResult const& compareResult) {
+    auto const lead = compareLead(compareResult);
+    auto const bestCode = detail::fmt::MarkDownCode(compareResult[lead.best].name);
+    auto const runnerUpCode = detail::fmt::MarkDownCode(compareResult[lead.runnerUp].name);
+    if (lead.low > 1.0) {
+        os << "    " << bestCode << " is fastest of " << compareResult.size() << ", " << detail::fmt::Number(1, 2, lead.lead)
+           << "x ahead of " << runnerUpCode << std::endl;
+    } else {
+        os << "    " << bestCode << " and " << runnerUpCode << " are the two fastest of " << compareResult.size()
+           << ", and were not separated" << std::endl;
+    }
+    os << "    ";
+    writeCompareInterval(os, lead.low, lead.high);
+    os << ", intervals corrected for " << compareResult.comparisons() << " comparisons";
+}
+
+// One line per alternative saying whether it is within the margin, as a gate would read it.
+static void writeCompareEquivalence(std::ostream& os, CompareResult const& compareResult) {
+    if (!(compareResult.equivalenceMargin() > 0.0)) {
+        return;
+    }
+    os << std::endl
+       << "  Equivalence within +-" << detail::fmt::Number(1, 1, compareResult.equivalenceMargin() * 100.0) << "% of "
+       << detail::fmt::MarkDownCode(compareResult[0].name) << std::endl;
+    for (size_t i = 1; i < compareResult.size(); ++i) {
+        auto const equivalence = compareResult.equivalence(i);
+        os << "    " << detail::fmt::MarkDownCode(compareResult[i].name)
+           << (Equivalence::equivalent == equivalence      ? " is equivalent"
+               : Equivalence::notEquivalent == equivalence ? " is not equivalent"
+                                                           : " is inconclusive")
+           << ", ";
+        writeCompareInterval(os, compareResult[i].relativeLow, compareResult[i].relativeHigh);
+        os << std::endl;
+    }
+}
+
+// The counters' ratios, one line per alternative, after the summary. The time is the verdict, and the
+// counters are the evidence for *why*: fewer instructions with no resolved difference in time is a
+// change the clock was too noisy to show, not one that does nothing. Only the hardware counters are
+// listed, since page faults and context switches are mostly 0 and carry no ratio.
+static void writeCompareCounters(std::ostream& os, CompareResult const& compareResult) {
+    static std::vector<std::pair<Result::Measure, char const*>> const counters = {
+        {Result::Measure::instructions, "instructions"},
+        {Result::Measure::cpucycles, "cpucycles"},
+        {Result::Measure::branchinstructions, "branchinstructions"},
+        {Result::Measure::branchmisses, "branchmisses"}};
+
+    bool hasHeader = false;
+    for (size_t i = 1; i < compareResult.size(); ++i) {
+        auto const& entry = compareResult[i];
+        std::ostringstream line;
+        for (auto const& counter : counters) {
+            auto const ratio = entry.ratio(counter.first);
+            if (!(ratio.relative > 0.0)) {
+                continue;
+            }
+            // three digits, because a counter resolves differences the time's two would round away
+            line << (line.tellp() > 0 ? ", " : "") << counter.second << " " << detail::fmt::Number(1, 3, ratio.relative)
+                 << " [" << detail::fmt::Number(1, 3, ratio.relativeLow) << " .. " << detail::fmt::Number(1, 3, ratio.relativeHigh)
+                 << "]";
+        }
+        if (line.tellp() <= 0) {
+            continue;
+        }
+        if (!hasHeader) {
+            os << std::endl << "  Counters, ratio to the baseline with its interval" << std::endl;
+            hasHeader = true;
+        }
+        os << "    " << detail::fmt::MarkDownCode(entry.name) << ": " << line.str() << std::endl;
+    }
+}
+
+std::ostream& operator<<(std::ostream& os, CompareResult const& compareResult) {
+    detail::fmt::StreamStateRestorer const restorer(os);
+    if (0U == compareResult.size()) {
+        return os;
+    }
+
+    // The same table an ordinary benchmark prints, plus the ratio to the baseline and an interval for
+    // it. A ratio with no scale beside it cannot be told from the same ratio on a completely
+    // different scale, and a side that was wildly unstable is invisible in one - so the absolute
+    // numbers come first and the verdict after.
+    writeCompareTable(os, compareResult);
+
+    os << std::endl << "  Summary" << std::endl;
+    if (2U == compareResult.size()) {
+        writeComparePair(os, compareResult);
+    } else {
+        writeCompareWinner(os, compareResult);
+    }
+    os << ", " << compareResult.rounds() << " paired rounds, interleaved";
+    if (compareResult.looks() > 1U) {
+        os << ", stopped after " << compareResult.looks() << " looks";
+    }
+    os << std::endl;
+
+    size_t tied = 0;
+    for (size_t i = 1; i < compareResult.size(); ++i) {
+        tied = (std::max)(tied, compareResult[i].tiedRounds);
+    }
+    if (0U != tied) {
+        os << "    up to " << tied << " of " << compareResult.rounds() << " rounds tied at the clock's resolution" << std::endl;
+    }
+    writeCompareEquivalence(os, compareResult);
+    writeCompareCounters(os, compareResult);
+    return os;
+}
+
+CompareSweep::CompareSweep(std::vector<size_t> sizes, std::vector<CompareResult> results)
+    : mSizes(std::move(sizes))
+    , mResults(std::move(results)) {}
+
+size_t CompareSweep::size() const noexcept {
+    return mResults.size();
+}
+
+std::vector<size_t> const& CompareSweep::sizes() const noexcept {
+    return mSizes;
+}
+
+CompareResult const& CompareSweep::operator[](size_t idx) const {
+    return mResults.at(idx);
+}
+
+std::vector<size_t> CompareSweep::crossovers() const {
+    std::vector<size_t> indices;
+    for (size_t i = 1; i < mResults.size(); ++i) {
+        if (mResults[i].fastest() != mResults[i - 1].fastest()) {
+            indices.push_back(i);
+        }
+    }
+    return indices;
+}
+
+// The winner at one size, as the table's last column shows it: the fastest alone when it was told
+// apart from the runner-up, and both of them when it was not.
+static std::string sweepWinnerText(CompareResult const& compareResult) {
+    auto const lead = compareLead(compareResult);
+    std::ostringstream ss;
+    ss << detail::fmt::MarkDownCode(compareResult[lead.best].name);
+    if (!(lead.low > 1.0)) {
+        ss << " ~ " << detail::fmt::MarkDownCode(compareResult[lead.runnerUp].name);
+    }
+    return ss.str();
+}
+
+std::ostream& operator<<(std::ostream& os, CompareSweep const& compareSweep) {
+    detail::fmt::StreamStateRestorer const restorer(os);
+    if (0U == compareSweep.size() || 0U == compareSweep[0].size()) {
+        return os;
+    }
+
+    // One row per size rather than per alternative, since the question is how the ratios move with
+    // the size. Each cell is what compare()'s relative and 95% CI columns hold, in one. A ratio can run
+    // into the thousands of percent at the far end of a sweep, so the widths are fitted to the cells.
+    auto const& first = compareSweep[0];
+    std::vector<std::vector<std::string>> cells(compareSweep.size());
+    std::vector<size_t> widths;
+    for (size_t i = 0; i < first.size(); ++i) {
+        widths.push_back((std::max)(static_cast<size_t>(12), first[i].name.size() + 3U));
+    }
+    for (size_t idx = 0; idx < compareSweep.size(); ++idx) {
+        auto const& compareResult = compareSweep[idx];
+        for (size_t i = 0; i < compareResult.size(); ++i) {
+            auto const& entry = compareResult[i];
+            std::ostringstream cell;
+            cell << detail::fmt::Number(1, 1, entry.relative * 100.0) << "%";
+            if (0U != i) {
+                cell << " (" << detail::fmt::Number(1, 1, entry.relativeLow * 100.0) << " .. "
+                     << detail::fmt::Number(1, 1, entry.relativeHigh * 100.0) << ")";
+            }
+            cells[idx].push_back(cell.str());
+            widths[i] = (std::max)(widths[i], cells[idx].back().size() + 3U);
+        }
+    }
+    auto columnsFor = [&](size_t idx) {
+        std::vector<detail::fmt::MarkDownColumn> columns;
+        columns.emplace_back(14, 0, "n", "", detail::d(compareSweep.sizes()[idx]));
+        for (size_t i = 0; i < cells[idx].size(); ++i) {
+            columns.emplace_back(static_cast<int>(widths[i]), first[i].name, cells[idx][i]);
+        }
+        return columns;
+    };
+
+    // the same reasoning as in writeCompareTable(): this header is always printed
+    detail::streamHeaderHash(os) = 0;
+    detail::writeTableHeaderLines(os, columnsFor(0), first[0].result.config().mBenchmarkTitle);
+    for (size_t idx = 0; idx < compareSweep.size(); ++idx) {
+        for (auto const& col : columnsFor(idx)) {
+            os << col.value();
+        }
+        os << "| " << sweepWinnerText(compareSweep[idx]) << std::endl;
+    }
+
+    // A crossover is only placed to within the two sizes around it, and only believed when the winner
+    // was told apart from the runner-up on both sides of it - so a side where it was not is named.
+    os << std::endl << "  Summary" << std::endl;
+    auto const crossovers = compareSweep.crossovers();
+    if (crossovers.empty()) {
+        os << "    " << detail::fmt::MarkDownCode(first[first.fastest()].name) << " is fastest at every size" << std::endl;
+    }
+    for (auto idx : crossovers) {
+        auto const& before = compareSweep[idx - 1U];
+        auto const& after = compareSweep[idx];
+        os << "    fastest changes from " << detail::fmt::MarkDownCode(before[before.fastest()].name) << " to "
+           << detail::fmt::MarkDownCode(after[after.fastest()].name) << " between n=" << compareSweep.sizes()[idx - 1U]
+           << " and n=" << compareSweep.sizes()[idx];
+        for (auto at : {idx - 1U, idx}) {
+            if (!(compareLead(compareSweep[at]).low > 1.0)) {
+                os << ", not separated at n=" << compareSweep.sizes()[at];
+            }
+        }
+        os << std::endl;
+    }
+    os << "    " << compareSweep.size() << " sizes, intervals corrected for " << first.comparisons()
+       << " comparisons per size" << std::endl;
+    return os;
+}
+
+uint64_t Bench::compareIterations(std::vector<detail::ErasedOp> const& ops) const {
+    // An exact epochIterations() overrides any calculated count, exactly as it does in a normal run.
+    if (0 != epochIterations()) {
+        return epochIterations();
+    }
+
+    // The count that fills a normal epoch, per alternative. The smallest of them belongs to the
+    // slowest alternative - it needs the fewest iterations to fill an epoch - and the largest to the
+    // fastest.
+    auto const target = detail::targetRuntimePerEpoch(*this);
+    auto fewest = (std::numeric_limits<uint64_t>::max)();
+    uint64_t most = 0;
+    for (auto const& op : ops) {
+        auto const calibrated = compareCalibrate(op, target);
+        fewest = (std::min)(fewest, calibrated);
+        most = (std::max)(most, calibrated);
+    }
+
+    // Every count above fills the same target, so they are inversely proportional to the
+    // per-iteration times and convert to any other epoch length by scaling: a count that fills
+    // `target` times `wanted / target` is the count that fills `wanted`. Calibration stops at the
+    // first count that reaches the target rather than at the exact one, so the per-iteration time
+    // behind it is if anything underestimated and the scaled counts err upwards.
+    auto const targetSeconds = detail::d(target);
+    if (!(targetSeconds > 0.0)) {
+        // Nothing to scale by. A maxEpochTime of zero gets here, and every alternative then ran
+        // minEpochIterations during calibration, which is what `fewest` holds.
+        return fewest;
+    }
+    auto const scaled = [&](uint64_t iters, Clock::duration wanted) {
+        return detail::u64(detail::d(iters) * (detail::d(wanted) / targetSeconds));
+    };
+
+    // Taking `fewest` is what keeps the slowest alternative inside maxEpochTime, but on its own it
+    // makes every faster alternative run an epoch shorter than asked for by however much faster it
+    // is - a 1ns operation against a 50ns one gets a fiftieth of an epoch. So the count is raised
+    // until the *fastest* alternative clears the epoch this library calls long enough to measure:
+    // the clock's resolution times the multiple, which is where targetRuntimePerEpoch() starts from.
+    // That sits far below minEpochTime wherever the clock is good, so this binds only when the
+    // alternatives are orders of magnitude apart or the clock is coarse.
+    auto const measurable = scaled(most, detail::clockResolution() * clockResolutionMultiple());
+
+    // Raising it stretches the slowest alternative's epoch by the same factor, and maxEpochTime is
+    // the bound on that. A 1ns operation against a 1ms one cannot have both, and epochs a million
+    // times longer than asked for are the worse of the two failures.
+    auto const affordable = scaled(fewest, maxEpochTime());
+
+    return (std::max)(fewest, (std::min)(measurable, affordable));
+}
+
+uint64_t Bench::compareCalibrate(detail::ErasedOp const& op, Clock::duration target) const {
+    uint64_t numIters = minEpochIterations();
+    uint64_t reached = 0;
+    for (size_t attempt = 0; attempt < 64; ++attempt) {
+        detail::setUpErasedOp(op);
+        Clock::time_point const before = Clock::now();
+        op.run(op.op, numIters);
+        auto const elapsed = Clock::now() - before;
+        if (elapsed >= target) {
+            // Measured again at the same count before it is believed. A single reading is one
+            // interruption away from being far too high, and this loop grows in steps of up to 10x -
+            // so one preempted attempt ends the search an order of magnitude early, and every
+            // alternative then runs epochs that much shorter than they were asked to be. That is not
+            // hypothetical: an Alpine leg on a shared two core runner returned 11111 for an operation
+            // whose 11111 iterations take 14us against a 100us target, because one attempt was
+            // interrupted for 86us. Two readings in a row have to cross.
+            if (reached == numIters) {
+                return numIters;
+            }
+            reached = numIters;
+            continue;
+        }
+        reached = 0;
+
+        // grow towards the target, but never by more than 10x at once - the same shape as the normal
+        // upscaling, so a wildly wrong first guess still converges in a few steps
+        auto const elapsedSeconds = detail::d(elapsed);
+        auto factor = elapsedSeconds > 0.0 ? detail::d(target) / elapsedSeconds : 10.0;
+        factor = (std::min)(10.0, (std::max)(1.5, factor));
+        if (numIters > (std::numeric_limits<uint64_t>::max)() / 16U) {
+            break;
+        }
+        numIters = detail::u64(detail::d(numIters) * factor) + 1U;
+    }
+    return numIters;
+}
+
+bool Bench::isCompareDone(std::vector<Result> const& results, double confidence) const {
+    if (compareTargetWidth() > 0.0 && !detail::isCompareNarrowEnough(results, confidence, compareTargetWidth())) {
+        return false;
+    }
+    return !(compareEquivalence() > 0.0) || detail::isCompareEquivalenceDecided(results, confidence, compareEquivalence());
+}
+
+CompareResult Bench::compareImpl(std::vector<std::string> const& names, std::vector<detail::ErasedOp> const& ops) {
+    auto const numOps = ops.size();
+    auto const start = Clock::now();
+
+    // A comparison on a machine with frequency scaling on needs these at least as much as a run()
+    // does, and a program that only ever calls compare() would otherwise never see them.
+    detail::printStabilityInformationOnce(output());
+    detail::printPerformanceCounterHintOnce(output(), performanceCounters());
+
+    // Honored, though it is not the tool it looks like here: calibration below already runs each side
+    // for about a full epoch, and the serial correlation a warmup would be aimed at is removed by the
+    // pairing rather than by running longer first. Measured over 200 rounds, the raw per-round times
+    // carry a lag-1 autocorrelation around +0.10 while the paired differences carry -0.01 to -0.08,
+    // and dropping the first twenty rounds changes neither.
+    if (0 != warmup()) {
+        for (auto const& op : ops) {
+            detail::setUpErasedOp(op);
+            op.run(op.op, warmup());
+        }
+    }
+
+    // One count for every alternative - see compareIterations() for why that matters so much.
+    auto const iters = compareIterations(ops);
+
+    std::vector<Result> results;
+    results.reserve(numOps);
+    for (auto const& name : names) {
+        Config entryConfig = mConfig;
+        entryConfig.mBenchmarkName = name;
+        // the rounds are paired epoch by epoch, so every epoch has to be kept
+        entryConfig.mStreaming = false;
+        results.emplace_back(std::move(entryConfig));
+    }
+
+    // Every alternative besides the baseline is one more chance to be wrong, so the intervals are
+    // widened to keep the whole table at 95% rather than each row separately.
+    auto const familyConfidence = detail::bonferroniConfidence(numOps - 1U);
+
+    // A sequential or racing comparison looks more than once, and look k gets alpha / (k (k + 1)) of
+    // the error rate, which sums to alpha however many looks it takes - see compareTargetWidth().
+    bool const isSequential = compareTargetWidth() > 0.0 || compareEquivalence() > 0.0;
+    bool const isRacing = compareRacing();
+    auto const confidenceAt = [&](size_t look) {
+        return isSequential || isRacing ? 1.0 - (1.0 - familyConfidence) / detail::d(look * (look + 1U)) : familyConfidence;
+    };
+
+    // Rounds come in blocks of one epoch per alternative, and the count is raised until the interval
+    // is possible at all - with many alternatives the corrected confidence needs more rounds before
+    // any pair of order statistics reaches it.
+    auto const roundsFor = [&](size_t atLeast, double confidence) {
+        auto rounds = ((atLeast + numOps - 1U) / numOps) * numOps;
+        while (true) {
+            auto const indices = detail::medianIntervalIndices(rounds, confidence);
+            if (indices.first <= indices.second) {
+                return rounds;
+            }
+            rounds += numOps;
+        }
+    };
+
+    // The alternatives still running, in the order of the current block. All of them, unless racing
+    // has dropped some.
+    Rng orderRng;
+    std::vector<uint32_t> order(numOps);
+    for (size_t i = 0; i < numOps; ++i) {
+        order[i] = static_cast<uint32_t>(i);
+    }
+
+    // Racing looks first as soon as an interval is possible, everything else after epochs() rounds.
+    size_t look = 1;
+    size_t doneRounds = 0;
+    size_t positionInBlock = 0;
+    std::vector<size_t> dropLook(numOps, 0U);
+    auto numRounds = roundsFor(isRacing ? 1U : epochs(), confidenceAt(look));
+    while (true) {
+        // a look only ever happens between blocks, so that the order stays balanced
+        while (doneRounds < numRounds || 0U != positionInBlock) {
+            if (0U == positionInBlock) {
+                // A fresh random permutation per block, then rotated one step per round: every
+                // alternative occupies every position exactly once over the block, so their mean
+                // positions are equal and a drift that is linear over the block cancels. For two
+                // alternatives this produces exactly ABBA or BAAB.
+                orderRng.shuffle(order);
+            }
+            for (size_t slot = 0; slot < order.size(); ++slot) {
+                auto const which = order[(slot + positionInBlock) % order.size()];
+                compareEpoch(ops[which], iters, results[which]);
+            }
+            ++doneRounds;
+            positionInBlock = (positionInBlock + 1U) % order.size();
+        }
+
+        if (isRacing) {
+            // A dropped alternative's interval is reported at the confidence it was dropped at.
+            // Its later looks never happen, so that is all of the error rate it ever spent.
+            detail::dropSlowerThanLeader(results, order, confidenceAt(look));
+            for (size_t i = 0; i < numOps; ++i) {
+                if (0U == dropLook[i] && std::find(order.begin(), order.end(), i) == order.end()) {
+                    dropLook[i] = look;
+                }
+            }
+        }
+
+        bool const hasEpochs = doneRounds >= epochs();
+        if (hasEpochs && isCompareDone(results, confidenceAt(look))) {
+            break;
+        }
+        if (isSequential && Clock::now() - start >= compareTimeBudget()) {
+            break;
+        }
+
+        // half as many rounds again: geometric growth keeps the number of looks, and with it the
+        // widening, logarithmic in the rounds it takes
+        ++look;
+        auto next = numRounds + (std::max)(numRounds / 2U, numOps);
+        if (!hasEpochs) {
+            // racing towards epochs(), and not past it
+            next = (std::min)(next, epochs());
+        }
+        numRounds = roundsFor(next, confidenceAt(look));
+    }
+    auto const confidence = confidenceAt(look);
+
+    std::vector<CompareResult::Entry> entries;
+    entries.reserve(numOps);
+    entries.emplace_back(names[0], std::move(results[0]), 1.0, 1.0, 1.0, static_cast<size_t>(0));
+    entries[0].measureRatios = detail::compareMeasureRatios(entries[0].result, entries[0].result, confidence);
+    for (size_t i = 1; i < numOps; ++i) {
+        // ln(t_baseline) - ln(t_i), so a positive difference means the alternative was quicker and
+        // the ratio comes out above 1 - the same direction relative() reports. The baseline was moved
+        // into entries[0] above, which is where it is read from now.
+        auto const entryConfidence = 0U == dropLook[i] ? confidence : confidenceAt(dropLook[i]);
+        auto const logRatios = detail::pairedLogRatios(entries[0].result, results[i]);
+        auto const interval = detail::medianInterval(logRatios, entryConfidence);
+        auto measureRatios = detail::compareMeasureRatios(entries[0].result, results[i], entryConfidence);
+        entries.emplace_back(names[i], std::move(results[i]), std::exp(detail::medianOf(logRatios)), std::exp(interval.first),
+                             std::exp(interval.second), detail::countTiedRounds(logRatios));
+        entries.back().measureRatios = std::move(measureRatios);
+    }
+
+    CompareResult compareResult{std::move(entries), doneRounds, confidence, look};
+    if (nullptr != output()) {
+        *output() << compareResult;
+        NoiseFloor floor{};
+        if (!noiseFloor().empty() && detail::loadNoiseFloor(noiseFloor(), floor)) {
+            detail::writeNoiseFloorWarnings(*output(), floor, compareTargetWidth());
+        }
+    }
+    return compareResult;
+}
+
+namespace detail {
+
+// Keeps a bench's config as it is, and puts it back when this goes out of scope however that happens.
+// compareSweep() and calibrateNoise() run compare() quietly, or at another complexityN, for a while;
+// an op that throws in the middle must not leave the bench that way. The snapshot of it goes back
+// too, so that the next run() shares it with the results from before.
+class ConfigRestorer {
+public:
+    explicit ConfigRestorer(Bench& bench)
+        : mBench(bench)
+        , mSaved(bench.mConfig)
+        , mSavedShared(bench.mSharedConfig) {}
+    ~ConfigRestorer() {
+        mBench.mConfig = std::move(mSaved);
+        mBench.mSharedConfig = std::move(mSavedShared);
+    }
+    ConfigRestorer(ConfigRestorer const&) = delete;
+    ConfigRestorer& operator=(ConfigRestorer const&) = delete;
+
+private:
+    Bench& mBench;
+    Config mSaved;
+    std::shared_ptr<Config const> mSavedShared;
+};
+
+} // namespace detail
+
+NoiseFloor Bench::calibrateNoise(size_t runs) {
+    // One operation on both sides, so there is no difference to find: A/A. It is as cheap as an
+    // operation gets, so that the epochs are all loop and clock, which is where the noise is.
+    Rng rng;
+    auto op = [&rng] {
+        detail::doNotOptimizeAway(rng());
+    };
+    std::vector<std::string> const names = {"A", "A'"};
+    std::vector<detail::ErasedOp> const ops = {detail::eraseOp(op), detail::eraseOp(op)};
+
+    detail::printStabilityInformationOnce(output());
+    auto* const out = output();
+
+    // quiet comparisons with all rounds run; the restorer puts the bench's own settings back even
+    // when an op throws
+    NoiseFloor floor{runs, 0U, 0U, 0.0};
+    std::vector<double> halfWidths;
+    {
+        detail::ConfigRestorer const restorer(*this);
+        output(nullptr).compareTargetWidth(0.0).compareEquivalence(0.0).compareRacing(false);
+        for (size_t run = 0; run < runs; ++run) {
+            auto const compareResult = compareImpl(names, ops);
+            floor.rounds = compareResult.rounds();
+            if (compareResult.isSignificant(1)) {
+                ++floor.falsePositives;
+            }
+            halfWidths.push_back(detail::compareHalfWidth(compareResult[1]));
+        }
+    }
+    floor.halfWidth = detail::medianOf(halfWidths);
+    if (!noiseFloor().empty() && !detail::saveNoiseFloor(noiseFloor(), floor)) {
+        std::cerr << "nanobench: could not save the noise floor to '" << noiseFloor() << "'" << std::endl;
+    }
+    if (nullptr != out) {
+        detail::fmt::StreamStateRestorer const restorer(*out);
+        *out << std::endl
+             << "  Noise floor" << std::endl
+             << "    identical code compared as different in " << floor.falsePositives << " of " << floor.runs
+             << " A/A comparisons, nominally 5%" << std::endl
+             << "    median interval +-" << detail::fmt::Number(1, 2, floor.halfWidth * 100.0) << "% at " << floor.rounds
+             << " paired rounds" << std::endl;
+    }
+    return floor;
+}
+
+#    if ANKERL_NANOBENCH(DLOPEN)
+
+namespace detail {
+
+// What compareSharedLibraries() calls. dlsym() hands out a void*, which is what ErasedOp holds anyway,
+// and converting that back to a function pointer is only conditionally supported as a cast - copying
+// the bits is what POSIX guarantees to work.
+static void runLibraryOp(void* op, uint64_t numIters) {
+    void (*fn)(uint64_t) = nullptr;
+    static_assert(sizeof(fn) == sizeof(op), "function and object pointers differ in size");
+    std::memcpy(&fn, &op, sizeof(fn));
+    fn(numIters);
+}
+
+} // namespace detail
+
+CompareResult Bench::compareSharedLibraries(std::vector<std::string> const& paths, std::string const& symbol) {
+    if (paths.size() < 2U) {
+        ANKERL_NANOBENCH_THROW(std::runtime_error("compareSharedLibraries: needs at least two libraries to compare"));
+    }
+
+    // closed however this is left, and only after the measuring is done
+    std::vector<std::unique_ptr<void, int (*)(void*)>> libraries;
+    std::vector<detail::ErasedOp> ops;
+    for (auto const& path : paths) {
+#        if defined(LM_ID_NEWLM)
+        void* const handle = dlmopen(LM_ID_NEWLM, path.c_str(), RTLD_NOW | RTLD_LOCAL);
+#        else
+        void* const handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+#        endif
+        if (nullptr == handle) {
+            char const* const error = dlerror();
+            ANKERL_NANOBENCH_THROW(std::runtime_error("compareSharedLibraries: cannot load '" + path + "'" +
+                                                      (nullptr == error ? std::string() : ": " + std::string(error))));
+        }
+        libraries.emplace_back(handle, &dlclose);
+
+        void* const op = dlsym(handle, symbol.c_str());
+        if (nullptr == op) {
+            ANKERL_NANOBENCH_THROW(std::runtime_error("compareSharedLibraries: no '" + symbol + "' in '" + path + "'"));
+        }
+        ops.push_back(detail::ErasedOp{&detail::runLibraryOp, op, nullptr, nullptr});
+    }
+    return compareImpl(paths, ops);
+}
+
+#    else
+
+CompareResult Bench::compareSharedLibraries(std::vector<std::string> const& /*paths*/, std::string const& /*symbol*/) {
+    ANKERL_NANOBENCH_THROW(std::runtime_error("compareSharedLibraries: needs ANKERL_NANOBENCH_DLOPEN defined along with "
+                                              "ANKERL_NANOBENCH_IMPLEMENT, on a platform with dlopen()"));
+}
+
+#    endif
+
+CompareSweep Bench::compareSweepImpl(std::vector<size_t> const& sizes, std::vector<std::string> const& names,
+                                     std::vector<detail::ErasedOp> const& ops, size_t& n) {
+    if (sizes.empty()) {
+        ANKERL_NANOBENCH_THROW(std::runtime_error("compareSweep: needs at least one size to compare at"));
+    }
+
+    // compareImpl() prints these, but only to an output it has, and it is about to have none
+    detail::printStabilityInformationOnce(output());
+    detail::printPerformanceCounterHintOnce(output(), performanceCounters());
+
+    // Every size is a compare() of its own, but the output is one table for all of them rather than a
+    // table per size, so the comparisons run quietly and the output and complexityN are put back after.
+    std::vector<CompareResult> results;
+    results.reserve(sizes.size());
+    {
+        detail::ConfigRestorer const restorer(*this);
+        output(nullptr);
+        for (auto size : sizes) {
+            n = size;
+            complexityN(size);
+            results.push_back(compareImpl(names, ops));
+        }
+    }
+
+    CompareSweep compareSweep{sizes, std::move(results)};
+    if (nullptr != output()) {
+        *output() << compareSweep;
+    }
+    return compareSweep;
+}
+
+void Bench::compareEpoch(detail::ErasedOp const& op, uint64_t numIters, Result& result) {
+    auto& pc = detail::performanceCounters();
+
+    // outside the counters' window as well as the clock's, as in runImpl()
+    detail::setUpErasedOp(op);
+    pc.beginMeasure();
+    Clock::time_point const before = Clock::now();
+    op.run(op.op, numIters);
+    Clock::time_point const after = Clock::now();
+    pc.endMeasure();
+    pc.updateResults(numIters);
+
+    result.add(after - before, numIters, pc);
+}
+
+detail::MeasurementRange Result::measurements(Measure m) const {
+    // _size, which fromString() returns for a name it does not know, is a measure that was never
+    // recorded rather than a read past the end of the storage
+    auto const idx = detail::u(m);
+    if (idx >= detail::u(Measure::_size) || 0U == (mHas & (UINT32_C(1) << idx))) {
+        return {nullptr, 0};
+    }
+    return {mMeasurements.data() + slotOf(idx) * mCapacity, mNumEpochs};
+}
+
+std::vector<double> Result::values(Measure m) const {
+    auto const data = measurements(m);
+    std::vector<double> values;
+    values.reserve(data.size());
+    std::remove_copy_if(data.begin(), data.end(), std::back_inserter(values), isMissing);
+    return values;
+}
+
+double Result::median(Measure m) const {
+    if (mConfig->mStreaming) {
+        return mStreamed.at(detail::u(m)).median.value();
+    }
+    auto data = values(m);
+    return calcMedian(data);
+}
+
+double Result::average(Measure m) const {
+    using detail::d;
+    if (mConfig->mStreaming) {
+        return mStreamed.at(detail::u(m)).stats.mean();
+    }
+    auto const data = measurements(m);
+    auto const numValues = static_cast<size_t>(std::count_if(data.begin(), data.end(), [](double x) {
+        return !isMissing(x);
+    }));
+    if (0U == numValues) {
+        return 0.0;
+    }
+
+    return sum(m) / d(numValues);
+}
+
+double Result::medianAbsolutePercentError(Measure m) const {
+    if (mConfig->mStreaming) {
+        return mStreamed.at(detail::u(m)).absolutePercentError.value();
+    }
+    // create copy
+    auto data = values(m);
+
+    // calculates MdAPE which is the median of percentage error
+    // see https://support.numxl.com/hc/en-us/articles/115001223503-MdAPE-Median-Absolute-Percentage-Error
+    auto med = calcMedian(data);
+
+    // The error is relative to the measurement itself, so a measurement of 0 has none that is finite: it is 0 when the
+    // median is 0 as well (they agree), and infinite otherwise, which is the limit of |(x - med) / x| for x -> 0.
+    // Calculating it directly would give NaN, and a NaN in the data breaks the ordering that calcMedian's sort needs.
+    auto const zeroError = med <= 0.0 ? 0.0 : std::numeric_limits<double>::infinity();
+
+    // transform the data to absolute error
+    for (auto& x : data) {
+        if (x <= 0.0) {
+            x = zeroError;
+            continue;
+        }
+        x = (x - med) / x;
+        if (x < 0) {
+            x = -x;
+        }
+    }
+    return calcMedian(data);
+}
+
+double Result::sum(Measure m) const noexcept {
+    if (mConfig->mStreaming) {
+        return mStreamed[detail::u(m)].stats.sum();
+    }
+    auto const data = measurements(m);
+    return std::accumulate(data.begin(), data.end(), 0.0, [](double total, double x) {
+        return isMissing(x) ? total : total + x;
+    });
+}
+
+double Result::sumProduct(Measure m1, Measure m2) const noexcept {
+    if (mConfig->mStreaming) {
+        // like below, measures that were not recorded in the same epochs have no sum of products
+        if (mStreamed[detail::u(m1)].stats.count() != mStreamed[detail::u(m2)].stats.count()) {
+            return 0.0;
+        }
+        return mStreamedProducts[detail::u(m1) * mStreamed.size() + detail::u(m2)];
+    }
+    auto const data1 = measurements(m1);
+    auto const data2 = measurements(m2);
+
+    if (data1.size() != data2.size()) {
+        return 0.0;
+    }
+    // an epoch that is missing either measure has no product
+    return std::inner_product(data1.begin(), data1.end(), data2.begin(), 0.0, std::plus<double>(), [](double a, double b) {
+        return isMissing(a) || isMissing(b) ? 0.0 : a * b;
+    });
+}
+
+bool Result::has(Measure m) const noexcept {
+    if (mConfig->mStreaming) {
+        return mStreamed[detail::u(m)].stats.count() != 0U;
+    }
+    return !measurements(m).empty();
+}
+
+double Result::get(size_t idx, Measure m) const {
+    if (mConfig->mStreaming) {
+        ANKERL_NANOBENCH_THROW(std::out_of_range("Result::get: a streaming result keeps no individual epochs"));
+    }
+    auto const data = measurements(m);
+    if (idx >= data.size()) {
+        ANKERL_NANOBENCH_THROW(std::out_of_range("Result::get: no epoch " + detail::fmt::to_s(idx)));
+    }
+    return data.begin()[idx];
+}
+
+bool Result::empty() const noexcept {
+    return 0U == size();
+}
+
+size_t Result::size() const noexcept {
+    if (mConfig->mStreaming) {
+        return mStreamed[detail::u(Measure::elapsed)].stats.count();
+    }
+    return mNumEpochs;
+}
+
+double Result::minimum(Measure m) const noexcept {
+    if (mConfig->mStreaming) {
+        return mStreamed[detail::u(m)].stats.minimum();
+    }
+    // the first value that is not missing, and then whatever beats it
+    auto found = std::numeric_limits<double>::quiet_NaN();
+    for (auto const x : measurements(m)) {
+        if (!isMissing(x) && (isMissing(found) || x < found)) {
+            found = x;
+        }
+    }
+    return isMissing(found) ? 0.0 : found;
+}
+
+double Result::maximum(Measure m) const noexcept {
+    if (mConfig->mStreaming) {
+        return mStreamed[detail::u(m)].stats.maximum();
+    }
+    // the first value that is not missing, and then whatever beats it
+    auto found = std::numeric_limits<double>::quiet_NaN();
+    for (auto const x : measurements(m)) {
+        if (!isMissing(x) && (isMissing(found) || x > found)) {
+            found = x;
+        }
+    }
+    return isMissing(found) ? 0.0 : found;
+}
+
+std::vector<bool> Result::outlierEpochs() const {
+    auto const elapsed = measurements(Measure::elapsed);
+    return detail::outlierFlags(std::vector<double>(elapsed.begin(), elapsed.end()), mConfig->mOutlierMethod);
+}
+
+size_t Result::numOutliers() const {
+    auto const flags = outlierEpochs();
+    return static_cast<size_t>(std::count(flags.begin(), flags.end(), true));
+}
+
+Result Result::withoutOutliers() const {
+    if (mConfig->mStreaming) {
+        // no epochs, so none are outliers
+        return *this;
+    }
+    auto const flags = outlierEpochs();
+    Result filtered(mConfig);
+    filtered.storeMeasures(mHas);
+    filtered.reserveEpochs(mNumEpochs - static_cast<size_t>(std::count(flags.begin(), flags.end(), true)));
+    filtered.mHas = mHas;
+    // an epoch goes as a whole, so the measures of the copy still line up epoch for epoch
+    for (size_t i = 0; i < mNumEpochs; ++i) {
+        if (i < flags.size() && flags[i]) {
+            continue;
+        }
+        for (size_t m = 0; m < detail::u(Measure::_size); ++m) {
+            if (0U != (mHas & (UINT32_C(1) << m))) {
+                filtered.mMeasurements[filtered.slotOf(m) * filtered.mCapacity + filtered.mNumEpochs] =
+                    mMeasurements[slotOf(m) * mCapacity + i];
+            }
+        }
+        ++filtered.mNumEpochs;
+    }
+    return filtered;
+}
+
+std::string const& Result::context(char const* variableName) const {
+    return mConfig->mContext.at(variableName);
+}
+
+std::string const& Result::context(std::string const& variableName) const {
+    return mConfig->mContext.at(variableName);
+}
+
+Result::Measure Result::fromString(std::string const& str) {
+    if (str == "elapsed") {
+        return Measure::elapsed;
+    }
+    if (str == "iterations") {
+        return Measure::iterations;
+    }
+    if (str == "pagefaults") {
+        return Measure::pagefaults;
+    }
+    if (str == "cpucycles") {
+        return Measure::cpucycles;
+    }
+    if (str == "contextswitches") {
+        return Measure::contextswitches;
+    }
+    if (str == "instructions") {
+        return Measure::instructions;
+    }
+    if (str == "branchinstructions") {
+        return Measure::branchinstructions;
+    }
+    if (str == "branchmisses") {
+        return Measure::branchmisses;
+    }
+    // not found, return _size
+    return Measure::_size;
+}
+
+// The binary result format ///////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+static constexpr size_t resultFileHeaderWords = 5;
+
+static uint64_t resultFileMagic() noexcept {
+    uint64_t magic = 0;
+    std::memcpy(&magic, "nanobnch", sizeof(magic));
+    return magic;
+}
+
+static uint64_t bitsOf(double value) noexcept {
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static double doubleOf(uint64_t bits) noexcept {
+    double value = 0.0;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static size_t numMeasures(uint64_t has) noexcept {
+    size_t count = 0;
+    for (; 0U != has; has &= has - 1U) {
+        ++count;
+    }
+    return count;
+}
+
+bool indexResultFile(uint64_t const* words, size_t numWords, char const*& strings, std::vector<uint64_t const*>& records) {
+    if (nullptr == words || numWords < resultFileHeaderWords || words[0] != resultFileMagic() || words[1] != 1U ||
+        words[2] != UINT64_C(0x0102030405060708)) {
+        return false;
+    }
+    auto const numResults = words[3];
+    auto const stringWords = words[4];
+    if (stringWords > numWords - resultFileHeaderWords) {
+        return false;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    strings = reinterpret_cast<char const*>(words + resultFileHeaderWords);
+    auto const stringBytes = stringWords * sizeof(uint64_t);
+    // the last string ends within the table, so reading any of them stops there too
+    if (stringBytes > 0U && '\0' != strings[stringBytes - 1U]) {
+        return false;
+    }
+    auto const isString = [&](uint64_t offset) {
+        return offset < stringBytes;
+    };
+
+    auto const fixed = u(ResultField::_size);
+    auto pos = resultFileHeaderWords + stringWords;
+    records.clear();
+    for (uint64_t i = 0; i < numResults; ++i) {
+        if (fixed > numWords - pos) {
+            return false;
+        }
+        auto const* const record = words + pos;
+        auto const has = record[u(ResultField::has)];
+        auto const numEpochs = record[u(ResultField::numEpochs)];
+        auto const numContext = record[u(ResultField::numContext)];
+        if (!isString(record[u(ResultField::title)]) || !isString(record[u(ResultField::name)]) ||
+            !isString(record[u(ResultField::unit)]) || record[u(ResultField::outlierMethod)] > static_cast<uint64_t>(u(OutlierMethod::mad)) ||
+            0U != (has >> u(Result::Measure::_size))) {
+            return false;
+        }
+        // each bound divides rather than multiplies, so that no count can overflow the check
+        auto left = numWords - pos - fixed;
+        if (numContext > left / 2U) {
+            return false;
+        }
+        left -= numContext * 2U;
+        auto const numArrays = numMeasures(has);
+        if (numArrays > 0U && numEpochs > left / numArrays) {
+            return false;
+        }
+        for (uint64_t c = 0; c < numContext * 2U; ++c) {
+            if (!isString(record[fixed + c])) {
+                return false;
+            }
+        }
+        records.push_back(record);
+        pos = numWords - (left - numArrays * numEpochs);
+    }
+    return true;
+}
+
+} // namespace detail
+
+namespace detail {
+
+void writeResults(std::ostream& out, Result const* results, size_t numResults) {
+
+    // every string once, in the order they are first needed
+    std::string strings;
+    std::unordered_map<std::string, uint64_t> offsets;
+    auto const intern = [&](std::string const& str) {
+        auto it = offsets.find(str);
+        if (it == offsets.end()) {
+            it = offsets.emplace(str, strings.size()).first;
+            strings.append(str.c_str(), str.size() + 1U);
+        }
+        return it->second;
+    };
+
+    std::vector<std::vector<uint64_t>> records;
+    records.reserve(numResults);
+    for (size_t i = 0; i < numResults; ++i) {
+        auto const& r = results[i];
+        auto const& config = r.config();
+        uint64_t has = 0;
+        for (size_t m = 0; m < u(Result::Measure::_size); ++m) {
+            if (!r.streaming() && r.has(static_cast<Result::Measure>(m))) {
+                has |= UINT64_C(1) << m;
+            }
+        }
+
+        std::vector<uint64_t> record(u(ResultField::_size));
+        record[u(ResultField::title)] = intern(config.mBenchmarkTitle);
+        record[u(ResultField::name)] = intern(config.mBenchmarkName);
+        record[u(ResultField::unit)] = intern(config.mUnit);
+        record[u(ResultField::batch)] = bitsOf(config.mBatch);
+        record[u(ResultField::complexityN)] = bitsOf(config.mComplexityN);
+        record[u(ResultField::epochs)] = config.mNumEpochs;
+        record[u(ResultField::clockResolutionMultiple)] = config.mClockResolutionMultiple;
+        record[u(ResultField::maxEpochTime)] = static_cast<uint64_t>(config.mMaxEpochTime.count());
+        record[u(ResultField::minEpochTime)] = static_cast<uint64_t>(config.mMinEpochTime.count());
+        record[u(ResultField::minEpochIterations)] = config.mMinEpochIterations;
+        record[u(ResultField::epochIterations)] = config.mEpochIterations;
+        record[u(ResultField::warmup)] = config.mWarmup;
+        record[u(ResultField::relative)] = config.mIsRelative ? 1U : 0U;
+        record[u(ResultField::outlierMethod)] = static_cast<uint64_t>(u(config.mOutlierMethod));
+        record[u(ResultField::has)] = has;
+        record[u(ResultField::numEpochs)] = 0U == has ? 0U : r.size();
+        record[u(ResultField::numContext)] = config.mContext.size();
+
+        for (auto const& variable : sortedContext(config)) {
+            record.push_back(intern(variable.first));
+            record.push_back(intern(variable.second));
+        }
+        records.push_back(std::move(record));
+    }
+    strings.resize((strings.size() + sizeof(uint64_t) - 1U) / sizeof(uint64_t) * sizeof(uint64_t), '\0');
+
+    auto const writeWords = [&out](uint64_t const* words, size_t numWords) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        out.write(reinterpret_cast<char const*>(words), static_cast<std::streamsize>(numWords * sizeof(uint64_t)));
+    };
+    std::array<uint64_t, resultFileHeaderWords> const header = {
+        {resultFileMagic(), 1U, UINT64_C(0x0102030405060708), numResults, strings.size() / sizeof(uint64_t)}};
+    writeWords(header.data(), header.size());
+    out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+
+    for (size_t i = 0; i < numResults; ++i) {
+        writeWords(records[i].data(), records[i].size());
+        auto const has = records[i][u(ResultField::has)];
+        for (size_t m = 0; m < u(Result::Measure::_size); ++m) {
+            if (0U != (has & (UINT64_C(1) << m))) {
+                // the epochs of a measure are contiguous already, so they go out in one piece
+                auto const range = results[i].measurements(static_cast<Result::Measure>(m));
+                static_assert(sizeof(double) == sizeof(uint64_t), "the format is 64-bit words");
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+                out.write(reinterpret_cast<char const*>(range.begin()), static_cast<std::streamsize>(range.size() * sizeof(double)));
+            }
+        }
+    }
+}
+
+} // namespace detail
+
+bool saveResults(std::string const& path, std::vector<Result> const& results) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    detail::writeResults(out, results.data(), results.size());
+    return static_cast<bool>(out);
+}
+
+bool saveResults(std::string const& path, Bench const& bench) {
+    return saveResults(path, bench.results());
+}
+
+ResultView::ResultView(uint64_t const* record, char const* strings) noexcept
+    : mRecord(record)
+    , mStrings(strings) {}
+
+uint64_t ResultView::field(size_t idx) const noexcept {
+    return mRecord[idx];
+}
+
+char const* ResultView::title() const noexcept {
+    return mStrings + field(detail::u(detail::ResultField::title));
+}
+
+char const* ResultView::name() const noexcept {
+    return mStrings + field(detail::u(detail::ResultField::name));
+}
+
+char const* ResultView::unit() const noexcept {
+    return mStrings + field(detail::u(detail::ResultField::unit));
+}
+
+Config ResultView::config() const {
+    using detail::ResultField;
+    using detail::u;
+
+    Config config;
+    config.mBenchmarkTitle = title();
+    config.mBenchmarkName = name();
+    config.mUnit = unit();
+    config.mBatch = detail::doubleOf(field(u(ResultField::batch)));
+    config.mComplexityN = detail::doubleOf(field(u(ResultField::complexityN)));
+    config.mNumEpochs = static_cast<size_t>(field(u(ResultField::epochs)));
+    config.mClockResolutionMultiple = static_cast<size_t>(field(u(ResultField::clockResolutionMultiple)));
+    config.mMaxEpochTime = std::chrono::nanoseconds(static_cast<int64_t>(field(u(ResultField::maxEpochTime))));
+    config.mMinEpochTime = std::chrono::nanoseconds(static_cast<int64_t>(field(u(ResultField::minEpochTime))));
+    config.mMinEpochIterations = field(u(ResultField::minEpochIterations));
+    config.mEpochIterations = field(u(ResultField::epochIterations));
+    config.mWarmup = field(u(ResultField::warmup));
+    config.mIsRelative = 0U != field(u(ResultField::relative));
+    config.mOutlierMethod = static_cast<OutlierMethod>(field(u(ResultField::outlierMethod)));
+    auto const* const context = mRecord + u(ResultField::_size);
+    for (size_t i = 0; i < field(u(ResultField::numContext)); ++i) {
+        config.mContext[mStrings + context[2U * i]] = mStrings + context[2U * i + 1U];
+    }
+    return config;
+}
+
+size_t ResultView::size() const noexcept {
+    return static_cast<size_t>(field(detail::u(detail::ResultField::numEpochs)));
+}
+
+bool ResultView::has(Result::Measure m) const noexcept {
+    return m < Result::Measure::_size && 0U != (field(detail::u(detail::ResultField::has)) & (UINT64_C(1) << detail::u(m)));
+}
+
+double const* ResultView::measure(Result::Measure m) const noexcept {
+    using detail::ResultField;
+    using detail::u;
+    if (!has(m)) {
+        return nullptr;
+    }
+    // the arrays of the recorded measures before this one come first
+    auto const before = field(u(ResultField::has)) & ((UINT64_C(1) << u(m)) - 1U);
+    auto const* const first = mRecord + u(ResultField::_size) + 2U * field(u(ResultField::numContext)) + detail::numMeasures(before) * size();
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return reinterpret_cast<double const*>(first);
+}
+
+Result ResultView::toResult() const {
+    Result r{config()};
+    auto const numEpochs = size();
+    r.storeMeasures(static_cast<uint32_t>(field(detail::u(detail::ResultField::has))));
+    r.reserveEpochs(numEpochs);
+    for (size_t m = 0; m < detail::u(Result::Measure::_size); ++m) {
+        if (auto const* const values = measure(static_cast<Result::Measure>(m))) {
+            std::copy(values, values + numEpochs, r.mMeasurements.data() + r.slotOf(m) * r.mCapacity);
+            r.mHas |= UINT32_C(1) << m;
+        }
+    }
+    r.mNumEpochs = numEpochs;
+    return r;
+}
 
-    std::vector<CompareResult::Entry> entries;
-    entries.reserve(numOps);
-    entries.emplace_back(names[0], std::move(results[0]), 1.0, 1.0, 1.0, static_cast<size_t>(0));
-    for (size_t i = 1; i < numOps; ++i) {
-        // ln(t_baseline) - ln(t_i), so a positive difference means the alternative was quicker and
-        // the ratio comes out above 1 - the same direction relative() reports. The baseline was moved
-        // into entries[0] above, which is where it is read from now.
-        auto const logRatios = detail::pairedLogRatios(entries[0].result, results[i]);
-        auto const interval = detail::medianInterval(logRatios, confidence);
-        entries.emplace_back(names[i], std::move(results[i]), std::exp(detail::medianOf(logRatios)), std::exp(interval.first),
-                             std::exp(interval.second), detail::countTiedRounds(logRatios));
+namespace detail {
+
+// Whether `path` is a file rather than a directory or a device, which an ifstream opens just as well
+// but has no size to read. Wherever there is no stat(), the stream's own failures have to tell.
+static bool isRegularFile(std::string const& path) {
+#    if defined(__unix__) || defined(__APPLE__)
+    struct stat st {};
+    return 0 == ::stat(path.c_str(), &st) && S_ISREG(st.st_mode);
+#    else
+    (void)path;
+    return true;
+#    endif
+}
+
+} // namespace detail
+
+ResultFile::ResultFile(std::string const& path) {
+    uint64_t const* words = nullptr;
+    size_t numWords = 0;
+#    if defined(__unix__) || defined(__APPLE__)
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+    auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        struct stat st {};
+        auto const isStat = 0 == ::fstat(fd, &st);
+        if (!isStat || !S_ISREG(st.st_mode)) {
+            // a directory opens as well, but has no bytes to map or read
+            ::close(fd);
+            return;
+        }
+        if (st.st_size > 0) {
+            auto const bytes = static_cast<size_t>(st.st_size);
+            auto* const mapped = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast,performance-no-int-to-ptr)
+            if (MAP_FAILED != mapped) {
+                mMapped = mapped;
+                mMappedBytes = bytes;
+                words = static_cast<uint64_t const*>(mapped);
+                numWords = bytes / sizeof(uint64_t);
+            }
+        }
+        ::close(fd);
+    }
+#    endif
+    if (nullptr == mMapped) {
+        // no mmap() here, or it failed: read it instead, into words so that the doubles are aligned
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        auto const end = in ? static_cast<std::streamoff>(in.tellg()) : std::streamoff(0);
+        auto const bytes = in && end > 0 ? end : std::streamoff(0);
+        mBuffer.resize(static_cast<size_t>(bytes) / sizeof(uint64_t));
+        in.seekg(0);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        if (!in.read(reinterpret_cast<char*>(mBuffer.data()), static_cast<std::streamsize>(mBuffer.size() * sizeof(uint64_t)))) {
+            mBuffer.clear();
+        }
+        words = mBuffer.data();
+        numWords = mBuffer.size();
     }
+    mIsValid = detail::indexResultFile(words, numWords, mStrings, mRecords);
+    if (!mIsValid) {
+        mRecords.clear();
+    }
+}
 
-    CompareResult compareResult{std::move(entries), numRounds};
-    if (nullptr != output()) {
-        *output() << compareResult;
+ResultFile::~ResultFile() {
+#    if defined(__unix__) || defined(__APPLE__)
+    if (nullptr != mMapped) {
+        ::munmap(mMapped, mMappedBytes);
     }
-    return compareResult;
+#    endif
+}
+
+bool ResultFile::valid() const noexcept {
+    return mIsValid;
+}
+
+size_t ResultFile::size() const noexcept {
+    return mRecords.size();
+}
+
+ResultView ResultFile::operator[](size_t idx) const noexcept {
+    return ResultView(mRecords[idx], mStrings);
+}
+
+std::vector<Result> ResultFile::results() const {
+    std::vector<Result> results;
+    results.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+        results.push_back((*this)[i].toResult());
+    }
+    return results;
+}
+
+namespace detail {
+
+CheckpointLog::CheckpointLog(std::string path)
+    : mPath(std::move(path)) {
+    std::ifstream in(mPath, std::ios::binary | std::ios::ate);
+    auto const end = in ? static_cast<std::streamoff>(in.tellg()) : std::streamoff(-1);
+    if (end <= 0) {
+        return;
+    }
+    auto const fileBytes = static_cast<uint64_t>(end);
+    auto const fileWords = fileBytes / sizeof(uint64_t);
+    in.seekg(0);
+
+    // One saveResults() file after the other, each read as far as its header and records say it goes,
+    // and then checked as a whole. Only one of them is in memory at a time.
+    std::vector<uint64_t> words;
+    uint64_t offset = 0;
+    auto const read = [&](uint64_t numWords) {
+        if (numWords > fileWords - offset - words.size()) {
+            return false;
+        }
+        auto const had = words.size();
+        words.resize(had + static_cast<size_t>(numWords));
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(words.data() + had), static_cast<std::streamsize>(numWords * sizeof(uint64_t))));
+    };
+    char const* strings = nullptr;
+    std::vector<uint64_t const*> records;
+    while (offset < fileWords) {
+        words.clear();
+        auto isComplete = read(resultFileHeaderWords) && read(words[4]);
+        for (uint64_t i = 0; isComplete && i < words[3]; ++i) {
+            auto const record = words.size();
+            isComplete = read(u(ResultField::_size)) && read(2U * words[record + u(ResultField::numContext)]) &&
+                         read(numMeasures(words[record + u(ResultField::has)]) * words[record + u(ResultField::numEpochs)]);
+        }
+        if (!isComplete || !indexResultFile(words.data(), words.size(), strings, records)) {
+            break;
+        }
+        for (size_t i = 0; i < records.size(); ++i) {
+            mEntries[checkpointKey(ResultView(records[i], strings).config())].push_back(Entry{offset, words.size(), i});
+        }
+        offset += words.size();
+    }
+    in.close();
+
+    // Without a single complete result this is not a checkpoint - something else, the other byte
+    // order, an older format, or the wrong path - and it is not for nanobench to overwrite.
+    if (0U == offset) {
+        std::cerr << "nanobench: '" << mPath << "' is not a checkpoint file, not using it" << std::endl;
+        mIsOff = true;
+        return;
+    }
+
+    // What follows the last complete result was cut short by a process killed while appending it.
+    // Results appended after it would never be found, so it is cut off before anything is.
+    auto const validBytes = offset * sizeof(uint64_t);
+    if (validBytes < fileBytes) {
+        std::ifstream from(mPath, std::ios::binary);
+        std::string valid(static_cast<size_t>(validBytes), '\0');
+        from.read(&valid[0], static_cast<std::streamsize>(valid.size()));
+        auto const tmpPath = mPath + ".tmp";
+        {
+            std::ofstream to(tmpPath, std::ios::binary | std::ios::trunc);
+            to.write(valid.data(), static_cast<std::streamsize>(valid.size()));
+        }
+        if (!from || !renameOver(tmpPath, mPath)) {
+            std::cerr << "nanobench: could not write to '" << mPath << "'" << std::endl;
+        }
+    }
+}
+
+// The checkpoint files this process has opened, see Bench::checkpoint().
+static std::unordered_map<std::string, CheckpointLog>& checkpointLogs() {
+#    if defined(__clang__)
+#        pragma clang diagnostic push
+#        pragma clang diagnostic ignored "-Wexit-time-destructors"
+#    endif
+    static std::unordered_map<std::string, CheckpointLog> logs;
+#    if defined(__clang__)
+#        pragma clang diagnostic pop
+#    endif
+    return logs;
+}
+
+CheckpointLog& CheckpointLog::of(std::string const& path) {
+    auto& logs = checkpointLogs();
+    auto it = logs.find(path);
+    if (it == logs.end()) {
+        it = logs.emplace(path, CheckpointLog(path)).first;
+    }
+    return it->second;
+}
+
+void CheckpointLog::forget(std::string const& path) {
+    checkpointLogs().erase(path);
+}
+
+bool CheckpointLog::restore(Config const& config, Result& result) {
+    auto const key = checkpointKey(config);
+    auto const run = mNumRuns[key]++;
+    auto const it = mEntries.find(key);
+    if (it == mEntries.end() || run >= it->second.size()) {
+        return false;
+    }
+
+    // read and checked again, since the file may have changed since it was opened
+    auto const& entry = it->second[run];
+    std::vector<uint64_t> words(static_cast<size_t>(entry.size));
+    std::ifstream in(mPath, std::ios::binary);
+    in.seekg(static_cast<std::streamoff>(entry.offset * sizeof(uint64_t)));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    in.read(reinterpret_cast<char*>(words.data()), static_cast<std::streamsize>(words.size() * sizeof(uint64_t)));
+    char const* strings = nullptr;
+    std::vector<uint64_t const*> records;
+    if (!in || !indexResultFile(words.data(), words.size(), strings, records) || entry.index >= records.size()) {
+        return false;
+    }
+    result = withEpochsOf(config, ResultView(records[entry.index], strings).toResult());
+    return true;
+}
+
+bool CheckpointLog::append(Result const& result) const {
+    if (mIsOff) {
+        return true;
+    }
+    std::ofstream out(mPath, std::ios::binary | std::ios::app);
+    writeResults(out, &result, 1U);
+    return static_cast<bool>(out);
+}
+
+} // namespace detail
+
+// Reading results back /////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+Result resultOfEpochs(Config config, std::vector<double> const& epochs, size_t numEpochs, uint32_t has) {
+    Result r{std::move(config)};
+    r.storeMeasures(has);
+    r.reserveEpochs(numEpochs);
+    for (size_t m = 0; m < u(Result::Measure::_size); ++m) {
+        if (0U != (has & (UINT32_C(1) << m))) {
+            auto const first = epochs.begin() + static_cast<std::ptrdiff_t>(m * numEpochs);
+            std::copy(first, first + static_cast<std::ptrdiff_t>(numEpochs),
+                      r.mMeasurements.begin() + static_cast<std::ptrdiff_t>(r.slotOf(m) * r.mCapacity));
+        }
+    }
+    r.mHas = has;
+    r.mNumEpochs = numEpochs;
+    return r;
+}
+
+// Just enough JSON to read back what nanobench writes. That includes the json template's `nan` and
+// `inf`, which are not JSON but are what a stream writes for a statistic of no epochs.
+ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
+struct JsonValue {
+    enum class Type { null, boolean, number, string, array, object };
+
+    Type type = Type::null;
+    double number = 0.0;
+    std::string string{};
+    std::vector<JsonValue> elements{};
+    std::vector<std::pair<std::string, JsonValue>> members{};
+
+    ANKERL_NANOBENCH(NODISCARD) JsonValue const* find(char const* key) const {
+        for (auto const& member : members) {
+            if (member.first == key) {
+                return &member.second;
+            }
+        }
+        return nullptr;
+    }
+};
+ANKERL_NANOBENCH(IGNORE_PADDED_POP)
+
+class JsonParser {
+public:
+    explicit JsonParser(std::string const& text)
+        : mText(text) {}
+
+    // False at the end of the text, which is where a JSON Lines file is allowed to stop.
+    bool next(JsonValue& value) {
+        skipWhitespace();
+        if (mPos == mText.size()) {
+            return false;
+        }
+        value = parseValue();
+        return true;
+    }
+
+private:
+    [[noreturn]] void fail(char const* what) const {
+        ANKERL_NANOBENCH_THROW(std::runtime_error(std::string("loadResults: ") + what + " at offset " + fmt::to_s(mPos)));
+    }
+
+    void skipWhitespace() {
+        while (mPos < mText.size() && std::isspace(static_cast<unsigned char>(mText[mPos])) != 0) {
+            ++mPos;
+        }
+    }
+
+    bool consume(char c) {
+        skipWhitespace();
+        if (mPos < mText.size() && mText[mPos] == c) {
+            ++mPos;
+            return true;
+        }
+        return false;
+    }
+
+    bool consumeWord(char const* word) {
+        auto const len = std::strlen(word);
+        if (0 == mText.compare(mPos, len, word)) {
+            mPos += len;
+            return true;
+        }
+        return false;
+    }
+
+    static JsonValue makeValue(JsonValue::Type type) {
+        JsonValue value;
+        value.type = type;
+        return value;
+    }
+
+    // NOLINTNEXTLINE(misc-no-recursion)
+    JsonValue parseValue() {
+        skipWhitespace();
+        if (mPos == mText.size()) {
+            fail("unexpected end");
+        }
+        switch (mText[mPos]) {
+        case '{':
+            return parseObject();
+        case '[':
+            return parseArray();
+        case '"': {
+            auto value = makeValue(JsonValue::Type::string);
+            value.string = parseString();
+            return value;
+        }
+        default:
+            break;
+        }
+        if (consumeWord("true")) {
+            auto value = makeValue(JsonValue::Type::boolean);
+            value.number = 1.0;
+            return value;
+        }
+        if (consumeWord("false")) {
+            return makeValue(JsonValue::Type::boolean);
+        }
+        if (consumeWord("null")) {
+            return makeValue(JsonValue::Type::null);
+        }
+        return parseNumber();
+    }
+
+    // NOLINTNEXTLINE(misc-no-recursion)
+    JsonValue parseObject() {
+        auto value = makeValue(JsonValue::Type::object);
+        ++mPos;
+        if (consume('}')) {
+            return value;
+        }
+        do {
+            skipWhitespace();
+            if (mPos == mText.size() || mText[mPos] != '"') {
+                fail("expected a key");
+            }
+            auto key = parseString();
+            if (!consume(':')) {
+                fail("expected ':'");
+            }
+            value.members.emplace_back(std::move(key), parseValue());
+        } while (consume(','));
+        if (!consume('}')) {
+            fail("expected ',' or '}'");
+        }
+        return value;
+    }
+
+    // NOLINTNEXTLINE(misc-no-recursion)
+    JsonValue parseArray() {
+        auto value = makeValue(JsonValue::Type::array);
+        ++mPos;
+        if (consume(']')) {
+            return value;
+        }
+        do {
+            value.elements.push_back(parseValue());
+        } while (consume(','));
+        if (!consume(']')) {
+            fail("expected ',' or ']'");
+        }
+        return value;
+    }
+
+    std::string parseString() {
+        std::string str;
+        ++mPos;
+        while (mPos < mText.size() && mText[mPos] != '"') {
+            auto c = mText[mPos++];
+            if ('\\' == c && mPos < mText.size()) {
+                c = mText[mPos++];
+                switch (c) {
+                case 'n':
+                    c = '\n';
+                    break;
+                case 't':
+                    c = '\t';
+                    break;
+                case 'r':
+                    c = '\r';
+                    break;
+                case 'b':
+                    c = '\b';
+                    break;
+                case 'f':
+                    c = '\f';
+                    break;
+                case 'u':
+                    appendUtf8(str, parseCodePoint());
+                    continue;
+                default:
+                    // \" \\ \/ stand for themselves
+                    break;
+                }
+            }
+            str += c;
+        }
+        if (mPos == mText.size()) {
+            fail("unterminated string");
+        }
+        ++mPos;
+        return str;
+    }
+
+    // The four hex digits of a \u escape, the \u already read.
+    uint32_t parseHexEscape() {
+        if (mText.size() - mPos < 4U) {
+            fail("truncated \\u escape");
+        }
+        uint32_t code = 0;
+        for (size_t i = 0; i < 4U; ++i) {
+            auto const c = mText[mPos + i];
+            uint32_t digit = 0;
+            if (c >= '0' && c <= '9') {
+                digit = static_cast<uint32_t>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                digit = static_cast<uint32_t>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                digit = static_cast<uint32_t>(c - 'A' + 10);
+            } else {
+                mPos += i;
+                fail("expected a hex digit");
+            }
+            code = code * 16U + digit;
+        }
+        mPos += 4U;
+        return code;
+    }
+
+    // nanobench only escapes control characters this way, but other writers - Google Benchmark's
+    // among them - escape any character, and those outside the basic plane as a surrogate pair. A
+    // surrogate without its other half is no character, and reads as U+FFFD.
+    uint32_t parseCodePoint() {
+        auto const code = parseHexEscape();
+        if (code < 0xd800U || code > 0xdfffU) {
+            return code;
+        }
+        if (code < 0xdc00U && mText.compare(mPos, 2U, "\\u") == 0) {
+            auto const begin = mPos;
+            mPos += 2U;
+            auto const low = parseHexEscape();
+            if (low >= 0xdc00U && low <= 0xdfffU) {
+                return 0x10000U + ((code - 0xd800U) << 10U) + (low - 0xdc00U);
+            }
+            // not the other half, so it is read on its own
+            mPos = begin;
+        }
+        return 0xfffdU;
+    }
+
+    static void appendUtf8(std::string& str, uint32_t code) {
+        if (code < 0x80U) {
+            str += static_cast<char>(code);
+        } else if (code < 0x800U) {
+            str += static_cast<char>(0xc0U | (code >> 6U));
+            str += static_cast<char>(0x80U | (code & 0x3fU));
+        } else if (code < 0x10000U) {
+            str += static_cast<char>(0xe0U | (code >> 12U));
+            str += static_cast<char>(0x80U | ((code >> 6U) & 0x3fU));
+            str += static_cast<char>(0x80U | (code & 0x3fU));
+        } else {
+            str += static_cast<char>(0xf0U | (code >> 18U));
+            str += static_cast<char>(0x80U | ((code >> 12U) & 0x3fU));
+            str += static_cast<char>(0x80U | ((code >> 6U) & 0x3fU));
+            str += static_cast<char>(0x80U | (code & 0x3fU));
+        }
+    }
+
+    JsonValue parseNumber() {
+        auto value = makeValue(JsonValue::Type::number);
+        auto const begin = mPos;
+        while (mPos < mText.size() && nullptr != std::strchr("+-.0123456789eEinfaINFA", mText[mPos]) && '\0' != mText[mPos]) {
+            ++mPos;
+        }
+        auto const token = mText.substr(begin, mPos - begin);
+        auto const sign = (!token.empty() && '-' == token[0]) ? -1.0 : 1.0;
+        auto const unsignedToken = token.substr(token.empty() || (token[0] != '-' && token[0] != '+') ? 0U : 1U);
+        if ("nan" == unsignedToken || "NAN" == unsignedToken) {
+            value.number = std::numeric_limits<double>::quiet_NaN();
+            return value;
+        }
+        if ("inf" == unsignedToken || "INF" == unsignedToken) {
+            value.number = sign * std::numeric_limits<double>::infinity();
+            return value;
+        }
+        // a stream with the classic locale, since strtod() would read "1.5" by the global one
+        std::istringstream in(token);
+        in.imbue(std::locale::classic());
+        if (token.empty() || !(in >> value.number) || in.peek() != std::char_traits<char>::eof()) {
+            mPos = begin;
+            fail("expected a value");
+        }
+        return value;
+    }
+
+    std::string const& mText;
+    size_t mPos = 0;
+};
+
+static double numberOr(JsonValue const& object, char const* key, double defaultValue) {
+    auto const* const value = object.find(key);
+    return nullptr != value && (JsonValue::Type::number == value->type || JsonValue::Type::boolean == value->type)
+               ? value->number
+               : defaultValue;
+}
+
+template <typename T>
+static T countOr(JsonValue const& object, char const* key, T defaultValue) {
+    return static_cast<T>(numberOr(object, key, static_cast<double>(defaultValue)));
+}
+
+static std::string stringOr(JsonValue const& object, char const* key, std::string const& defaultValue) {
+    auto const* const value = object.find(key);
+    return nullptr != value && JsonValue::Type::string == value->type ? value->string : defaultValue;
+}
+
+// Times are written in seconds.
+static std::chrono::nanoseconds durationOr(JsonValue const& object, char const* key, std::chrono::nanoseconds defaultValue) {
+    auto const seconds = numberOr(object, key, std::chrono::duration<double>(defaultValue).count());
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(seconds));
+}
+
+static Result resultFromJson(JsonValue const& object) {
+    Config config;
+    config.mBenchmarkTitle = stringOr(object, "title", config.mBenchmarkTitle);
+    config.mBenchmarkName = stringOr(object, "name", config.mBenchmarkName);
+    config.mUnit = stringOr(object, "unit", config.mUnit);
+    config.mBatch = numberOr(object, "batch", config.mBatch);
+    config.mComplexityN = numberOr(object, "complexityN", config.mComplexityN);
+    config.mNumEpochs = countOr(object, "epochs", config.mNumEpochs);
+    config.mClockResolutionMultiple = countOr(object, "clockResolutionMultiple", config.mClockResolutionMultiple);
+    config.mMaxEpochTime = durationOr(object, "maxEpochTime", config.mMaxEpochTime);
+    config.mMinEpochTime = durationOr(object, "minEpochTime", config.mMinEpochTime);
+    config.mMinEpochIterations = countOr(object, "minEpochIterations", config.mMinEpochIterations);
+    config.mEpochIterations = countOr(object, "epochIterations", config.mEpochIterations);
+    config.mWarmup = countOr(object, "warmup", config.mWarmup);
+    config.mIsRelative = numberOr(object, "relative", 0.0) > 0.0;
+    if (auto const* const context = object.find("context")) {
+        for (auto const& variable : context->members) {
+            config.mContext[variable.first] = variable.second.string;
+        }
+    }
+
+    std::vector<JsonValue> const none;
+    auto const* const measurements = object.find("measurements");
+    auto const& epochObjects = nullptr != measurements ? measurements->elements : none;
+    auto const numEpochs = epochObjects.size();
+    auto const numMeasures = u(Result::Measure::_size);
+    std::vector<double> epochs(numMeasures * numEpochs);
+    uint32_t has = 0;
+    for (size_t m = 0; m < numMeasures; ++m) {
+        auto const measure = static_cast<Result::Measure>(m);
+        bool isRecorded = false;
+        for (size_t i = 0; i < numEpochs; ++i) {
+            auto& value = epochs[m * numEpochs + i];
+            // null is an epoch of a merged result that has no value for a measure the others have
+            auto const* const found = epochObjects[i].find(measureName(measure));
+            auto const isNull = nullptr != found && JsonValue::Type::null == found->type;
+            value = isNull ? std::numeric_limits<double>::quiet_NaN() : numberOr(epochObjects[i], measureName(measure), 0.0);
+            isRecorded = isRecorded || value < 0.0 || value > 0.0;
+        }
+        // elapsed and iterations are always measured, even the rare epoch that reads 0 for them
+        if (numEpochs > 0U && (isRecorded || Result::Measure::elapsed == measure || Result::Measure::iterations == measure)) {
+            has |= UINT32_C(1) << m;
+        }
+    }
+    return resultOfEpochs(std::move(config), epochs, numEpochs, has);
+}
+
+// Seconds per time_unit of Google Benchmark's JSON, 0 for one it does not have.
+static double secondsPer(std::string const& timeUnit) {
+    if ("ns" == timeUnit) {
+        return 1e-9;
+    }
+    if ("us" == timeUnit) {
+        return 1e-6;
+    }
+    if ("ms" == timeUnit) {
+        return 1e-3;
+    }
+    if ("s" == timeUnit) {
+        return 1.0;
+    }
+    return 0.0;
+}
+
+// Google Benchmark puts a benchmark's arguments into its name, "BM_sort/8" or "BM_sort/size:8". The
+// named ones are what templates::googleBenchmark() writes the context as, so they go back into the
+// context, and the rest stays in the name. A "::" is C++, not an argument.
+static void splitGoogleBenchmarkName(std::string const& runName, Config& config) {
+    std::string name;
+    size_t begin = 0;
+    while (begin <= runName.size()) {
+        auto end = runName.find('/', begin);
+        if (std::string::npos == end) {
+            end = runName.size();
+        }
+        auto const segment = runName.substr(begin, end - begin);
+        auto const colon = segment.find(':');
+        if (begin > 0U && std::string::npos != colon && std::string::npos == segment.find("::")) {
+            config.mContext[segment.substr(0, colon)] = segment.substr(colon + 1U);
+        } else {
+            name += (name.empty() ? "" : "/") + segment;
+        }
+        begin = end + 1U;
+    }
+    config.mBenchmarkName = name;
+}
+
+ANKERL_NANOBENCH(IGNORE_PADDED_PUSH)
+struct GoogleBenchmarkRuns {
+    std::string key;
+    Config config;
+    std::vector<std::vector<double>> epochs; // each a value per Result::Measure
+};
+ANKERL_NANOBENCH(IGNORE_PADDED_POP)
+
+// Every repetition of a benchmark is an epoch of its result, so that nanobench's statistics are over
+// the same samples Google Benchmark's are. The aggregates are computed from those, so they are left
+// out, and so are runs that report an error.
+static void appendGoogleBenchmarkResults(JsonValue const& benchmarks, std::vector<Result>& results) {
+    std::vector<GoogleBenchmarkRuns> runs;
+    auto const numMeasures = u(Result::Measure::_size);
+    for (auto const& run : benchmarks.elements) {
+        if ("aggregate" == stringOr(run, "run_type", "iteration") || nullptr != run.find("aggregate_name") ||
+            numberOr(run, "error_occurred", 0.0) > 0.0) {
+            continue;
+        }
+        Config config;
+        config.mBenchmarkTitle = stringOr(run, "title", config.mBenchmarkTitle);
+        config.mUnit = stringOr(run, "unit", config.mUnit);
+        config.mBatch = numberOr(run, "batch", config.mBatch);
+        config.mComplexityN = numberOr(run, "complexityN", config.mComplexityN);
+        auto const runName = stringOr(run, "run_name", stringOr(run, "name", ""));
+        splitGoogleBenchmarkName(runName, config);
+
+        auto const key = config.mBenchmarkTitle + '\n' + runName;
+        auto it = std::find_if(runs.begin(), runs.end(), [&](GoogleBenchmarkRuns const& r) {
+            return r.key == key;
+        });
+        if (it == runs.end()) {
+            runs.push_back(GoogleBenchmarkRuns{key, config, {}});
+            it = runs.end() - 1;
+        }
+
+        std::vector<double> epoch(numMeasures);
+        for (size_t m = 0; m < numMeasures; ++m) {
+            epoch[m] = numberOr(run, measureName(static_cast<Result::Measure>(m)), 0.0);
+        }
+        epoch[u(Result::Measure::iterations)] = numberOr(run, "iterations", 0.0);
+        epoch[u(Result::Measure::elapsed)] = numberOr(run, "real_time", 0.0) * secondsPer(stringOr(run, "time_unit", "ns"));
+        it->epochs.push_back(std::move(epoch));
+    }
+
+    for (auto& r : runs) {
+        auto const numEpochs = r.epochs.size();
+        std::vector<double> epochs(numMeasures * numEpochs);
+        uint32_t has = (UINT32_C(1) << u(Result::Measure::elapsed)) | (UINT32_C(1) << u(Result::Measure::iterations));
+        for (size_t m = 0; m < numMeasures; ++m) {
+            for (size_t i = 0; i < numEpochs; ++i) {
+                auto const value = r.epochs[i][m];
+                epochs[m * numEpochs + i] = value;
+                // as in any JSON, a counter that is 0 throughout was not recorded
+                if (value < 0.0 || value > 0.0) {
+                    has |= UINT32_C(1) << m;
+                }
+            }
+        }
+        r.config.mNumEpochs = numEpochs;
+        results.push_back(resultOfEpochs(std::move(r.config), epochs, numEpochs, has));
+    }
+}
+
+std::vector<Result> resultsFromJson(std::string const& text) {
+    std::vector<Result> results;
+    JsonParser parser(text);
+    JsonValue value;
+    while (parser.next(value)) {
+        if (JsonValue::Type::object != value.type) {
+            ANKERL_NANOBENCH_THROW(std::runtime_error("loadResults: expected an object for each result"));
+        }
+        if (auto const* const benchmarks = value.find("benchmarks")) {
+            appendGoogleBenchmarkResults(*benchmarks, results);
+            continue;
+        }
+        auto const* const list = value.find("results");
+        if (nullptr == list) {
+            results.push_back(resultFromJson(value));
+            continue;
+        }
+        for (auto const& element : list->elements) {
+            results.push_back(resultFromJson(element));
+        }
+    }
+    return results;
+}
+
+std::string mergeMismatch(Config const& a, Config const& b) {
+    auto const keyA = baselineKey(a);
+    auto const keyB = baselineKey(b);
+    if (keyA != keyB) {
+        return "'" + keyA + "' and '" + keyB + "' are different benchmarks";
+    }
+    if (a.mUnit != b.mUnit) {
+        return "'" + keyA + "' is per '" + a.mUnit + "' in one and per '" + b.mUnit + "' in the other";
+    }
+    if (a.mBatch < b.mBatch || a.mBatch > b.mBatch) {
+        return "'" + keyA + "' has a different batch in each";
+    }
+    return {};
+}
+
+} // namespace detail
+
+Result& Result::merge(Result const& other) {
+    if (streaming() || other.streaming()) {
+        ANKERL_NANOBENCH_THROW(std::runtime_error("Result::merge: a streaming result has no epochs to merge"));
+    }
+    auto const mismatch = detail::mergeMismatch(*mConfig, *other.mConfig);
+    if (!mismatch.empty()) {
+        ANKERL_NANOBENCH_THROW(std::runtime_error("Result::merge: " + mismatch));
+    }
+
+    // A measure only one side recorded is kept, with NaN in the epochs of the other side, which every
+    // statistic leaves out. An empty side has no epochs that lack anything.
+    auto const has = 0U == mNumEpochs ? other.mHas : 0U == other.mNumEpochs ? mHas : (mHas | other.mHas);
+    storeMeasures(has);
+    mHas = has;
+    // mergeResults() merges one repetition after another into the same result, so the room grows
+    // geometrically rather than by exactly what each one brings
+    auto const needed = mNumEpochs + other.mNumEpochs;
+    if (needed > mCapacity) {
+        reserveEpochs((std::max)(needed, 2U * mCapacity));
+    }
+    for (size_t m = 0; m < detail::u(Measure::_size); ++m) {
+        if (0U != (mHas & (UINT32_C(1) << m))) {
+            auto* const to = mMeasurements.data() + slotOf(m) * mCapacity + mNumEpochs;
+            auto const range = other.measurements(static_cast<Measure>(m));
+            if (range.empty()) {
+                std::fill(to, to + other.mNumEpochs, std::numeric_limits<double>::quiet_NaN());
+            } else {
+                std::copy(range.begin(), range.end(), to);
+            }
+        }
+    }
+    mNumEpochs += other.mNumEpochs;
+    return *this;
+}
+
+std::vector<Result> loadResults(std::string const& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in || !detail::isRegularFile(path)) {
+        ANKERL_NANOBENCH_THROW(std::runtime_error("loadResults: could not read '" + path + "'"));
+    }
+
+    // The magic alone tells the formats apart. A binary file is mapped by ResultFile, so only the
+    // text formats are read into memory.
+    std::string magic(8, '\0');
+    in.read(&magic[0], static_cast<std::streamsize>(magic.size()));
+    magic.resize(static_cast<size_t>(in.gcount()));
+    if (magic == "nanobnch") {
+        in.close();
+        ResultFile const file(path);
+        if (!file.valid()) {
+            ANKERL_NANOBENCH_THROW(std::runtime_error("loadResults: '" + path + "' is not a complete result file"));
+        }
+        return file.results();
+    }
+    in.clear();
+    in.seekg(0, std::ios::end);
+    auto const end = static_cast<std::streamoff>(in.tellg());
+    if (!in || end < 0) {
+        ANKERL_NANOBENCH_THROW(std::runtime_error("loadResults: could not read '" + path + "'"));
+    }
+    std::string text(static_cast<size_t>(end), '\0');
+    in.seekg(0);
+    in.read(&text[0], static_cast<std::streamsize>(text.size()));
+    if (!in) {
+        ANKERL_NANOBENCH_THROW(std::runtime_error("loadResults: could not read '" + path + "'"));
+    }
+    return detail::resultsFromJson(text);
+}
+
+std::vector<Result> mergeResults(std::vector<Result> const& results) {
+    std::vector<Result> merged;
+    std::unordered_map<std::string, size_t> indexOf;
+    for (auto const& r : results) {
+        auto const key = detail::baselineKey(r.config());
+        auto it = indexOf.find(key);
+        if (it == indexOf.end()) {
+            indexOf.emplace(key, merged.size());
+            merged.push_back(r);
+        } else {
+            merged[it->second].merge(r);
+        }
+    }
+    return merged;
 }
 
-void Bench::compareEpoch(detail::ErasedOp const& op, uint64_t numIters, Result& result) {
-    auto& pc = detail::performanceCounters();
-
-    pc.beginMeasure();
-    Clock::time_point const before = Clock::now();
-    op.run(op.op, numIters);
-    Clock::time_point const after = Clock::now();
-    pc.endMeasure();
-    pc.updateResults(numIters);
+// HtmlReport //////////////////////////////////////////////////////////////////////////////////////
 
-    result.add(after - before, numIters, pc);
+namespace detail {
+namespace html {
+
+// Everything is drawn into a plot area this wide, with the labels to the left of it.
+constexpr double svgWidth = 800.0;
+constexpr double plotLeft = 210.0;
+constexpr double plotRight = 780.0;
+constexpr double rowHeight = 22.0;
+constexpr double axisHeight = 34.0;
+
+// A palette that stays apart for the colorblind, for the series of the scatter plots.
+char const* const colors[] = {"#4477aa", "#ee6677", "#228833", "#ccbb44", "#66ccee", "#aa3377", "#bbbbbb", "#332288"};
+
+static std::string escape(std::string const& text) {
+    std::string escaped;
+    for (auto c : text) {
+        switch (c) {
+        case '&':
+            escaped += "&amp;";
+            break;
+        case '<':
+            escaped += "&lt;";
+            break;
+        case '>':
+            escaped += "&gt;";
+            break;
+        case '"':
+            escaped += "&quot;";
+            break;
+        default:
+            escaped += c;
+            break;
+        }
+    }
+    return escaped;
 }
 
-std::vector<double> const& Result::measurements(Measure m) const {
-    return mNameToMeasurements.at(detail::u(m));
+// Three significant digits are all a label has room for. The tooltips have them too, the table has
+// the rest.
+static std::string number(double value) {
+    std::ostringstream oss;
+    oss.imbue(std::locale::classic());
+    oss << std::setprecision(3) << value;
+    return oss.str();
 }
 
-double Result::median(Measure m) const {
-    // create a copy so we can sort
-    auto data = measurements(m);
-    return calcMedian(data);
+static std::string duration(double seconds) {
+    static char const* const units[] = {"s", "ms", "us", "ns"};
+    size_t idx = 0;
+    while (idx + 1U < sizeof(units) / sizeof(units[0]) && seconds < 1.0 && seconds > 0.0) {
+        seconds *= 1000.0;
+        ++idx;
+    }
+    return number(seconds) + units[idx];
 }
 
-double Result::average(Measure m) const {
-    using detail::d;
-    auto const& data = measurements(m);
-    if (data.empty()) {
-        return 0.0;
+// Maps values onto the pixels from..to. Logarithmic when the values are too far apart for a linear
+// axis to show the small ones as anything but 0.
+class Axis {
+public:
+    Axis(double lo, double hi, double from, double to, bool allowLog)
+        : mIsLog(allowLog && lo > 0.0 && hi > 20.0 * lo)
+        , mFrom(from)
+        , mTo(to) {
+        if (mIsLog) {
+            mLo = std::log(lo / 1.2);
+            mHi = std::log(hi * 1.2);
+        } else {
+            // from 0, so that a difference looks as big as it is
+            mLo = 0.0;
+            mHi = hi > 0.0 ? hi * 1.05 : 1.0;
+        }
     }
 
-    return sum(m) / d(data.size());
-}
+    ANKERL_NANOBENCH(NODISCARD) double operator()(double value) const {
+        auto const v = mIsLog ? std::log((std::max)(value, 1e-300)) : value;
+        return mFrom + (v - mLo) / (mHi - mLo) * (mTo - mFrom);
+    }
 
-double Result::medianAbsolutePercentError(Measure m) const {
-    // create copy
-    auto data = measurements(m);
+    // Evenly spaced along the axis, whatever its scale.
+    ANKERL_NANOBENCH(NODISCARD) std::vector<double> ticks() const {
+        std::vector<double> values;
+        for (size_t i = 0; i <= 4U; ++i) {
+            auto const v = mLo + (mHi - mLo) * d(i) / 4.0;
+            values.push_back(mIsLog ? std::exp(v) : v);
+        }
+        return values;
+    }
 
-    // calculates MdAPE which is the median of percentage error
-    // see https://support.numxl.com/hc/en-us/articles/115001223503-MdAPE-Median-Absolute-Percentage-Error
-    auto med = calcMedian(data);
+    ANKERL_NANOBENCH(NODISCARD) bool isLog() const noexcept {
+        return mIsLog;
+    }
 
-    // The error is relative to the measurement itself, so a measurement of 0 has none that is finite: it is 0 when the
-    // median is 0 as well (they agree), and infinite otherwise, which is the limit of |(x - med) / x| for x -> 0.
-    // Calculating it directly would give NaN, and a NaN in the data breaks the ordering that calcMedian's sort needs.
-    auto const zeroError = med <= 0.0 ? 0.0 : std::numeric_limits<double>::infinity();
+private:
+    bool mIsLog;
+    double mFrom;
+    double mTo;
+    double mLo = 0.0;
+    double mHi = 1.0;
+};
 
-    // transform the data to absolute error
-    for (auto& x : data) {
-        if (x <= 0.0) {
-            x = zeroError;
-            continue;
+// The time per unit of every epoch, in the order they were measured. None for a streaming result.
+static std::vector<double> timesPerUnit(Result const& result) {
+    std::vector<double> times;
+    for (size_t i = 0; !result.streaming() && i < result.size(); ++i) {
+        times.push_back(result.get(i, Result::Measure::elapsed) / result.config().mBatch);
+    }
+    return times;
+}
+
+static double quantile(std::vector<double> const& sorted, double q) {
+    auto const pos = q * d(sorted.size() - 1U);
+    auto const lo = static_cast<size_t>(pos);
+    auto const hi = (std::min)(lo + 1U, sorted.size() - 1U);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * (pos - d(lo));
+}
+
+static void svgOpen(std::ostream& out, double height) {
+    out << "<svg width=\"" << svgWidth << "\" height=\"" << height << "\" viewBox=\"0 0 " << svgWidth << ' ' << height << "\">";
+}
+
+// Vertical grid lines with their labels underneath, for an axis along x.
+static void xAxis(std::ostream& out, Axis const& axis, double top, double bottom, std::string (*label)(double)) {
+    out << "<path class=\"g\" d=\"";
+    for (auto tick : axis.ticks()) {
+        out << 'M' << axis(tick) << ' ' << top << 'V' << bottom;
+    }
+    out << "\"/>";
+    for (auto tick : axis.ticks()) {
+        out << "<text x=\"" << axis(tick) << "\" y=\"" << bottom + 14.0 << "\" text-anchor=\"middle\">" << label(tick) << "</text>";
+    }
+}
+
+// Horizontal grid lines with their labels to the left, for an axis along y.
+static void yAxis(std::ostream& out, Axis const& axis, std::string (*label)(double)) {
+    out << "<path class=\"g\" d=\"";
+    for (auto tick : axis.ticks()) {
+        out << 'M' << plotLeft << ' ' << axis(tick) << 'H' << plotRight;
+    }
+    out << "\"/>";
+    for (auto tick : axis.ticks()) {
+        out << "<text x=\"" << plotLeft - 6.0 << "\" y=\"" << axis(tick) + 4.0 << "\" text-anchor=\"end\">" << label(tick) << "</text>";
+    }
+}
+
+static std::string unitName(Result const& result) {
+    return escape(result.config().mUnit);
+}
+
+// One row per result: the box is the middle half of the epochs, the whiskers reach the last epoch
+// within 1.5 interquartile ranges of it, and the epochs beyond are dots. A streaming result has no
+// epochs, so it is its minimum, median and maximum.
+static void boxPlot(std::ostream& out, std::vector<Result const*> const& results) {
+    double lo = (std::numeric_limits<double>::max)();
+    double hi = 0.0;
+    for (auto const* r : results) {
+        lo = (std::min)(lo, r->minimum(Result::Measure::elapsed) / r->config().mBatch);
+        hi = (std::max)(hi, r->maximum(Result::Measure::elapsed) / r->config().mBatch);
+    }
+    auto const height = rowHeight * d(results.size()) + axisHeight;
+    Axis const axis(lo, hi, plotLeft, plotRight, true);
+    svgOpen(out, height);
+    xAxis(out, axis, 0.0, height - axisHeight + 6.0, &duration);
+    for (size_t i = 0; i < results.size(); ++i) {
+        auto const& r = *results[i];
+        auto const y = rowHeight * (d(i) + 0.5);
+        auto sorted = timesPerUnit(r);
+        std::sort(sorted.begin(), sorted.end());
+        auto const batch = r.config().mBatch;
+        auto const median = r.median(Result::Measure::elapsed) / batch;
+        auto q1 = median;
+        auto q3 = median;
+        auto whiskerLo = r.minimum(Result::Measure::elapsed) / batch;
+        auto whiskerHi = r.maximum(Result::Measure::elapsed) / batch;
+        if (!sorted.empty()) {
+            q1 = quantile(sorted, 0.25);
+            q3 = quantile(sorted, 0.75);
+            auto const fence = 1.5 * (q3 - q1);
+            whiskerLo = *std::lower_bound(sorted.begin(), sorted.end(), q1 - fence);
+            whiskerHi = *(std::upper_bound(sorted.begin(), sorted.end(), q3 + fence) - 1);
         }
-        x = (x - med) / x;
-        if (x < 0) {
-            x = -x;
+
+        out << "<g><title>" << escape(r.config().mBenchmarkName) << ": median " << duration(median) << "/" << unitName(r) << ", "
+            << r.size() << " epochs, err " << number(r.medianAbsolutePercentError(Result::Measure::elapsed) * 100.0)
+            << "%</title><text x=\"" << plotLeft - 6.0 << "\" y=\"" << y + 4.0 << "\" text-anchor=\"end\">"
+            << escape(r.config().mBenchmarkName) << "</text>";
+        out << "<path class=\"w\" d=\"M" << axis(whiskerLo) << ' ' << y << 'H' << axis(q1) << 'M' << axis(q3) << ' ' << y << 'H'
+            << axis(whiskerHi) << "\"/>";
+        out << "<rect class=\"b\" x=\"" << axis(q1) << "\" y=\"" << y - 7.0 << "\" width=\"" << (std::max)(axis(q3) - axis(q1), 1.0)
+            << "\" height=\"14\"/>";
+        out << "<path class=\"m\" d=\"M" << axis(median) << ' ' << y - 7.0 << "v14\"/>";
+        auto const first = std::lower_bound(sorted.begin(), sorted.end(), whiskerLo);
+        auto const last = std::upper_bound(sorted.begin(), sorted.end(), whiskerHi);
+        if (first != sorted.begin() || last != sorted.end()) {
+            out << "<path class=\"p\" d=\"";
+            for (auto it = sorted.begin(); it != first; ++it) {
+                out << 'M' << axis(*it) << ' ' << y << "h0";
+            }
+            for (auto it = last; it != sorted.end(); ++it) {
+                out << 'M' << axis(*it) << ' ' << y << "h0";
+            }
+            out << "\"/>";
+        }
+        out << "</g>";
+    }
+    out << "</svg>";
+}
+
+// Each epoch's time in the order it was measured, one color per result.
+static void scatterPlot(std::ostream& out, std::vector<Result const*> const& results) {
+    size_t numEpochs = 0;
+    double lo = (std::numeric_limits<double>::max)();
+    double hi = 0.0;
+    for (auto const* r : results) {
+        auto const times = timesPerUnit(*r);
+        numEpochs = (std::max)(numEpochs, times.size());
+        for (auto t : times) {
+            lo = (std::min)(lo, t);
+            hi = (std::max)(hi, t);
         }
     }
-    return calcMedian(data);
-}
-
-double Result::sum(Measure m) const noexcept {
-    auto const& data = measurements(m);
-    return std::accumulate(data.begin(), data.end(), 0.0);
+    if (0U == numEpochs) {
+        return;
+    }
+    auto const height = 220.0;
+    // a linear axis leaves 5% room at the end, which here would be room for an epoch that never was
+    Axis const x(0.0, d(numEpochs - 1U) / 1.05, plotLeft, plotRight, false);
+    Axis const y(lo, hi, height - axisHeight, 8.0, true);
+    svgOpen(out, height);
+    xAxis(out, x, 8.0, height - axisHeight, &number);
+    yAxis(out, y, &duration);
+    for (size_t i = 0; i < results.size(); ++i) {
+        auto const& r = *results[i];
+        auto const times = timesPerUnit(r);
+        auto const outliers = r.outlierEpochs();
+        auto const* const color = colors[i % (sizeof(colors) / sizeof(colors[0]))];
+        std::ostringstream regular;
+        std::ostringstream hollow;
+        for (auto* s : {&regular, &hollow}) {
+            s->imbue(std::locale::classic());
+            s->setf(std::ios::fixed);
+            s->precision(1);
+        }
+        for (size_t e = 0; e < times.size(); ++e) {
+            auto& s = e < outliers.size() && outliers[e] ? hollow : regular;
+            s << 'M' << x(d(e)) << ' ' << y(times[e]) << "h0";
+        }
+        out << "<g><title>" << escape(r.config().mBenchmarkName) << "</title><path class=\"s\" stroke=\"" << color << "\" d=\""
+            << regular.str() << "\"/>";
+        if (!hollow.str().empty()) {
+            out << "<path class=\"o\" stroke=\"" << color << "\" d=\"" << hollow.str() << "\"/>";
+        }
+        out << "</g>";
+    }
+    out << "<text x=\"" << (plotLeft + plotRight) / 2.0 << "\" y=\"" << height - 4.0 << "\" text-anchor=\"middle\">epoch</text></svg>";
+    out << "<p class=\"l\">";
+    for (size_t i = 0; i < results.size(); ++i) {
+        out << "<span style=\"color:" << colors[i % (sizeof(colors) / sizeof(colors[0]))] << "\">&#9679;</span> "
+            << escape(results[i]->config().mBenchmarkName) << ' ';
+    }
+    out << "</p>";
 }
 
-double Result::sumProduct(Measure m1, Measure m2) const noexcept {
-    auto const& data1 = measurements(m1);
-    auto const& data2 = measurements(m2);
-
-    if (data1.size() != data2.size()) {
-        return 0.0;
+// The medians against complexityN, and the model that fits them best through them.
+static void complexityPlot(std::ostream& out, std::vector<Result> const& results) {
+    auto const bigOs = complexityBigO(results);
+    auto const points = BigO::collectRangeMeasure(results);
+    if (points.size() < 2U || bigOs.empty()) {
+        return;
+    }
+    double nLo = (std::numeric_limits<double>::max)();
+    double nHi = 0.0;
+    double tLo = (std::numeric_limits<double>::max)();
+    double tHi = 0.0;
+    for (auto const& p : points) {
+        nLo = (std::min)(nLo, p.first);
+        nHi = (std::max)(nHi, p.first);
+        tLo = (std::min)(tLo, p.second);
+        tHi = (std::max)(tHi, p.second);
+    }
+    auto const& best = bigOs.front();
+    double (*scale)(double) = nullptr;
+    for (auto const& model : complexityModels()) {
+        if (best.name() == model.name) {
+            scale = model.scale;
+        }
     }
 
-    double result = 0.0;
-    for (size_t i = 0, s = data1.size(); i != s; ++i) {
-        result += data1[i] * data2[i];
+    auto const height = 260.0;
+    // log-log whenever there is any range at all, so that each model is a straight line
+    Axis const x(nLo, (std::max)(nHi, nLo * 21.0), plotLeft, plotRight, true);
+    Axis const y(tLo, (std::max)(tHi, tLo * 21.0), height - axisHeight, 8.0, true);
+    svgOpen(out, height);
+    xAxis(out, x, 8.0, height - axisHeight, &number);
+    yAxis(out, y, &duration);
+    if (nullptr != scale) {
+        out << "<path class=\"f\" d=\"";
+        for (size_t i = 0; i <= 40U; ++i) {
+            auto const n = nLo * std::pow(nHi / nLo, d(i) / 40.0);
+            auto const t = best.constant() * scale(n);
+            out << (0U == i ? 'M' : 'L') << x(n) << ' ' << y(t);
+        }
+        out << "\"/>";
     }
-    return result;
+    out << "<path class=\"s\" stroke=\"" << colors[0] << "\" d=\"";
+    for (auto const& p : points) {
+        out << 'M' << x(p.first) << ' ' << y(p.second) << "h0";
+    }
+    out << "\"/><text x=\"" << (plotLeft + plotRight) / 2.0 << "\" y=\"" << height - 4.0
+        << "\" text-anchor=\"middle\">complexityN</text></svg>";
+    out << "<p class=\"l\">best fit: " << duration(best.constant()) << " * " << escape(best.name())
+        << ", normalized rms " << number(best.normalizedRootMeanSquare() * 100.0) << "%</p>";
 }
 
-bool Result::has(Measure m) const noexcept {
-    return !measurements(m).empty();
+static std::string ratioLabel(double ratio) {
+    return number(ratio) + "x";
 }
 
-double Result::get(size_t idx, Measure m) const {
-    return measurements(m).at(idx);
+static void compareSection(std::ostream& out, CompareResult const& compareResult) {
+    double lo = 1.0;
+    double hi = 1.0;
+    for (size_t i = 0; i < compareResult.size(); ++i) {
+        auto const& e = compareResult[i];
+        for (auto v : {e.relative, e.relativeLow, e.relativeHigh}) {
+            if (v > 0.0 && std::isfinite(v)) {
+                lo = (std::min)(lo, v);
+                hi = (std::max)(hi, v);
+            }
+        }
+    }
+    // Always logarithmic, so that a ratio and its inverse are the same distance from 1.
+    Axis const axis((std::min)(lo, 1.0 / 21.0 * hi), hi, plotLeft, plotRight, true);
+    auto const height = rowHeight * d(compareResult.size()) + axisHeight;
+    svgOpen(out, height);
+    xAxis(out, axis, 0.0, height - axisHeight + 6.0, &ratioLabel);
+    out << "<path class=\"m\" d=\"M" << axis(1.0) << " 0V" << height - axisHeight + 6.0 << "\"/>";
+    for (size_t i = 0; i < compareResult.size(); ++i) {
+        auto const& e = compareResult[i];
+        auto const y = rowHeight * (d(i) + 0.5);
+        auto const* cls = "n";
+        if (compareResult.isSignificant(i)) {
+            cls = e.relativeLow > 1.0 ? "u" : "d";
+        }
+        out << "<g class=\"" << cls << "\"><title>" << escape(e.name);
+        if (0U == i) {
+            out << ": baseline";
+        } else {
+            out << ": " << ratioLabel(e.relative) << " [" << ratioLabel(e.relativeLow) << ", " << ratioLabel(e.relativeHigh)
+                << "], " << e.tiedRounds << " tied rounds";
+        }
+        if (compareResult.isDropped(i)) {
+            out << ", dropped early";
+        }
+        out << "</title><text x=\"" << plotLeft - 6.0 << "\" y=\"" << y + 4.0 << "\" text-anchor=\"end\">" << escape(e.name)
+            << "</text>";
+        if (e.relativeLow > 0.0 && e.relativeHigh > 0.0 && std::isfinite(e.relativeHigh)) {
+            out << "<path d=\"M" << axis(e.relativeLow) << ' ' << y << 'H' << axis(e.relativeHigh) << "\"/>";
+        }
+        if (e.relative > 0.0 && std::isfinite(e.relative)) {
+            out << "<circle cx=\"" << axis(e.relative) << "\" cy=\"" << y << "\" r=\"4\"/>";
+        }
+        out << "</g>";
+    }
+    out << "</svg><p class=\"l\">" << compareResult.rounds() << " rounds, each interval at "
+        << number(compareResult.confidence() * 100.0) << "% confidence. Above 1x is faster than the baseline.</p>";
 }
 
-bool Result::empty() const noexcept {
-    return 0U == size();
-}
+} // namespace html
+} // namespace detail
 
-size_t Result::size() const noexcept {
-    return measurements(Measure::elapsed).size();
-}
+HtmlReport::HtmlReport(std::string title)
+    : mTitle(std::move(title)) {}
 
-double Result::minimum(Measure m) const noexcept {
-    auto const& data = measurements(m);
-    if (data.empty()) {
-        return 0.0;
+HtmlReport& HtmlReport::add(std::vector<Result> const& results) {
+    // grouped by title, which is how a bench would have produced them
+    std::vector<std::string> titles;
+    for (auto const& r : results) {
+        if (std::find(titles.begin(), titles.end(), r.config().mBenchmarkTitle) == titles.end()) {
+            titles.push_back(r.config().mBenchmarkTitle);
+        }
     }
 
-    // here its save to assume that at least one element is there
-    return *std::min_element(data.begin(), data.end());
-}
-
-double Result::maximum(Measure m) const noexcept {
-    auto const& data = measurements(m);
-    if (data.empty()) {
-        return 0.0;
+    std::ostringstream out;
+    out.imbue(std::locale::classic());
+    out << std::fixed << std::setprecision(1);
+    for (auto const& title : titles) {
+        std::vector<Result const*> group;
+        std::vector<Result> sized;
+        for (auto const& r : results) {
+            // a result without a single epoch has nothing to draw
+            if (r.config().mBenchmarkTitle == title && r.size() > 0U) {
+                group.push_back(&r);
+                if (r.config().mComplexityN > 0.0) {
+                    sized.push_back(r);
+                }
+            }
+        }
+        if (group.empty()) {
+            continue;
+        }
+        out << "<h2>" << detail::html::escape(title) << "</h2><h3>time per " << detail::html::unitName(*group.front()) << "</h3>";
+        detail::html::boxPlot(out, group);
+        detail::html::scatterPlot(out, group);
+        if (sized.size() >= 2U) {
+            out << "<h3>complexity</h3>";
+            detail::html::complexityPlot(out, sized);
+        }
     }
+    mSections += out.str();
+    return *this;
+}
 
-    // here its save to assume that at least one element is there
-    return *std::max_element(data.begin(), data.end());
+HtmlReport& HtmlReport::add(Bench const& bench) {
+    return add(bench.results());
 }
 
-std::string const& Result::context(char const* variableName) const {
-    return mConfig.mContext.at(variableName);
+HtmlReport& HtmlReport::add(std::string const& heading, CompareResult const& compareResult) {
+    if (0U == compareResult.size()) {
+        return *this;
+    }
+    std::ostringstream out;
+    out.imbue(std::locale::classic());
+    out << std::fixed << std::setprecision(1);
+    out << "<h2>" << detail::html::escape(heading) << "</h2><h3>ratio to " << detail::html::escape(compareResult[0].name) << "</h3>";
+    detail::html::compareSection(out, compareResult);
+    mSections += out.str();
+    return *this;
 }
 
-std::string const& Result::context(std::string const& variableName) const {
-    return mConfig.mContext.at(variableName);
+void HtmlReport::write(std::ostream& out) const {
+    out << "<!DOCTYPE html>\n<html><head><meta charset=\"utf-8\"><title>" << detail::html::escape(mTitle)
+        << "</title><style>"
+           "body{font-family:sans-serif;max-width:820px;margin:auto}svg{display:block}text{font-size:11px}"
+           ".g{stroke:#ddd}.w,.m{stroke:#333}.b{fill:#bcd;stroke:#333}.p{stroke:#333;stroke-width:4;stroke-linecap:round}"
+           ".s,.o{stroke-width:5;stroke-linecap:round}.o{stroke-opacity:.35}.f{fill:none;stroke:#999;stroke-dasharray:4}"
+           ".l{font-size:12px}g>path{stroke-width:2}.n{stroke:#777;fill:#777}.u{stroke:#282;fill:#282}.d{stroke:#c33;fill:#c33}"
+           "</style></head><body><h1>"
+        << detail::html::escape(mTitle) << "</h1>\n"
+        << mSections << "\n</body></html>\n";
 }
 
-Result::Measure Result::fromString(std::string const& str) {
-    if (str == "elapsed") {
-        return Measure::elapsed;
-    }
-    if (str == "iterations") {
-        return Measure::iterations;
-    }
-    if (str == "pagefaults") {
-        return Measure::pagefaults;
-    }
-    if (str == "cpucycles") {
-        return Measure::cpucycles;
-    }
-    if (str == "contextswitches") {
-        return Measure::contextswitches;
-    }
-    if (str == "instructions") {
-        return Measure::instructions;
-    }
-    if (str == "branchinstructions") {
-        return Measure::branchinstructions;
-    }
-    if (str == "branchmisses") {
-        return Measure::branchmisses;
-    }
-    // not found, return _size
-    return Measure::_size;
+bool HtmlReport::write(std::string const& path) const {
+    std::ofstream out(path);
+    write(out);
+    return static_cast<bool>(out);
 }
 
 // Configuration of a microbenchmark.
-Bench::Bench() {
-    mConfig.mOut = &std::cout;
+Bench::Bench()
+    : mBaselineFile(std::make_shared<detail::BaselineFile>()) {
+    mutableConfig().mOut = &std::cout;
     detail::applyEnvConfig(*this);
 }
 
@@ -4785,6 +10948,18 @@ Bench::Bench(Bench const&) = default;
 Bench& Bench::operator=(Bench const&) = default;
 Bench::~Bench() noexcept = default;
 
+Config& Bench::mutableConfig() noexcept {
+    mSharedConfig.reset();
+    return mConfig;
+}
+
+std::shared_ptr<Config const> const& Bench::sharedConfig() {
+    if (!mSharedConfig) {
+        mSharedConfig = std::make_shared<Config const>(mConfig);
+    }
+    return mSharedConfig;
+}
+
 double Bench::batch() const noexcept {
     return mConfig.mBatch;
 }
@@ -4796,7 +10971,7 @@ double Bench::complexityN() const noexcept {
 // Set a baseline to compare it to. 100% it is exactly as fast as the baseline, >100% means it is faster than the baseline, <100%
 // means it is slower than the baseline.
 Bench& Bench::relative(bool isRelativeEnabled) noexcept {
-    mConfig.mIsRelative = isRelativeEnabled;
+    mutableConfig().mIsRelative = isRelativeEnabled;
     return *this;
 }
 bool Bench::relative() const noexcept {
@@ -4804,13 +10979,170 @@ bool Bench::relative() const noexcept {
 }
 
 Bench& Bench::performanceCounters(bool showPerformanceCounters) noexcept {
-    mConfig.mShowPerformanceCounters = showPerformanceCounters;
+    mutableConfig().mShowPerformanceCounters = showPerformanceCounters;
     return *this;
 }
 bool Bench::performanceCounters() const noexcept {
     return mConfig.mShowPerformanceCounters;
 }
 
+Bench& Bench::outliers(OutlierMethod method, OutlierAction action) noexcept {
+    mutableConfig().mOutlierMethod = method;
+    mutableConfig().mOutlierAction = action;
+    return *this;
+}
+OutlierMethod Bench::outlierMethod() const noexcept {
+    return mConfig.mOutlierMethod;
+}
+OutlierAction Bench::outlierAction() const noexcept {
+    return mConfig.mOutlierAction;
+}
+
+Bench& Bench::confidenceIntervals(bool enabled) noexcept {
+    mutableConfig().mShowConfidenceIntervals = enabled;
+    return *this;
+}
+bool Bench::confidenceIntervals() const noexcept {
+    return mConfig.mShowConfidenceIntervals;
+}
+
+Bench& Bench::streaming(bool enabled) noexcept {
+    mutableConfig().mStreaming = enabled;
+    return *this;
+}
+bool Bench::streaming() const noexcept {
+    return mConfig.mStreaming;
+}
+
+Bench& Bench::liveReport(std::chrono::nanoseconds interval) noexcept {
+    mutableConfig().mLiveReport = interval;
+    return *this;
+}
+std::chrono::nanoseconds Bench::liveReport() const noexcept {
+    return mConfig.mLiveReport;
+}
+
+Bench& Bench::progress(std::chrono::nanoseconds interval) noexcept {
+    mutableConfig().mProgress = interval;
+    return *this;
+}
+std::chrono::nanoseconds Bench::progress() const noexcept {
+    return mConfig.mProgress;
+}
+
+Bench& Bench::progressTotal(size_t numBenchmarks) noexcept {
+    mutableConfig().mProgressTotal = numBenchmarks;
+    return *this;
+}
+size_t Bench::progressTotal() const noexcept {
+    return mConfig.mProgressTotal;
+}
+
+Bench& Bench::baseline(std::string const& path) {
+    mutableConfig().mBaselinePath = path;
+    return *this;
+}
+std::string const& Bench::baseline() const noexcept {
+    return mConfig.mBaselinePath;
+}
+
+Bench& Bench::baselineTolerance(double tolerance) noexcept {
+    mutableConfig().mBaselineTolerance = tolerance;
+    return *this;
+}
+double Bench::baselineTolerance() const noexcept {
+    return mConfig.mBaselineTolerance;
+}
+
+Bench& Bench::baselineUpdate(bool enabled) noexcept {
+    mutableConfig().mBaselineUpdate = enabled;
+    return *this;
+}
+bool Bench::baselineUpdate() const noexcept {
+    return mConfig.mBaselineUpdate;
+}
+
+Bench& Bench::jsonLines(std::string const& path, bool withMeasurements) {
+    mutableConfig().mJsonLinesPath = path;
+    mutableConfig().mJsonLinesMeasurements = withMeasurements;
+    return *this;
+}
+std::string const& Bench::jsonLines() const noexcept {
+    return mConfig.mJsonLinesPath;
+}
+bool Bench::jsonLinesMeasurements() const noexcept {
+    return mConfig.mJsonLinesMeasurements;
+}
+
+Bench& Bench::trace(std::string const& path) {
+    mutableConfig().mTracePath = path;
+    return *this;
+}
+std::string const& Bench::trace() const noexcept {
+    return mConfig.mTracePath;
+}
+
+Bench& Bench::checkpoint(std::string const& path) {
+    mutableConfig().mCheckpointPath = path;
+    return *this;
+}
+std::string const& Bench::checkpoint() const noexcept {
+    return mConfig.mCheckpointPath;
+}
+
+std::vector<BaselineComparison> const& Bench::baselineComparisons() const noexcept {
+    return mBaselineComparisons;
+}
+
+Bench& Bench::compareTargetWidth(double relativeHalfWidth) noexcept {
+    mutableConfig().mCompareTargetWidth = relativeHalfWidth;
+    return *this;
+}
+double Bench::compareTargetWidth() const noexcept {
+    return mConfig.mCompareTargetWidth;
+}
+
+Bench& Bench::compareEquivalence(double margin) noexcept {
+    mutableConfig().mCompareEquivalenceMargin = margin;
+    return *this;
+}
+double Bench::compareEquivalence() const noexcept {
+    return mConfig.mCompareEquivalenceMargin;
+}
+
+Bench& Bench::compareTimeBudget(std::chrono::nanoseconds budget) noexcept {
+    mutableConfig().mCompareTimeBudget = budget;
+    return *this;
+}
+std::chrono::nanoseconds Bench::compareTimeBudget() const noexcept {
+    return mConfig.mCompareTimeBudget;
+}
+
+Bench& Bench::compareRacing(bool enabled) noexcept {
+    mutableConfig().mCompareRacing = enabled;
+    return *this;
+}
+bool Bench::compareRacing() const noexcept {
+    return mConfig.mCompareRacing;
+}
+
+Bench& Bench::noiseFloor(std::string const& path) {
+    mutableConfig().mNoiseFloorPath = path;
+    return *this;
+}
+std::string const& Bench::noiseFloor() const noexcept {
+    return mConfig.mNoiseFloorPath;
+}
+
+int Bench::baselineExitStatus() const noexcept {
+    for (auto const& comparison : mBaselineComparisons) {
+        if (BaselineVerdict::slower == comparison.verdict) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
 namespace detail {
 
 // One bit of mHiddenColumns per Column, so there had better be at most 32 of them.
@@ -4827,12 +11159,12 @@ bool isColumnVisible(Config const& config, Column column) noexcept {
 } // namespace detail
 
 Bench& Bench::hideColumn(Column column) noexcept {
-    mConfig.mHiddenColumns |= detail::columnBit(column);
+    mutableConfig().mHiddenColumns |= detail::columnBit(column);
     return *this;
 }
 
 Bench& Bench::showColumn(Column column) noexcept {
-    mConfig.mHiddenColumns &= ~detail::columnBit(column);
+    mutableConfig().mHiddenColumns &= ~detail::columnBit(column);
     return *this;
 }
 
@@ -4845,12 +11177,12 @@ Bench& Bench::contextColumn(std::string const& variableName) {
     if (mConfig.mContextColumns.end() != std::find(mConfig.mContextColumns.begin(), mConfig.mContextColumns.end(), variableName)) {
         return *this;
     }
-    mConfig.mContextColumns.push_back(variableName);
+    mutableConfig().mContextColumns.push_back(variableName);
     return *this;
 }
 
 Bench& Bench::clearContextColumns() noexcept {
-    mConfig.mContextColumns.clear();
+    mutableConfig().mContextColumns.clear();
     return *this;
 }
 
@@ -4861,7 +11193,7 @@ Bench& Bench::unit(char const* u) {
     if (u != mConfig.mUnit) {
         mResults.clear();
     }
-    mConfig.mUnit = u;
+    mutableConfig().mUnit = u;
     return *this;
 }
 
@@ -4874,8 +11206,8 @@ std::string const& Bench::unit() const noexcept {
 }
 
 Bench& Bench::timeUnit(std::chrono::duration<double> const& tu, std::string const& tuName) {
-    mConfig.mTimeUnit = tu;
-    mConfig.mTimeUnitName = tuName;
+    mutableConfig().mTimeUnit = tu;
+    mutableConfig().mTimeUnitName = tuName;
     return *this;
 }
 
@@ -4897,7 +11229,7 @@ Bench& Bench::title(std::string const& benchmarkTitle) {
     if (benchmarkTitle != mConfig.mBenchmarkTitle) {
         mResults.clear();
     }
-    mConfig.mBenchmarkTitle = benchmarkTitle;
+    mutableConfig().mBenchmarkTitle = benchmarkTitle;
     return *this;
 }
 
@@ -4905,19 +11237,27 @@ std::string const& Bench::title() const noexcept {
     return mConfig.mBenchmarkTitle;
 }
 
+// run(name, op) sets the name every time, so setting the same one again must not cost the results
+// their shared config.
 Bench& Bench::name(const char* benchmarkName) {
-    mConfig.mBenchmarkName = benchmarkName;
+    if (mConfig.mBenchmarkName != benchmarkName) {
+        mutableConfig().mBenchmarkName = benchmarkName;
+    }
     return *this;
 }
 
 Bench& Bench::name(std::string const& benchmarkName) {
-    mConfig.mBenchmarkName = benchmarkName;
+    if (mConfig.mBenchmarkName != benchmarkName) {
+        mutableConfig().mBenchmarkName = benchmarkName;
+    }
     return *this;
 }
 
 #    if ANKERL_NANOBENCH(HAS_STRING_VIEW)
 Bench& Bench::name(std::string_view benchmarkName) {
-    mConfig.mBenchmarkName.assign(benchmarkName.data(), benchmarkName.size());
+    if (mConfig.mBenchmarkName != benchmarkName) {
+        mutableConfig().mBenchmarkName.assign(benchmarkName.data(), benchmarkName.size());
+    }
     return *this;
 }
 #    endif
@@ -4927,23 +11267,23 @@ std::string const& Bench::name() const noexcept {
 }
 
 Bench& Bench::context(char const* variableName, char const* variableValue) {
-    mConfig.mContext[variableName] = variableValue;
+    mutableConfig().mContext[variableName] = variableValue;
     return *this;
 }
 
 Bench& Bench::context(std::string const& variableName, std::string const& variableValue) {
-    mConfig.mContext[variableName] = variableValue;
+    mutableConfig().mContext[variableName] = variableValue;
     return *this;
 }
 
 Bench& Bench::clearContext() {
-    mConfig.mContext.clear();
+    mutableConfig().mContext.clear();
     return *this;
 }
 
 // Number of epochs to evaluate. The reported result will be the median of evaluation of each epoch.
 Bench& Bench::epochs(size_t numEpochs) noexcept {
-    mConfig.mNumEpochs = numEpochs;
+    mutableConfig().mNumEpochs = numEpochs;
     return *this;
 }
 size_t Bench::epochs() const noexcept {
@@ -4952,7 +11292,7 @@ size_t Bench::epochs() const noexcept {
 
 // Desired evaluation time is a multiple of clock resolution. Default is to be 1000 times above this measurement precision.
 Bench& Bench::clockResolutionMultiple(size_t multiple) noexcept {
-    mConfig.mClockResolutionMultiple = multiple;
+    mutableConfig().mClockResolutionMultiple = multiple;
     return *this;
 }
 size_t Bench::clockResolutionMultiple() const noexcept {
@@ -4961,7 +11301,7 @@ size_t Bench::clockResolutionMultiple() const noexcept {
 
 // Sets the maximum time each epoch should take. Default is 100ms.
 Bench& Bench::maxEpochTime(std::chrono::nanoseconds t) noexcept {
-    mConfig.mMaxEpochTime = t;
+    mutableConfig().mMaxEpochTime = t;
     return *this;
 }
 std::chrono::nanoseconds Bench::maxEpochTime() const noexcept {
@@ -4970,7 +11310,7 @@ std::chrono::nanoseconds Bench::maxEpochTime() const noexcept {
 
 // Sets the minimum time each epoch should take. Default is 1ms.
 Bench& Bench::minEpochTime(std::chrono::nanoseconds t) noexcept {
-    mConfig.mMinEpochTime = t;
+    mutableConfig().mMinEpochTime = t;
     return *this;
 }
 std::chrono::nanoseconds Bench::minEpochTime() const noexcept {
@@ -4978,7 +11318,7 @@ std::chrono::nanoseconds Bench::minEpochTime() const noexcept {
 }
 
 Bench& Bench::minEpochIterations(uint64_t numIters) noexcept {
-    mConfig.mMinEpochIterations = (numIters == 0) ? 1 : numIters;
+    mutableConfig().mMinEpochIterations = (numIters == 0) ? 1 : numIters;
     return *this;
 }
 uint64_t Bench::minEpochIterations() const noexcept {
@@ -4986,7 +11326,7 @@ uint64_t Bench::minEpochIterations() const noexcept {
 }
 
 Bench& Bench::epochIterations(uint64_t numIters) noexcept {
-    mConfig.mEpochIterations = numIters;
+    mutableConfig().mEpochIterations = numIters;
     return *this;
 }
 uint64_t Bench::epochIterations() const noexcept {
@@ -4994,7 +11334,7 @@ uint64_t Bench::epochIterations() const noexcept {
 }
 
 Bench& Bench::warmup(uint64_t numWarmupIters) noexcept {
-    mConfig.mWarmup = numWarmupIters;
+    mutableConfig().mWarmup = numWarmupIters;
     return *this;
 }
 uint64_t Bench::warmup() const noexcept {
@@ -5002,7 +11342,7 @@ uint64_t Bench::warmup() const noexcept {
 }
 
 Bench& Bench::config(Config const& benchmarkConfig) {
-    mConfig = benchmarkConfig;
+    mutableConfig() = benchmarkConfig;
     return *this;
 }
 Config const& Bench::config() const noexcept {
@@ -5010,7 +11350,7 @@ Config const& Bench::config() const noexcept {
 }
 
 Bench& Bench::output(std::ostream* outstream) noexcept {
-    mConfig.mOut = outstream;
+    mutableConfig().mOut = outstream;
     return *this;
 }
 
@@ -5032,27 +11372,37 @@ Bench& Bench::render(std::string const& templateContent, std::ostream& os) {
     return *this;
 }
 
+Bench& Bench::render(Template const& tpl, std::ostream& os) {
+    ::ankerl::nanobench::render(tpl, *this, os);
+    return *this;
+}
+
 std::vector<BigO> Bench::complexityBigO() const {
+    return ::ankerl::nanobench::complexityBigO(mResults);
+}
+
+namespace detail {
+
+std::vector<ComplexityModel> const& complexityModels() {
+    static std::vector<ComplexityModel> const models = {
+        {"O(1)", [](double) { return 1.0; }},
+        {"O(n)", [](double n) { return n; }},
+        {"O(log n)", [](double n) { return std::log2(n); }},
+        {"O(n log n)", [](double n) { return n * std::log2(n); }},
+        {"O(n^2)", [](double n) { return n * n; }},
+        {"O(n^3)", [](double n) { return n * n * n; }},
+    };
+    return models;
+}
+
+} // namespace detail
+
+std::vector<BigO> complexityBigO(std::vector<Result> const& results) {
     std::vector<BigO> bigOs;
-    auto rangeMeasure = BigO::collectRangeMeasure(mResults);
-    bigOs.emplace_back("O(1)", rangeMeasure, [](double) {
-        return 1.0;
-    });
-    bigOs.emplace_back("O(n)", rangeMeasure, [](double n) {
-        return n;
-    });
-    bigOs.emplace_back("O(log n)", rangeMeasure, [](double n) {
-        return std::log2(n);
-    });
-    bigOs.emplace_back("O(n log n)", rangeMeasure, [](double n) {
-        return n * std::log2(n);
-    });
-    bigOs.emplace_back("O(n^2)", rangeMeasure, [](double n) {
-        return n * n;
-    });
-    bigOs.emplace_back("O(n^3)", rangeMeasure, [](double n) {
-        return n * n * n;
-    });
+    auto rangeMeasure = BigO::collectRangeMeasure(results);
+    for (auto const& model : detail::complexityModels()) {
+        bigOs.emplace_back(model.name, rangeMeasure, model.scale);
+    }
     std::sort(bigOs.begin(), bigOs.end());
     return bigOs;
 }
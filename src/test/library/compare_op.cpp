@@ -0,0 +1,27 @@
+#include <cstdint>
+
+// Built twice by src/test/CMakeLists.txt, as two shared libraries that differ only in how much work
+// the operation does, for unit_compare_shared_libraries.cpp to tell apart. Deliberately not using
+// nanobench.h: a library under comparison has no reason to link it.
+
+#if defined(_WIN32)
+#    define NB_COMPARE_OP_EXPORT __declspec(dllexport)
+#else
+#    define NB_COMPARE_OP_EXPORT __attribute__((visibility("default")))
+#endif
+
+namespace {
+uint64_t volatile sink = 0;
+} // namespace
+
+extern "C" NB_COMPARE_OP_EXPORT void nanobench_op(uint64_t numIters);
+
+extern "C" NB_COMPARE_OP_EXPORT void nanobench_op(uint64_t numIters) {
+    uint64_t x = sink;
+    for (uint64_t i = 0; i < numIters; ++i) {
+        for (int w = 0; w < NB_COMPARE_OP_WORK * 8; ++w) {
+            x = x * UINT64_C(6364136223846793005) + UINT64_C(1442695040888963407);
+            sink = x;
+        }
+    }
+}
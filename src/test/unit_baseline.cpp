@@ -0,0 +1,208 @@
+#include <nanobench.h>
+#include <thirdparty/doctest/doctest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// A baseline is only useful if it says "slower" when something got slower and
+// stays quiet otherwise - a check that cries wolf on every run is switched off
+// within a week. The comparison is tested on made-up epochs where the answer
+// is known, and the file on a round trip, since a key that does not come back
+// the same silently turns every benchmark into a new one.
+namespace {
+
+namespace nb = ankerl::nanobench::detail;
+using ankerl::nanobench::BaselineVerdict;
+using ankerl::nanobench::Config;
+
+std::vector<double> scaled(std::vector<double> values, double factor) {
+    for (auto& v : values) {
+        v *= factor;
+    }
+    return values;
+}
+
+// something the optimizer cannot remove, or the run is an "iterations overflow" with no epochs
+void increment(uint64_t& x) {
+    ankerl::nanobench::doNotOptimizeAway(x += 1);
+}
+
+std::vector<double> const epochs = {100, 102, 99, 101, 103, 98, 100, 101, 99, 102, 100};
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_baseline_compare") {
+    auto const slower = nb::compareToBaseline("x", epochs, scaled(epochs, 1.2), 0.05);
+    CHECK(slower.verdict == BaselineVerdict::slower);
+    CHECK(slower.relative == doctest::Approx(1.2));
+    CHECK(slower.relativeLow <= slower.relative);
+    CHECK(slower.relativeHigh >= slower.relative);
+
+    auto const faster = nb::compareToBaseline("x", epochs, scaled(epochs, 0.5), 0.05);
+    CHECK(faster.verdict == BaselineVerdict::faster);
+    CHECK(faster.relative == doctest::Approx(0.5));
+
+    // the same epochs are no change, of course
+    auto const same = nb::compareToBaseline("x", epochs, epochs, 0.05);
+    CHECK(same.verdict == BaselineVerdict::unchanged);
+    CHECK(same.relative == doctest::Approx(1.0));
+
+    // 3% slower is a real difference, but within the tolerance
+    auto const small = nb::compareToBaseline("x", epochs, scaled(epochs, 1.03), 0.05);
+    CHECK(small.verdict == BaselineVerdict::unchanged);
+    CHECK(nb::compareToBaseline("x", epochs, scaled(epochs, 1.03), 0.01).verdict == BaselineVerdict::slower);
+
+    // two epochs each have no 95% interval, however far apart they are
+    CHECK(nb::compareToBaseline("x", {1, 1}, {10, 10}, 0.05).verdict == BaselineVerdict::unchanged);
+    CHECK(nb::compareToBaseline("x", {}, epochs, 0.05).relative == doctest::Approx(1.0));
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_baseline_key") {
+    Config config;
+    config.mBenchmarkTitle = "sort";
+    config.mBenchmarkName = "std::sort";
+    CHECK(nb::baselineKey(config) == "sort / std::sort");
+
+    // sorted, whatever order the context was set in
+    config.mContext["type"] = "int";
+    config.mContext["alloc"] = "std";
+    config.mComplexityN = 1000;
+    CHECK(nb::baselineKey(config) == "sort / std::sort [alloc=std] [type=int] [N=1000]");
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_baseline_file") {
+    std::string const path = "unit_baseline_file.txt";
+    nb::BaselineEntries const entries = {{"a / b", {1.5, 2.25e-9}}, {"tab\tand\nnewline \\", {3}}};
+    REQUIRE(nb::saveBaseline(path, entries));
+    CHECK(nb::loadBaseline(path) == entries);
+
+    // anything that is not a baseline file is empty rather than garbage
+    {
+        std::ofstream out(path);
+        out << "a / b\t1 2 3\n";
+    }
+    CHECK(nb::loadBaseline(path).empty());
+    CHECK(nb::loadBaseline("unit_baseline_file_that_does_not_exist.txt").empty());
+
+    // an entry appended by a process that was killed half way through it is not one
+    REQUIRE(nb::saveBaseline(path, entries));
+    REQUIRE(nb::appendBaseline(path, {"c / d", {4}}));
+    {
+        std::ofstream out(path, std::ios::app);
+        out << "e / f\t1.5 2";
+    }
+    auto appended = entries;
+    appended.emplace_back("c / d", std::vector<double>{4});
+    CHECK(nb::loadBaseline(path) == appended);
+    std::remove(path.c_str());
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_baseline_bench") {
+    std::string const path = "unit_baseline_bench.txt";
+    std::remove(path.c_str());
+
+    uint64_t x = 0;
+    auto const op = [&] {
+        increment(x);
+    };
+
+    std::ostringstream first;
+    ankerl::nanobench::Bench bench;
+    bench.output(&first).epochs(5).epochIterations(1000).baseline(path).run("x", op);
+    CHECK(first.str().find(" vs. base |") != std::string::npos);
+    CHECK(first.str().find(" new |") != std::string::npos);
+    CHECK(bench.baselineComparisons().empty());
+
+    // the next run has something to compare to, and does not overwrite it
+    auto const saved = nb::loadBaseline(path);
+    REQUIRE(saved.size() == 1U);
+    std::ostringstream second;
+    bench.output(&second).run("x", op);
+    REQUIRE(bench.baselineComparisons().size() == 1U);
+    CHECK(bench.baselineComparisons().front().name == "x");
+    CHECK(second.str().find(" new |") == std::string::npos);
+    CHECK(nb::loadBaseline(path) == saved);
+
+    // unless it is asked to
+    bench.baselineUpdate(true).run("x", op);
+    CHECK(nb::loadBaseline(path) != saved);
+
+    // a made-up regression fails the exit status
+    Config config;
+    config.mBenchmarkTitle = bench.title();
+    config.mBenchmarkName = "x";
+    nb::BaselineEntries const keyed = {{nb::baselineKey(config), std::vector<double>(11, 1e-15)}};
+    REQUIRE(nb::saveBaseline(path, keyed));
+    ankerl::nanobench::Bench gated;
+    gated.output(nullptr).epochs(11).baseline(path).run("x", op);
+    REQUIRE(gated.baselineComparisons().size() == 1U);
+    CHECK(gated.baselineComparisons().front().verdict == BaselineVerdict::slower);
+    CHECK(gated.baselineExitStatus() == 1);
+    std::remove(path.c_str());
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_baseline_two_benches") {
+    std::string const path = "unit_baseline_two_benches.txt";
+    std::remove(path.c_str());
+
+    uint64_t x = 0;
+    auto const op = [&] {
+        increment(x);
+    };
+
+    // both have read the file before the other one saved to it
+    ankerl::nanobench::Bench a;
+    a.output(nullptr).epochs(5).epochIterations(100).baseline(path).run("a1", op);
+    ankerl::nanobench::Bench b;
+    b.output(nullptr).epochs(5).epochIterations(100).baseline(path).run("b1", op);
+    a.run("a2", op);
+    REQUIRE(nb::loadBaseline(path).size() == 3U);
+
+    // an update by one of them rewrites the file, and keeps what the other one saved meanwhile
+    b.baselineUpdate(true).run("b1", op);
+    auto const saved = nb::loadBaseline(path);
+    REQUIRE(saved.size() == 3U);
+    CHECK(saved[0].first.find("a1") != std::string::npos);
+    CHECK(saved[1].first.find("b1") != std::string::npos);
+    CHECK(saved[2].first.find("a2") != std::string::npos);
+    std::remove(path.c_str());
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_baseline_after_a_line_cut_short") {
+    std::string const path = "unit_baseline_after_a_line_cut_short.txt";
+    std::remove(path.c_str());
+
+    uint64_t x = 0;
+    auto const op = [&] {
+        increment(x);
+    };
+    ankerl::nanobench::Bench first;
+    first.output(nullptr).epochs(5).epochIterations(100).baseline(path).run("a", op);
+
+    // killed while appending the next entry: half a line, and no newline after it
+    {
+        std::ofstream out(path, std::ios::app);
+        out << "cut short\t1.5 2.";
+    }
+
+    // the next entry is not glued onto it, and what was cut short is gone
+    ankerl::nanobench::Bench second;
+    second.output(nullptr).epochs(5).epochIterations(100).baseline(path).run("b", op);
+    auto const saved = nb::loadBaseline(path);
+    REQUIRE(saved.size() == 2U);
+    CHECK(saved[0].first == "benchmark / a");
+    CHECK(saved[1].first == "benchmark / b");
+    CHECK(saved[1].second.size() == 5U);
+    CHECK(nb::endsInNewline(path));
+    std::remove(path.c_str());
+}
@@ -0,0 +1,264 @@
+#include <nanobench.h>
+#include <thirdparty/doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// A checkpoint is only worth having if resuming from it is indistinguishable
+// from never having stopped: a restored benchmark that shows slightly
+// different numbers, or is run again anyway, is worse than starting over,
+// because it looks like it worked. The interrupted suite is a bench that runs
+// the first benchmarks of the list, and the resumed one a bench that runs all
+// of them with the same file - after forgetting what this process found in it,
+// which is what a new process would do.
+namespace {
+
+namespace nb = ankerl::nanobench::detail;
+using ankerl::nanobench::Config;
+using ankerl::nanobench::Result;
+
+// something the optimizer cannot remove, or the run is an "iterations overflow" with no epochs
+void increment(uint64_t& x) {
+    ankerl::nanobench::doNotOptimizeAway(x += 1);
+}
+
+std::vector<std::string> linesOf(std::string const& text) {
+    std::vector<std::string> lines;
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+// a file of this process's own, as if no process had used it before
+void startOver(std::string const& path) {
+    std::remove(path.c_str());
+    nb::CheckpointLog::forget(path);
+}
+
+// runs the first `numBenchmarks` of the suite, and counts how often each one's op was called
+void runSuite(ankerl::nanobench::Bench& bench, size_t numBenchmarks, std::vector<size_t>& calls) {
+    uint64_t x = 0;
+    std::vector<std::string> const names = {"a", "b", "c"};
+    for (size_t i = 0; i < numBenchmarks; ++i) {
+        bench.run(names[i], [&] {
+            ++calls[i];
+            increment(x);
+        });
+    }
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_checkpoint_key") {
+    Config config;
+    config.mBenchmarkTitle = "sort";
+    config.mBenchmarkName = "std::sort";
+    auto const key = nb::checkpointKey(config);
+    CHECK(key.find("sort / std::sort [config=") == 0U);
+
+    // how it is measured matters, how it is shown does not
+    auto other = config;
+    other.mTimeUnitName = "ms";
+    CHECK(nb::checkpointKey(other) == key);
+    other.mNumEpochs = config.mNumEpochs + 1U;
+    CHECK(nb::checkpointKey(other) != key);
+    other = config;
+    other.mContext["type"] = "int";
+    CHECK(nb::checkpointKey(other) != key);
+    other = config;
+    other.mBatch = 1000.0;
+    CHECK(nb::checkpointKey(other) != key);
+    other = config;
+    other.mUnit = "byte";
+    CHECK(nb::checkpointKey(other) != key);
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_checkpoint_resume") {
+    std::string const path = "unit_checkpoint_resume.bin";
+    startOver(path);
+
+    std::vector<size_t> interruptedCalls(3, 0);
+    std::ostringstream interruptedOut;
+    ankerl::nanobench::Bench interrupted;
+    interrupted.output(&interruptedOut).title("suite").epochs(5).epochIterations(100).checkpoint(path);
+    runSuite(interrupted, 2, interruptedCalls);
+
+    nb::CheckpointLog::forget(path);
+    std::vector<size_t> resumedCalls(3, 0);
+    std::ostringstream resumedOut;
+    ankerl::nanobench::Bench resumed;
+    resumed.output(&resumedOut).title("suite").epochs(5).epochIterations(100).checkpoint(path);
+    runSuite(resumed, 3, resumedCalls);
+
+    // only the benchmark that was not done yet is run
+    CHECK(resumedCalls[0] == 0U);
+    CHECK(resumedCalls[1] == 0U);
+    CHECK(resumedCalls[2] == 500U);
+
+    // and the others are exactly what they were, epoch by epoch and row by row
+    REQUIRE(resumed.results().size() == 3U);
+    for (size_t i = 0; i < 2U; ++i) {
+        auto const& before = interrupted.results()[i];
+        auto const& after = resumed.results()[i];
+        REQUIRE(after.size() == before.size());
+        for (size_t e = 0; e < before.size(); ++e) {
+            CHECK(after.get(e, Result::Measure::elapsed) == before.get(e, Result::Measure::elapsed));
+            CHECK(after.get(e, Result::Measure::iterations) == before.get(e, Result::Measure::iterations));
+        }
+    }
+    auto const resumedLines = linesOf(resumedOut.str());
+    for (auto const& line : linesOf(interruptedOut.str())) {
+        if (line.find("| `") != std::string::npos) {
+            INFO(line);
+            CHECK(std::find(resumedLines.begin(), resumedLines.end(), line) != resumedLines.end());
+        }
+    }
+
+    // the one measured by the resumed suite is in the file too now
+    nb::CheckpointLog::forget(path);
+    std::vector<size_t> againCalls(3, 0);
+    ankerl::nanobench::Bench again;
+    again.output(nullptr).title("suite").epochs(5).epochIterations(100).checkpoint(path);
+    runSuite(again, 3, againCalls);
+    CHECK(againCalls == std::vector<size_t>(3, 0));
+
+    // a different number of epochs is a different measurement
+    std::vector<size_t> changedCalls(3, 0);
+    ankerl::nanobench::Bench changed;
+    changed.output(nullptr).title("suite").epochs(7).epochIterations(100).checkpoint(path);
+    runSuite(changed, 1, changedCalls);
+    CHECK(changedCalls[0] == 700U);
+    std::remove(path.c_str());
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_checkpoint_repeated_name") {
+    std::string const path = "unit_checkpoint_repeated_name.bin";
+    startOver(path);
+
+    // The same benchmark twice, once cheap and once not: both are measured, the second is not
+    // restored from what the bench has just saved for the first.
+    uint64_t x = 0;
+    auto const work = [&x](size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            increment(x);
+        }
+    };
+    std::vector<size_t> interruptedCalls(2, 0);
+    ankerl::nanobench::Bench interrupted;
+    interrupted.output(nullptr).epochs(3).epochIterations(5).checkpoint(path);
+    interrupted.run("same", [&] {
+        ++interruptedCalls[0];
+        work(1);
+    });
+    interrupted.run("same", [&] {
+        ++interruptedCalls[1];
+        work(10000);
+    });
+    CHECK(interruptedCalls == std::vector<size_t>{15U, 15U});
+
+    // resumed, each run() gets the result saved by the same run() before, in order, and the one that
+    // was never done is measured
+    nb::CheckpointLog::forget(path);
+    std::vector<size_t> resumedCalls(3, 0);
+    ankerl::nanobench::Bench resumed;
+    resumed.output(nullptr).epochs(3).epochIterations(5).checkpoint(path);
+    for (size_t i = 0; i < 3U; ++i) {
+        resumed.run("same", [&] {
+            ++resumedCalls[i];
+            work(1);
+        });
+    }
+    CHECK(resumedCalls == std::vector<size_t>{0U, 0U, 15U});
+    REQUIRE(resumed.results().size() == 3U);
+    for (size_t i = 0; i < 2U; ++i) {
+        for (size_t e = 0; e < 3U; ++e) {
+            CHECK(resumed.results()[i].get(e, Result::Measure::elapsed) == interrupted.results()[i].get(e, Result::Measure::elapsed));
+        }
+    }
+    std::remove(path.c_str());
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_checkpoint_cut_short") {
+    std::string const path = "unit_checkpoint_cut_short.bin";
+    startOver(path);
+
+    std::vector<size_t> calls(3, 0);
+    ankerl::nanobench::Bench interrupted;
+    interrupted.output(nullptr).title("suite").epochs(5).epochIterations(100).checkpoint(path);
+    runSuite(interrupted, 1, calls);
+
+    // killed while appending the next result: the start of one is there, the rest is not
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        out.write("nanobnch\1\0\0\0\0\0\0\0\x08\x07", 18);
+    }
+
+    // what is complete is restored, and what is measured now is found again after the cut
+    nb::CheckpointLog::forget(path);
+    calls.assign(3, 0);
+    ankerl::nanobench::Bench resumed;
+    resumed.output(nullptr).title("suite").epochs(5).epochIterations(100).checkpoint(path);
+    runSuite(resumed, 2, calls);
+    CHECK(calls == std::vector<size_t>{0U, 500U, 0U});
+
+    nb::CheckpointLog::forget(path);
+    calls.assign(3, 0);
+    ankerl::nanobench::Bench again;
+    again.output(nullptr).title("suite").epochs(5).epochIterations(100).checkpoint(path);
+    runSuite(again, 3, calls);
+    CHECK(calls == std::vector<size_t>{0U, 0U, 500U});
+    std::remove(path.c_str());
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_checkpoint_same_process") {
+    std::string const path = "unit_checkpoint_same_process.bin";
+    startOver(path);
+
+    // Two benches of one process that share a name: the second one is measured too, rather than
+    // handed what the first one has only just measured.
+    std::vector<size_t> calls(3, 0);
+    ankerl::nanobench::Bench first;
+    first.output(nullptr).title("suite").epochs(5).epochIterations(100).checkpoint(path);
+    runSuite(first, 1, calls);
+    ankerl::nanobench::Bench second;
+    second.output(nullptr).title("suite").epochs(5).epochIterations(100).checkpoint(path);
+    runSuite(second, 1, calls);
+    CHECK(calls[0] == 1000U);
+    std::remove(path.c_str());
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_checkpoint_not_a_checkpoint") {
+    std::string const path = "unit_checkpoint_not_a_checkpoint.json";
+    startOver(path);
+    std::string const json = "{\"results\": [1, 2]}\n";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << json;
+    }
+
+    // the wrong file is measured without it, and left as it was
+    std::vector<size_t> calls(3, 0);
+    ankerl::nanobench::Bench bench;
+    bench.output(nullptr).title("suite").epochs(5).epochIterations(100).checkpoint(path);
+    runSuite(bench, 2, calls);
+    CHECK(calls == std::vector<size_t>{500U, 500U, 0U});
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream after;
+    after << in.rdbuf();
+    CHECK(after.str() == json);
+    std::remove(path.c_str());
+}
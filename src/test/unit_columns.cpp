@@ -2,6 +2,7 @@
 #include <thirdparty/doctest/doctest.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <exception>
 #include <limits>
@@ -503,3 +504,85 @@ TEST_CASE("unit_columns_complexity_zero_is_not_a_complexity") {
     bench.complexityN(0).run("x", [] {});
     CHECK_FALSE(hasCell(headerCells(oss.str()), "complexityN"));
 }
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_columns_confidence_intervals") {
+    using ankerl::nanobench::Column;
+
+    uint64_t x = 0;
+    auto const op = [&] {
+        ankerl::nanobench::doNotOptimizeAway(x += 1);
+    };
+
+    std::ostringstream oss;
+    ankerl::nanobench::Bench bench;
+    bench.output(&oss)
+        .title("confidence_intervals")
+        .warmup(0)
+        .epochs(11)
+        .epochIterations(1000)
+        .performanceCounters(false)
+        .relative(true)
+        .confidenceIntervals(true);
+    bench.run("first", op).run("second", op);
+
+    INFO(oss.str());
+    auto header = headerCells(oss.str());
+    REQUIRE_FALSE(header.empty());
+    header.pop_back();
+    CHECK(header == std::vector<std::string>{"relative", "relative 95% CI", "ns/op", "op/s", "err%", "median 95% CI", "total"});
+
+    // the first run is what the others are relative to, so it has no interval of its own there
+    auto const first = dataCells(oss.str(), 0);
+    auto const second = dataCells(oss.str(), 1);
+    REQUIRE(first.size() == header.size() + 1U);
+    REQUIRE(second.size() == header.size() + 1U);
+    CHECK(first[1].empty());
+    CHECK(second[1].find("% .. ") != std::string::npos);
+
+    // what the interval says is tested on known epochs in unit_columns_median_interval_text
+    CHECK(first[5].find("% .. ") != std::string::npos);
+
+    // two epochs have no 95% interval: the column stays, its cell is blank
+    std::ostringstream few;
+    ankerl::nanobench::Bench fewBench;
+    configure(fewBench, few, "confidence_intervals_few");
+    fewBench.confidenceIntervals(true).run("few", op);
+    auto const fewHeader = headerCells(few.str());
+    auto const fewCells = dataCells(few.str(), 0);
+    auto const at = static_cast<size_t>(std::find(fewHeader.begin(), fewHeader.end(), "median 95% CI") - fewHeader.begin());
+    REQUIRE(at < fewCells.size());
+    CHECK(fewCells[at].empty());
+
+    // and hideColumn() applies as to any other column
+    std::ostringstream hidden;
+    ankerl::nanobench::Bench hiddenBench;
+    configure(hiddenBench, hidden, "confidence_intervals_hidden");
+    hiddenBench.confidenceIntervals(true).hideColumn(Column::medianInterval).run("hidden", op);
+    CHECK_FALSE(hasCell(headerCells(hidden.str()), "median 95% CI"));
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_columns_median_interval_text") {
+    using ankerl::nanobench::Result;
+    auto const resultOf = [](std::vector<int64_t> const& nanos) {
+        Result r{ankerl::nanobench::Config{}};
+        auto& pc = ankerl::nanobench::detail::performanceCounters();
+        for (auto ns : nanos) {
+            r.add(std::chrono::nanoseconds(ns), 1, pc);
+        }
+        return r;
+    };
+
+    // the median lies inside its own interval, so the offsets are a minus and a plus
+    CHECK(ankerl::nanobench::detail::medianIntervalText(resultOf({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11})) ==
+          "-66.7% .. +66.7%");
+
+    // every epoch below the median read the same tick of a coarse clock: the interval starts right
+    // at the median, which is an offset of 0
+    CHECK(ankerl::nanobench::detail::medianIntervalText(resultOf({10, 10, 10, 10, 10, 10, 11, 12, 13, 14, 15})) ==
+          "+0.0% .. +40.0%");
+
+    // too few epochs for a 95% interval
+    CHECK(ankerl::nanobench::detail::medianIntervalText(resultOf({1, 2, 3})).empty());
+}
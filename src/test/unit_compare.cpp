@@ -4,7 +4,10 @@
 #include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <cstdio>
+#include <fstream>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <vector>
@@ -1274,3 +1277,387 @@ TEST_CASE("unit_compare_fastest_is_a_selection_over_the_medians") {
     // and nothing to choose from is entry 0, not an out of range index
     CHECK(arrange({}).fastest() == 0U);
 }
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_compare_sequential_stops_when_narrow_enough") {
+    Work w;
+    auto op = [&w] {
+        w.step();
+    };
+
+    // Any interval is within +-1000%, so the first look is the last - and it
+    // was made at half the error rate, because it had to leave room for looks
+    // that turned out not to be needed.
+    auto const loose = quiet(20).compareTargetWidth(10.0).compare("a", op, "b", op);
+    CHECK(loose.looks() == 1U);
+    CHECK(loose.rounds() == 20U);
+    CHECK(loose.confidence() == doctest::Approx(1.0 - 0.05 / 2.0));
+
+    // no target: one look at the plain Bonferroni confidence, as always
+    auto const fixed = quiet(20).compare("a", op, "b", op);
+    CHECK(fixed.looks() == 1U);
+    CHECK(fixed.confidence() == doctest::Approx(0.95));
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_compare_sequential_stops_at_the_budget") {
+    Work w;
+    auto op = [&w] {
+        w.step();
+    };
+
+    // A width no measurement reaches keeps adding rounds until the budget is
+    // gone, and every look spends more of the error rate.
+    auto const result = quiet(6)
+                            .minEpochTime(std::chrono::microseconds(100))
+                            .compareTargetWidth(1e-12)
+                            .compareTimeBudget(std::chrono::milliseconds(50))
+                            .compare("a", op, "b", op);
+    INFO("looks " << result.looks() << ", rounds " << result.rounds());
+    CHECK(result.looks() > 1U);
+    CHECK(result.rounds() > 6U);
+    CHECK(result.rounds() % 2U == 0U);
+    auto const look = static_cast<double>(result.looks());
+    CHECK(result.confidence() == doctest::Approx(1.0 - 0.05 / (look * (look + 1.0))));
+
+    std::ostringstream out;
+    out << result;
+    CHECK(out.str().find("stopped after") != std::string::npos);
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_compare_racing_drops_the_clearly_slower") {
+    // 25x slower is clear after the first look, and every round after that
+    // would only have confirmed it. The gap is as wide as in the test above,
+    // for the same reason.
+    Work a;
+    Work b;
+    Work c;
+    auto bench = quiet(60);
+    bench.compareRacing(true);
+    auto const result = bench.compare(
+        "baseline",
+        [&] {
+            a.step();
+        },
+        "same",
+        [&] {
+            b.step();
+        },
+        "twenty five times",
+        [&] {
+            for (int i = 0; i < 25; ++i) {
+                c.step();
+            }
+        });
+
+    REQUIRE(result.size() == 3U);
+    INFO("rounds " << result.rounds() << ", slow one got " << result[2].result.size());
+    CHECK(result.rounds() >= 60U);
+    CHECK(result[0].result.size() == result.rounds());
+    CHECK_FALSE(result.isDropped(0));
+    // Not asserted for "same": two copies of the same work can differ by a
+    // few percent for code alignment alone, and over 60 rounds that can be
+    // resolved and dropped on its merits.
+
+    // still in the result, with the rounds it got, and still resolvably slower
+    CHECK(result.isDropped(2));
+    CHECK(result[2].result.size() < result.rounds());
+    CHECK(result[2].relative < 1.0);
+    CHECK(result.isSignificant(2));
+    CHECK(result.looks() > 1U);
+
+    std::ostringstream out;
+    out << result;
+    CHECK(out.str().find("`twenty five times` (dropped after " + std::to_string(result[2].result.size()) + " rounds)") !=
+          std::string::npos);
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_compare_sweep_finds_the_crossover") {
+    // n steps against a fixed 64: the first is 16x faster at n=4 and 16x
+    // slower at n=1024, far enough from the crossover at 64 that the winner on
+    // either side is not in doubt.
+    Work a;
+    Work b;
+    std::ostringstream out;
+    auto bench = quiet(20);
+    bench.output(&out).title("find");
+    auto const sweep = bench.compareSweep(
+        {4, 16, 1024}, "linear",
+        [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                a.step();
+            }
+        },
+        "constant",
+        [&](size_t /*n*/) {
+            for (size_t i = 0; i < 64; ++i) {
+                b.step();
+            }
+        });
+
+    REQUIRE(sweep.size() == 3U);
+    CHECK(sweep.sizes() == std::vector<size_t>{4, 16, 1024});
+    CHECK(sweep[0].fastest() == 0U);
+    CHECK(sweep[2].fastest() == 1U);
+    CHECK(sweep[0].isSignificant(1));
+    CHECK(sweep[2].isSignificant(1));
+    CHECK(sweep.crossovers() == std::vector<size_t>{2});
+
+    // each size is a whole comparison, and its results know the size they ran at
+    CHECK(sweep[2].rounds() == 20U);
+    CHECK(sweep[2][1].result.config().mComplexityN == doctest::Approx(1024.0));
+
+    // one table for the sweep, and the bench is left the way it was
+    auto const text = out.str();
+    INFO(text);
+    CHECK(text.find(" linear | ") != std::string::npos);
+    CHECK(text.find(" constant | find") != std::string::npos);
+    CHECK(text.find("fastest changes from `linear` to `constant` between n=16 and n=1024") != std::string::npos);
+    CHECK(bench.output() == &out);
+    CHECK(bench.complexityN() < 0.0);
+}
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+// NOLINTNEXTLINE
+TEST_CASE("unit_compare_sweep_restores_the_bench_when_an_op_throws") {
+    std::ostringstream out;
+    auto bench = quiet(5);
+    bench.output(&out);
+    auto const op = [](size_t n) {
+        if (n > 4U) {
+            throw std::runtime_error("op failed");
+        }
+    };
+    CHECK_THROWS_AS(bench.compareSweep({4, 16}, "a", op, "b", op), std::runtime_error);
+    CHECK(bench.output() == &out);
+    CHECK(bench.complexityN() < 0.0);
+}
+#endif
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_compare_ratios_for_every_measure") {
+    Work a;
+    Work b;
+    auto const result = quiet(20).compare(
+        "a",
+        [&] {
+            a.step();
+        },
+        "b",
+        [&] {
+            b.step();
+        });
+
+    using M = ankerl::nanobench::Result::Measure;
+    REQUIRE(result.size() == 2U);
+    // the time's ratio is the one in the entry itself
+    auto const elapsed = result[1].ratio(M::elapsed);
+    CHECK(elapsed.relative == doctest::Approx(result[1].relative));
+    CHECK(elapsed.relativeLow == doctest::Approx(result[1].relativeLow));
+    CHECK(elapsed.relativeHigh == doctest::Approx(result[1].relativeHigh));
+
+    // both sides ran the same iterations, so that ratio is exactly 1 with no width at all
+    CHECK(result[1].ratio(M::iterations).relativeLow == doctest::Approx(1.0));
+    CHECK(result[1].ratio(M::iterations).relativeHigh == doctest::Approx(1.0));
+    CHECK(result[0].ratio(M::elapsed).relative == doctest::Approx(1.0));
+
+    // counters were off, so there is nothing to pair
+    CHECK(result[1].ratio(M::instructions).relative == doctest::Approx(0.0));
+    CHECK(result[1].ratio(M::_size).relative == doctest::Approx(0.0));
+    CHECK(nb::pairedLogRatios(result[0].result, result[1].result, M::instructions).empty());
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_compare_counter_ratios_when_available") {
+    // Skipped rather than failed where perf_event_open is refused, as in
+    // unit_perf_counters_are_consistent_when_available.
+    if (!nb::performanceCounters().has().instructions) {
+        MESSAGE("no hardware performance counters here, skipping");
+        return;
+    }
+
+    // twice the work is twice the instructions, and the interval for that is
+    // far narrower than the time's
+    Work a;
+    Work b;
+    std::ostringstream out;
+    auto bench = quiet(20);
+    bench.output(&out).performanceCounters(true);
+    auto const result = bench.compare(
+        "once",
+        [&] {
+            a.step();
+        },
+        "twice",
+        [&] {
+            b.step();
+            b.step();
+        });
+
+    auto const instructions = result[1].ratio(ankerl::nanobench::Result::Measure::instructions);
+    INFO(out.str());
+    CHECK(instructions.relative == doctest::Approx(0.5).epsilon(0.1));
+    CHECK(instructions.relativeLow <= instructions.relative);
+    CHECK(instructions.relativeHigh >= instructions.relative);
+    CHECK(out.str().find("`twice`: instructions 0.5") != std::string::npos);
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_compare_noise_floor_file") {
+    std::string const path = "unit_compare_noise_floor_file.txt";
+    ankerl::nanobench::NoiseFloor const saved{40, 12, 3, 0.0125};
+    REQUIRE(nb::saveNoiseFloor(path, saved));
+
+    ankerl::nanobench::NoiseFloor loaded{};
+    REQUIRE(nb::loadNoiseFloor(path, loaded));
+    CHECK(loaded.runs == 40U);
+    CHECK(loaded.rounds == 12U);
+    CHECK(loaded.falsePositives == 3U);
+    CHECK(loaded.halfWidth == doctest::Approx(0.0125));
+
+    // anything else leaves it alone
+    {
+        std::ofstream out(path);
+        out << "40 12 3 0.0125\n";
+    }
+    ankerl::nanobench::NoiseFloor untouched{1, 2, 3, 4.0};
+    CHECK_FALSE(nb::loadNoiseFloor(path, untouched));
+    CHECK_FALSE(nb::loadNoiseFloor("unit_compare_noise_floor_that_does_not_exist.txt", untouched));
+    CHECK(untouched.runs == 1U);
+    std::remove(path.c_str());
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_compare_noise_floor_warnings") {
+    auto const warnings = [](ankerl::nanobench::NoiseFloor const& floor, double targetWidth) {
+        std::ostringstream os;
+        nb::writeNoiseFloorWarnings(os, floor, targetWidth);
+        return os.str();
+    };
+
+    // 2 of 40 is what 5% looks like, and 6 of 40 is still within its luck
+    CHECK(warnings({40, 12, 2, 0.02}, 0.0).empty());
+    CHECK(warnings({40, 12, 6, 0.02}, 0.0).empty());
+    CHECK(warnings({40, 12, 7, 0.02}, 0.0).find("in 7 of 40 calibration runs") != std::string::npos);
+    CHECK(warnings({10, 12, 4, 0.02}, 0.0).find("in 4 of 10") != std::string::npos);
+
+    // a target wider than the floor is fine, a narrower one costs rounds
+    CHECK(warnings({40, 12, 0, 0.02}, 0.05).empty());
+    CHECK(warnings({40, 12, 0, 0.02}, 0.01).find("noise floor here is +-2.0% at 12 rounds, so +-1.0% takes about 48 rounds") !=
+          std::string::npos);
+
+    // nothing calibrated, nothing to say
+    CHECK(warnings({0, 0, 0, 0.0}, 0.01).empty());
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_compare_calibrate_noise") {
+    std::string const path = "unit_compare_calibrate_noise.txt";
+    std::remove(path.c_str());
+
+    std::ostringstream out;
+    auto bench = quiet(10);
+    bench.output(&out).noiseFloor(path).compareTargetWidth(0.5).compareRacing(true);
+    auto const floor = bench.calibrateNoise(5);
+    CHECK(floor.runs == 5U);
+    CHECK(floor.rounds >= 10U);
+    CHECK(floor.falsePositives <= 5U);
+    CHECK(floor.halfWidth > 0.0);
+    CHECK(out.str().find("A/A comparisons, nominally 5%") != std::string::npos);
+
+    // the settings it switched off for calibrating are back
+    CHECK(bench.output() == &out);
+    CHECK(bench.compareTargetWidth() == doctest::Approx(0.5));
+    CHECK(bench.compareRacing());
+
+    ankerl::nanobench::NoiseFloor loaded{};
+    REQUIRE(nb::loadNoiseFloor(path, loaded));
+    CHECK(loaded.rounds == floor.rounds);
+    CHECK(loaded.halfWidth == doctest::Approx(floor.halfWidth));
+
+    // a later comparison asking for far less than the floor is told so
+    Work w;
+    auto op = [&w] {
+        w.step();
+    };
+    std::ostringstream compared;
+    bench.output(&compared)
+        .compareRacing(false)
+        .compareTargetWidth(floor.halfWidth / 100.0)
+        .compareTimeBudget(std::chrono::milliseconds(20))
+        .compare("a", op, "b", op);
+    CHECK(compared.str().find("warning: the noise floor here is") != std::string::npos);
+    std::remove(path.c_str());
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_compare_calibrate_noise_without_equivalence") {
+    // a margin too narrow to ever be decided would keep every run going until the time budget is
+    // used up, so calibrating with one would count a different number of rounds
+    auto plain = quiet(10);
+    auto withMargin = quiet(10);
+    withMargin.compareEquivalence(1e-6).compareTimeBudget(std::chrono::milliseconds(50));
+    auto const floor = plain.calibrateNoise(2);
+    CHECK(withMargin.calibrateNoise(2).rounds == floor.rounds);
+    CHECK(withMargin.compareEquivalence() == doctest::Approx(1e-6));
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_compare_equivalence_of_an_interval") {
+    using ankerl::nanobench::Equivalence;
+    auto const within = std::log1p(0.02);
+
+    // all of it inside - the edges included - all of it outside on either side,
+    // and across an edge
+    CHECK(nb::equivalenceOf({-0.01, 0.01}, 0.02) == Equivalence::equivalent);
+    CHECK(nb::equivalenceOf({-within, within}, 0.02) == Equivalence::equivalent);
+    CHECK(nb::equivalenceOf({0.05, 0.10}, 0.02) == Equivalence::notEquivalent);
+    CHECK(nb::equivalenceOf({-0.10, -0.05}, 0.02) == Equivalence::notEquivalent);
+    CHECK(nb::equivalenceOf({-0.01, 0.05}, 0.02) == Equivalence::inconclusive);
+
+    // an interval wider than the margin on both sides decides nothing, however centred
+    CHECK(nb::equivalenceOf({-0.05, 0.05}, 0.02) == Equivalence::inconclusive);
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_compare_equivalence") {
+    using ankerl::nanobench::Equivalence;
+    Work a;
+    Work b;
+    Work c;
+    std::ostringstream out;
+    auto bench = quiet(20);
+    bench.output(&out).compareEquivalence(0.5).compareTimeBudget(std::chrono::seconds(2));
+    auto const result = bench.compare(
+        "a",
+        [&] {
+            a.step();
+        },
+        "same",
+        [&] {
+            b.step();
+        },
+        "ten times",
+        [&] {
+            for (int i = 0; i < 10; ++i) {
+                c.step();
+            }
+        });
+
+    // identical work is well within +-50%, and ten times the work well outside
+    INFO(out.str());
+    CHECK(result.equivalenceMargin() == doctest::Approx(0.5));
+    CHECK(result.equivalence(0) == Equivalence::equivalent);
+    CHECK(result.equivalence(1) == Equivalence::equivalent);
+    CHECK(result.equivalence(2) == Equivalence::notEquivalent);
+    CHECK(out.str().find("Equivalence within +-50.0% of `a`") != std::string::npos);
+    CHECK(out.str().find("`same` is equivalent, 95% CI [") != std::string::npos);
+    CHECK(out.str().find("`ten times` is not equivalent") != std::string::npos);
+
+    // without a margin there is no such claim to make
+    auto const plain = quiet(20).compare("a", [&] { a.step(); }, "b", [&] { b.step(); });
+    CHECK(plain.equivalenceMargin() == doctest::Approx(0.0));
+    CHECK(plain.equivalence(1) == Equivalence::inconclusive);
+}
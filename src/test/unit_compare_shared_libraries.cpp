@@ -0,0 +1,40 @@
+#include <nanobench.h>
+#include <thirdparty/doctest/doctest.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// compareSharedLibraries() is compare() with the alternatives loaded from disk.
+// The statistics are compare()'s and tested there; what is tested here is the
+// loading: that two builds of the same library with the same symbol are told
+// apart rather than one of them resolving to the other, and that a library
+// that is not there is an error rather than a comparison of nothing.
+//
+// The two libraries are built by src/test/CMakeLists.txt, and the second does
+// four times the work of the first. nb is built with ANKERL_NANOBENCH_DLOPEN.
+#if ANKERL_NANOBENCH(DLOPEN)
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_compare_shared_libraries") {
+    std::vector<std::string> const paths = {NB_COMPARE_OP_1, NB_COMPARE_OP_4};
+    auto const result = ankerl::nanobench::Bench().output(nullptr).epochs(20).compareSharedLibraries(paths, "nanobench_op");
+
+    REQUIRE(result.size() == 2U);
+    CHECK(result[0].name == paths[0]);
+    CHECK(result[1].name == paths[1]);
+    INFO("ratio " << result[1].relative << " [" << result[1].relativeLow << ", " << result[1].relativeHigh << "]");
+    CHECK(result[1].relative < 0.5);
+    CHECK(result.isSignificant(1));
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_compare_shared_libraries_errors") {
+    ankerl::nanobench::Bench bench;
+    bench.output(nullptr);
+    CHECK_THROWS_AS(bench.compareSharedLibraries({NB_COMPARE_OP_1}, "nanobench_op"), std::runtime_error);
+    CHECK_THROWS_AS(bench.compareSharedLibraries({NB_COMPARE_OP_1, "no_such_library.so"}, "nanobench_op"), std::runtime_error);
+    CHECK_THROWS_AS(bench.compareSharedLibraries({NB_COMPARE_OP_1, NB_COMPARE_OP_4}, "no_such_symbol"), std::runtime_error);
+}
+
+#endif
@@ -182,7 +182,7 @@ TEST_CASE("unit_env_config_rejects") {
     CHECK(singleError("epoch=3") ==
           "NANOBENCH_CONFIG: unknown key 'epoch' - valid keys are "
           "clockResolutionMultiple, epochIterations, epochs, "
-          "maxEpochTime, minEpochIterations, minEpochTime, warmup");
+          "maxEpochTime, minEpochIterations, minEpochTime, progress, warmup");
     // keys are the Bench setter names verbatim, so they are case sensitive
     CHECK(singleError("Epochs=3").find("unknown key 'Epochs'") !=
           std::string::npos);
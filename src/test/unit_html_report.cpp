@@ -0,0 +1,117 @@
+#include <nanobench.h>
+#include <thirdparty/doctest/doctest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// The report has to work where there is no network, so nothing in it may be
+// fetched - no script, no stylesheet, no font. And it is attached to every CI
+// run, so its size has to grow with the number of epochs by a few bytes each,
+// not by a DOM element each.
+namespace {
+
+namespace nb = ankerl::nanobench::detail;
+using ankerl::nanobench::CompareResult;
+using ankerl::nanobench::Config;
+using ankerl::nanobench::HtmlReport;
+using ankerl::nanobench::Result;
+
+Result resultOf(std::string const& title, std::string const& name, double complexityN, std::vector<int64_t> const& nanos) {
+    Config config;
+    config.mBenchmarkTitle = title;
+    config.mBenchmarkName = name;
+    config.mComplexityN = complexityN;
+    config.mOutlierMethod = ankerl::nanobench::OutlierMethod::tukey;
+    Result r{config};
+    auto& pc = nb::performanceCounters();
+    for (auto ns : nanos) {
+        r.add(std::chrono::nanoseconds(ns), 1, pc);
+    }
+    return r;
+}
+
+std::string written(HtmlReport const& report) {
+    std::ostringstream oss;
+    report.write(oss);
+    return oss.str();
+}
+
+size_t count(std::string const& text, std::string const& needle) {
+    size_t n = 0;
+    for (auto pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1U)) {
+        ++n;
+    }
+    return n;
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_html_report_offline") {
+    std::vector<Result> const results = {resultOf("sort", "std::sort<int>", 0, {10, 11, 10, 12, 11, 100, 10}),
+                                         resultOf("sort", "std::stable_sort", 0, {20, 21, 20, 22, 21, 20, 20}),
+                                         resultOf("find", "std::find", 0, {5, 5, 6})};
+    HtmlReport report("nightly & weekly");
+    report.add(results);
+    auto const html = written(report);
+
+    CHECK(html.find("<script") == std::string::npos);
+    CHECK(html.find("http") == std::string::npos);
+    CHECK(html.find("<title>nightly &amp; weekly</title>") != std::string::npos);
+
+    // one section per title, with a box plot and a scatter plot each
+    CHECK(count(html, "<h2>") == 2U);
+    CHECK(count(html, "<svg") == 4U);
+    CHECK(html.find("std::sort&lt;int&gt;") != std::string::npos);
+    // the 100ns epoch is an outlier, drawn as a dot past the whisker and hollow in the scatter plot
+    CHECK(count(html, "class=\"p\"") == 1U);
+    CHECK(count(html, "class=\"o\"") == 1U);
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_html_report_complexity") {
+    std::vector<Result> results;
+    for (int n = 10; n <= 10000; n *= 10) {
+        results.push_back(resultOf("scan", "n", n, {n, n, n}));
+    }
+    auto const html = written(HtmlReport().add(results));
+    CHECK(html.find("<h3>complexity</h3>") != std::string::npos);
+    CHECK(html.find("* O(n),") != std::string::npos);
+    CHECK(html.find("class=\"f\"") != std::string::npos);
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_html_report_compare") {
+    auto const r = resultOf("t", "x", 0, {10, 10, 10});
+    std::vector<CompareResult::Entry> entries;
+    entries.emplace_back("base", r, 1.0, 1.0, 1.0, 0U);
+    entries.emplace_back("faster", r, 2.0, 1.8, 2.2, 0U);
+    entries.emplace_back("same", r, 1.01, 0.9, 1.1, 3U);
+    entries.emplace_back("slower", r, 0.5, 0.45, 0.55, 0U);
+    CompareResult const compareResult(std::move(entries), 3);
+
+    auto const html = written(HtmlReport().add("hashes", compareResult));
+    CHECK(html.find("<h2>hashes</h2>") != std::string::npos);
+    CHECK(count(html, "<circle") == 4U);
+    CHECK(count(html, "<g class=\"u\">") == 1U);
+    CHECK(count(html, "<g class=\"d\">") == 1U);
+    CHECK(count(html, "<g class=\"n\">") == 2U);
+    CHECK(html.find("same: 1.01x [0.9x, 1.1x], 3 tied rounds") != std::string::npos);
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_html_report_size") {
+    // a thousand benchmarks of 11 epochs each
+    std::vector<Result> results;
+    for (int i = 0; i < 1000; ++i) {
+        results.push_back(resultOf("title " + std::to_string(i / 10), "benchmark " + std::to_string(i),
+                                   0, {100, 101, 99, 100, 102, 98, 100, 101, 99, 100, 103}));
+    }
+    auto const html = written(HtmlReport().add(results));
+    INFO("bytes: " << html.size());
+    CHECK(html.size() < 2000U * 1000U);
+}
@@ -0,0 +1,113 @@
+#include <nanobench.h>
+#include <thirdparty/doctest/doctest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// A JSON Lines file is read while it is still being written, by tools that
+// know nothing about nanobench: every line has to be one complete object, and
+// a benchmark name with a quote in it must not take the line down with it.
+namespace {
+
+namespace nb = ankerl::nanobench::detail;
+using ankerl::nanobench::Result;
+
+Result resultOf(char const* name, std::vector<int64_t> const& nanos) {
+    ankerl::nanobench::Config config;
+    config.mBenchmarkName = name;
+    config.mContext["type"] = "int";
+    Result r{config};
+    auto& pc = nb::performanceCounters();
+    for (auto ns : nanos) {
+        r.add(std::chrono::nanoseconds(ns), 1, pc);
+    }
+    return r;
+}
+
+std::vector<std::string> linesOf(std::string const& path) {
+    std::vector<std::string> lines;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+size_t count(std::string const& str, std::string const& what) {
+    size_t n = 0;
+    for (auto pos = str.find(what); pos != std::string::npos; pos = str.find(what, pos + 1)) {
+        ++n;
+    }
+    return n;
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_json_lines_line") {
+    auto const r = resultOf("a \"quoted\"\tname\\", {10, 20, 30});
+
+    std::ostringstream plain;
+    nb::writeJsonLine(plain, r, false);
+    auto const line = plain.str();
+    INFO(line);
+    REQUIRE(count(line, "\n") == 1U);
+    CHECK(line.back() == '\n');
+    CHECK(line.front() == '{');
+    CHECK(line.find(R"("name":"a \"quoted\"\tname\\")") != std::string::npos);
+    CHECK(line.find(R"("context":{"type":"int"})") != std::string::npos);
+    CHECK(line.find("\"median(elapsed)\":2") != std::string::npos);
+    CHECK(line.find(R"("outliers":0)") != std::string::npos);
+    CHECK(line.find("measurements") == std::string::npos);
+
+    std::ostringstream withMeasurements;
+    nb::writeJsonLine(withMeasurements, r, true);
+    CHECK(count(withMeasurements.str(), R"("iterations":1,)") == 3U);
+    CHECK(count(withMeasurements.str(), "\n") == 1U);
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_json_lines_bench") {
+    std::string const path = "unit_json_lines_bench.jsonl";
+    std::remove(path.c_str());
+
+    uint64_t x = 0;
+    ankerl::nanobench::Bench bench;
+    bench.output(nullptr).epochs(3).epochIterations(10).performanceCounters(false).jsonLines(path, true);
+
+    // each benchmark is there as soon as it is done, not when the bench is
+    bench.run("first", [&] {
+        ankerl::nanobench::doNotOptimizeAway(x += 1);
+    });
+    auto lines = linesOf(path);
+    REQUIRE(lines.size() == 1U);
+    CHECK(lines[0].find(R"("name":"first")") != std::string::npos);
+    CHECK(count(lines[0], R"("iterations":10,)") == 3U);
+
+    bench.jsonLines(path).run("second", [&] {
+        ankerl::nanobench::doNotOptimizeAway(x += 2);
+    });
+    lines = linesOf(path);
+    REQUIRE(lines.size() == 2U);
+    CHECK(lines[1].find(R"("name":"second")") != std::string::npos);
+    CHECK(lines[1].find("measurements") == std::string::npos);
+
+    // a comparison is not a result of its own
+    bench.compare(
+        "a",
+        [&] {
+            ankerl::nanobench::doNotOptimizeAway(x += 1);
+        },
+        "b",
+        [&] {
+            ankerl::nanobench::doNotOptimizeAway(x += 2);
+        });
+    CHECK(linesOf(path).size() == 2U);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,303 @@
+#include <nanobench.h>
+#include <thirdparty/doctest/doctest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// A result read back has to be the result that was written: the same epochs,
+// so that every statistic comes out the same, and the same config, so that a
+// result merged across processes is recognized as the same benchmark. All three
+// formats are checked against what the bench had in memory.
+namespace {
+
+using ankerl::nanobench::Result;
+
+void increment(uint64_t& x) {
+    ankerl::nanobench::doNotOptimizeAway(x += 1);
+}
+
+ankerl::nanobench::Bench benched(char const* name) {
+    uint64_t x = 0;
+    ankerl::nanobench::Bench bench;
+    bench.output(nullptr).title("load").unit("byte").epochs(5).epochIterations(10).batch(4).complexityN(100);
+    bench.context("type", "int").run(name, [&] {
+        increment(x);
+    });
+    return bench;
+}
+
+// The json template writes numbers at the stream's default precision, JSON Lines and the binary
+// format every bit of them.
+void checkSameEpochs(Result const& loaded, Result const& original, bool isExact = true) {
+    REQUIRE(loaded.size() == original.size());
+    CHECK(loaded.config().mBenchmarkTitle == original.config().mBenchmarkTitle);
+    CHECK(loaded.config().mBenchmarkName == original.config().mBenchmarkName);
+    CHECK(loaded.config().mUnit == original.config().mUnit);
+    CHECK(loaded.config().mBatch == doctest::Approx(original.config().mBatch));
+    CHECK(loaded.config().mComplexityN == doctest::Approx(original.config().mComplexityN));
+    for (size_t i = 0; i < original.size(); ++i) {
+        auto const elapsed = loaded.get(i, Result::Measure::elapsed);
+        auto const expected = original.get(i, Result::Measure::elapsed);
+        if (isExact) {
+            CHECK(elapsed == expected);
+        } else {
+            CHECK(elapsed == doctest::Approx(expected));
+        }
+        CHECK(loaded.get(i, Result::Measure::iterations) == original.get(i, Result::Measure::iterations));
+    }
+    auto const median = loaded.median(Result::Measure::elapsed);
+    auto const expected = original.median(Result::Measure::elapsed);
+    if (isExact) {
+        CHECK(median == expected);
+    } else {
+        CHECK(median == doctest::Approx(expected));
+    }
+}
+
+void writeFile(std::string const& path, std::string const& contents) {
+    std::ofstream out(path, std::ios::binary);
+    out << contents;
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_load_results_json") {
+    std::string const path = "unit_load_results_json.json";
+    auto const bench = benched("x");
+    {
+        std::ofstream out(path);
+        ankerl::nanobench::render(ankerl::nanobench::templates::json(), bench, out);
+    }
+
+    auto const loaded = ankerl::nanobench::loadResults(path);
+    REQUIRE(loaded.size() == 1U);
+    checkSameEpochs(loaded.front(), bench.results().front(), false);
+    std::remove(path.c_str());
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_load_results_json_lines") {
+    std::string const path = "unit_load_results_json_lines.jsonl";
+    std::remove(path.c_str());
+
+    uint64_t x = 0;
+    ankerl::nanobench::Bench bench;
+    bench.output(nullptr).epochs(3).epochIterations(10).jsonLines(path, true);
+    bench.context("type", "a \"quoted\"\tvalue").run("first", [&] {
+        increment(x);
+    });
+    bench.clearContext().run("second", [&] {
+        increment(x);
+    });
+
+    auto const loaded = ankerl::nanobench::loadResults(path);
+    REQUIRE(loaded.size() == 2U);
+    checkSameEpochs(loaded[0], bench.results()[0]);
+    checkSameEpochs(loaded[1], bench.results()[1]);
+    CHECK(loaded[0].config().mContext.at("type") == "a \"quoted\"\tvalue");
+    CHECK(loaded[1].config().mContext.empty());
+    std::remove(path.c_str());
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_load_results_binary") {
+    std::string const path = "unit_load_results_binary.bin";
+    auto const bench = benched("x");
+    REQUIRE(ankerl::nanobench::saveResults(path, bench));
+
+    auto const loaded = ankerl::nanobench::loadResults(path);
+    REQUIRE(loaded.size() == 1U);
+    checkSameEpochs(loaded.front(), bench.results().front());
+    CHECK(loaded.front().config().mContext.at("type") == "int");
+    std::remove(path.c_str());
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_load_results_google_benchmark_template") {
+    std::string const path = "unit_load_results_google_benchmark.json";
+    auto const bench = benched("std::sort");
+    {
+        std::ofstream out(path);
+        ankerl::nanobench::render(ankerl::nanobench::templates::googleBenchmark(), bench, out);
+    }
+
+    // the aggregates are not epochs, and the named argument is the context again
+    auto const loaded = ankerl::nanobench::loadResults(path);
+    REQUIRE(loaded.size() == 1U);
+    checkSameEpochs(loaded.front(), bench.results().front(), false);
+    CHECK(loaded.front().config().mContext.at("type") == "int");
+    std::remove(path.c_str());
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_load_results_google_benchmark_native") {
+    // as Google Benchmark writes it with --benchmark_repetitions=2
+    std::string const path = "unit_load_results_google_benchmark_native.json";
+    writeFile(path, R"({
+  "context": {"date": "2024-01-01T00:00:00+00:00", "num_cpus": 8, "caches": [{"type": "Data", "level": 1, "size": 32768}],
+              "load_avg": [0.5, 0.4, 0.3]},
+  "benchmarks": [
+    {"name": "BM_sort/8", "run_name": "BM_sort/8", "run_type": "iteration", "repetitions": 2, "repetition_index": 0,
+     "threads": 1, "iterations": 1000, "real_time": 1.5e+01, "cpu_time": 1.5e+01, "time_unit": "ns", "items_per_second": 6.6e+07},
+    {"name": "BM_sort/8", "run_name": "BM_sort/8", "run_type": "iteration", "repetitions": 2, "repetition_index": 1,
+     "threads": 1, "iterations": 2000, "real_time": 1.7e+01, "cpu_time": 1.6e+01, "time_unit": "ns", "items_per_second": 6.2e+07},
+    {"name": "BM_sort/8_mean", "run_name": "BM_sort/8", "run_type": "aggregate", "aggregate_name": "mean",
+     "iterations": 2, "real_time": 1.6e+01, "cpu_time": 1.55e+01, "time_unit": "ns"},
+    {"name": "BM_copy/size:64/std::copy", "run_name": "BM_copy/size:64/std::copy", "run_type": "iteration",
+     "iterations": 10, "real_time": 2.0, "cpu_time": 2.0, "time_unit": "us"},
+    {"name": "BM_fail", "run_name": "BM_fail", "run_type": "iteration", "error_occurred": true, "error_message": "x",
+     "iterations": 0, "real_time": 0, "cpu_time": 0, "time_unit": "ns"}
+  ]
+})");
+
+    auto const loaded = ankerl::nanobench::loadResults(path);
+    REQUIRE(loaded.size() == 2U);
+    auto const& sort = loaded[0];
+    CHECK(sort.config().mBenchmarkName == "BM_sort/8");
+    REQUIRE(sort.size() == 2U);
+    CHECK(sort.get(0, Result::Measure::elapsed) == doctest::Approx(15e-9));
+    CHECK(sort.get(1, Result::Measure::iterations) == doctest::Approx(2000));
+    CHECK(sort.median(Result::Measure::elapsed) == doctest::Approx(16e-9));
+    CHECK_FALSE(sort.has(Result::Measure::instructions));
+
+    auto const& copy = loaded[1];
+    CHECK(copy.config().mBenchmarkName == "BM_copy/std::copy");
+    CHECK(copy.config().mContext.at("size") == "64");
+    CHECK(copy.get(0, Result::Measure::elapsed) == doctest::Approx(2e-6));
+    std::remove(path.c_str());
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_load_results_merge") {
+    auto const a = benched("x").results().front();
+    auto const b = benched("x").results().front();
+
+    auto merged = a;
+    merged.merge(b);
+    REQUIRE(merged.size() == a.size() + b.size());
+    CHECK(merged.get(a.size(), Result::Measure::elapsed) == b.get(0, Result::Measure::elapsed));
+    CHECK(merged.sum(Result::Measure::iterations) ==
+          doctest::Approx(a.sum(Result::Measure::iterations) + b.sum(Result::Measure::iterations)));
+    CHECK(merged.minimum(Result::Measure::elapsed) ==
+          (std::min)(a.minimum(Result::Measure::elapsed), b.minimum(Result::Measure::elapsed)));
+
+    // the runs of each benchmark are merged, in the order they first appear
+    auto const y = benched("y").results().front();
+    auto const suites = ankerl::nanobench::mergeResults({a, y, b, y});
+    REQUIRE(suites.size() == 2U);
+    CHECK(suites[0].config().mBenchmarkName == "x");
+    CHECK(suites[0].size() == a.size() + b.size());
+    CHECK(suites[1].config().mBenchmarkName == "y");
+    CHECK(suites[1].size() == 2U * y.size());
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_load_results_merge_a_measure_only_one_side_has") {
+    using M = Result::Measure;
+    auto const numMeasures = static_cast<size_t>(M::_size);
+    auto const bitOf = [](M m) {
+        return UINT32_C(1) << static_cast<uint32_t>(m);
+    };
+    ankerl::nanobench::Config config;
+    config.mBenchmarkName = "x";
+
+    // two epochs that counted instructions, from a machine with counters
+    std::vector<double> withCounters(numMeasures * 2U, 0.0);
+    withCounters[static_cast<size_t>(M::elapsed) * 2U] = 1.0;
+    withCounters[static_cast<size_t>(M::elapsed) * 2U + 1U] = 3.0;
+    withCounters[static_cast<size_t>(M::iterations) * 2U] = 10.0;
+    withCounters[static_cast<size_t>(M::iterations) * 2U + 1U] = 10.0;
+    withCounters[static_cast<size_t>(M::instructions) * 2U] = 100.0;
+    withCounters[static_cast<size_t>(M::instructions) * 2U + 1U] = 300.0;
+    auto merged = ankerl::nanobench::detail::resultOfEpochs(config, withCounters, 2U,
+                                                            bitOf(M::elapsed) | bitOf(M::iterations) | bitOf(M::instructions));
+
+    // and one that did not, from a machine without
+    std::vector<double> without(numMeasures, 0.0);
+    without[static_cast<size_t>(M::elapsed)] = 2.0;
+    without[static_cast<size_t>(M::iterations)] = 10.0;
+    merged.merge(ankerl::nanobench::detail::resultOfEpochs(config, without, 1U, bitOf(M::elapsed) | bitOf(M::iterations)));
+
+    // the instructions are kept, and the epoch without them is left out of their statistics only
+    REQUIRE(merged.size() == 3U);
+    CHECK(merged.has(M::instructions));
+    CHECK(std::isnan(merged.get(2U, M::instructions)));
+    CHECK(merged.median(M::instructions) == doctest::Approx(200.0));
+    CHECK(merged.average(M::instructions) == doctest::Approx(200.0));
+    CHECK(merged.sum(M::instructions) == doctest::Approx(400.0));
+    CHECK(merged.minimum(M::instructions) == doctest::Approx(100.0));
+    CHECK(merged.maximum(M::instructions) == doctest::Approx(300.0));
+    CHECK(merged.sumProduct(M::iterations, M::instructions) == doctest::Approx(4000.0));
+    CHECK(merged.median(M::elapsed) == doctest::Approx(2.0));
+
+    // Written out, the missing value is JSON's null rather than a nan no other reader understands, and
+    // it reads back as missing again.
+    std::ostringstream rendered;
+    ankerl::nanobench::render(ankerl::nanobench::templates::json(), std::vector<Result>{merged}, rendered);
+    CHECK(rendered.str().find("\"instructions\": null") != std::string::npos);
+    CHECK(rendered.str().find("nan") == std::string::npos);
+    std::ostringstream line;
+    ankerl::nanobench::detail::writeJsonLine(line, merged, true);
+    CHECK(line.str().find("\"instructions\":null") != std::string::npos);
+    CHECK(line.str().find("nan") == std::string::npos);
+
+    for (auto const& text : {rendered.str(), line.str()}) {
+        std::string const path = "unit_load_results_merge_a_measure_only_one_side_has.json";
+        writeFile(path, text);
+        auto const loaded = ankerl::nanobench::loadResults(path);
+        std::remove(path.c_str());
+        REQUIRE(loaded.size() == 1U);
+        REQUIRE(loaded.front().size() == 3U);
+        CHECK(loaded.front().has(M::instructions));
+        CHECK(std::isnan(loaded.front().get(2U, M::instructions)));
+        CHECK(loaded.front().median(M::instructions) == doctest::Approx(200.0));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_load_results_unicode_escapes") {
+    // nanobench writes only control characters as \u escapes, but Google Benchmark's JSON or a
+    // hand-edited file may escape anything, so they are read back as UTF-8
+    std::string const path = "unit_load_results_unicode_escapes.json";
+    writeFile(path, "{\"name\": \"caf\\u00e9 \\u20ac \\ud83d\\ude00 \\u0009 \\udc00\"}\n");
+    auto const loaded = ankerl::nanobench::loadResults(path);
+    std::remove(path.c_str());
+    REQUIRE(loaded.size() == 1U);
+    CHECK(loaded.front().config().mBenchmarkName == "caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80 \t \xef\xbf\xbd");
+}
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+// NOLINTNEXTLINE
+TEST_CASE("unit_load_results_errors") {
+    auto const x = benched("x").results().front();
+    auto const y = benched("y").results().front();
+    auto merged = x;
+    CHECK_THROWS_AS(merged.merge(y), std::runtime_error);
+    CHECK(merged.size() == x.size());
+
+    CHECK_THROWS_AS(ankerl::nanobench::loadResults("unit_load_results_that_does_not_exist.json"), std::runtime_error);
+    CHECK_THROWS_AS(ankerl::nanobench::loadResults("."), std::runtime_error);
+
+    std::string const path = "unit_load_results_errors.json";
+    writeFile(path, "{\"results\": [{\"name\": \"x\",");
+    CHECK_THROWS_AS(ankerl::nanobench::loadResults(path), std::runtime_error);
+    writeFile(path, "nanobnch, but not really");
+    CHECK_THROWS_AS(ankerl::nanobench::loadResults(path), std::runtime_error);
+    writeFile(path, "{\"name\": \"\\uZZZZ\"}");
+    CHECK_THROWS_AS(ankerl::nanobench::loadResults(path), std::runtime_error);
+    writeFile(path, "{\"name\": \"\\u12zz\"}");
+    CHECK_THROWS_WITH_AS(ankerl::nanobench::loadResults(path), "loadResults: expected a hex digit at offset 14", std::runtime_error);
+
+    // nothing at all is no results, not an error
+    writeFile(path, "\n");
+    CHECK(ankerl::nanobench::loadResults(path).empty());
+    std::remove(path.c_str());
+}
+#endif
@@ -0,0 +1,146 @@
+#include <nanobench.h>
+#include <thirdparty/doctest/doctest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// An interrupt or a page cache hiccup makes the occasional epoch 10x slower.
+// The median does not care, but average, maximum and sumProduct do - and the
+// classification that decides which epochs those are is easy to get subtly
+// wrong at the edges: a quartile of three values, a clock so coarse that most
+// epochs read the same tick.
+namespace {
+
+namespace nb = ankerl::nanobench::detail;
+using ankerl::nanobench::Config;
+using ankerl::nanobench::OutlierAction;
+using ankerl::nanobench::OutlierMethod;
+using ankerl::nanobench::Result;
+
+Result resultOf(std::vector<int64_t> const& nanos, OutlierMethod method) {
+    Config config;
+    config.mOutlierMethod = method;
+    Result r{config};
+    auto& pc = nb::performanceCounters();
+    for (auto ns : nanos) {
+        r.add(std::chrono::nanoseconds(ns), 1, pc);
+    }
+    return r;
+}
+
+void spinFor(std::chrono::microseconds duration) {
+    auto const until = ankerl::nanobench::Clock::now() + duration;
+    while (ankerl::nanobench::Clock::now() < until) {
+    }
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_outliers_flags") {
+    std::vector<double> const values = {10, 11, 10, 12, 11, 10, 100, 11, 12, 10, 11};
+    std::vector<bool> expected(values.size(), false);
+    expected[6] = true;
+
+    CHECK(nb::outlierFlags(values, OutlierMethod::tukey) == expected);
+    CHECK(nb::outlierFlags(values, OutlierMethod::mad) == expected);
+    CHECK(nb::outlierFlags(values, OutlierMethod::none) == std::vector<bool>(values.size(), false));
+
+    // a fast outlier is one too - a frequency boost is as much a disturbance as an interrupt
+    std::vector<double> const fast = {100, 101, 99, 100, 102, 1, 100, 98};
+    CHECK(nb::outlierFlags(fast, OutlierMethod::tukey)[5]);
+    CHECK(nb::outlierFlags(fast, OutlierMethod::mad)[5]);
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_outliers_flags_edge_cases") {
+    // too few values for a quartile to mean anything
+    CHECK(nb::outlierFlags({1, 1, 100}, OutlierMethod::tukey) == std::vector<bool>(3, false));
+    CHECK(nb::outlierFlags({}, OutlierMethod::mad).empty());
+
+    // Most epochs read the same tick: the spread is 0, and flagging everything
+    // one tick off would throw away the data rather than the disturbances.
+    std::vector<double> const coarse = {20, 20, 20, 20, 40, 20, 20};
+    CHECK(nb::outlierFlags(coarse, OutlierMethod::tukey) == std::vector<bool>(coarse.size(), false));
+    CHECK(nb::outlierFlags(coarse, OutlierMethod::mad) == std::vector<bool>(coarse.size(), false));
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_outliers_result_filtering") {
+    auto const r = resultOf({10, 11, 10, 12, 11, 1000, 10, 11}, OutlierMethod::mad);
+    CHECK(r.numOutliers() == 1U);
+    CHECK(r.outlierEpochs()[5]);
+
+    auto const filtered = r.withoutOutliers();
+    REQUIRE(filtered.size() == 7U);
+    CHECK(filtered.maximum(Result::Measure::elapsed) == doctest::Approx(12e-9));
+    CHECK(r.maximum(Result::Measure::elapsed) == doctest::Approx(1000e-9));
+
+    // the epoch goes as a whole, so the measures still line up
+    CHECK(filtered.sum(Result::Measure::iterations) == doctest::Approx(7.0));
+    CHECK(filtered.sumProduct(Result::Measure::iterations, Result::Measure::elapsed) == doctest::Approx(75e-9));
+
+    // without a method nothing is an outlier, and nothing is filtered
+    auto const plain = resultOf({10, 11, 10, 12, 11, 1000, 10, 11}, OutlierMethod::none);
+    CHECK(plain.numOutliers() == 0U);
+    CHECK(plain.withoutOutliers().size() == plain.size());
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_outliers_render") {
+    std::vector<Result> const results = {resultOf({10, 11, 10, 12, 11, 1000, 10, 11}, OutlierMethod::tukey)};
+
+    std::stringstream ss;
+    ankerl::nanobench::render("{{#result}}{{outliers}};{{maximum(elapsedns)}};{{#filtered}}{{maximum(elapsedns)}};"
+                              "{{sum(iterations)}}{{/filtered}}{{/result}}",
+                              results, ss);
+    CHECK(ss.str() == "1;1000;12;7");
+
+    std::stringstream flags;
+    ankerl::nanobench::render("{{#measurement}}{{outlier}}{{/measurement}}", results, flags);
+    CHECK(flags.str() == "00000100");
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_outliers_column") {
+    std::stringstream plain;
+    ankerl::nanobench::Bench().output(&plain).epochs(5).run("x", [] {});
+    CHECK(plain.str().find("outl") == std::string::npos);
+
+    std::stringstream withOutliers;
+    ankerl::nanobench::Bench().output(&withOutliers).epochs(5).outliers(OutlierMethod::tukey).run("x", [] {});
+    CHECK(withOutliers.str().find("| outl |") != std::string::npos);
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_outliers_remeasure") {
+    // one call in the middle is 40x slower than the others, one call per epoch
+    size_t call = 0;
+    ankerl::nanobench::Bench bench;
+    bench.output(nullptr)
+        .performanceCounters(false)
+        .epochIterations(1)
+        .epochs(11)
+        .outliers(OutlierMethod::tukey, OutlierAction::remeasure)
+        .run("spin", [&] {
+            spinFor(std::chrono::microseconds(++call == 5 ? 2000 : 50));
+        });
+
+    auto const& r = bench.results().front();
+    INFO("epochs " << r.size() << ", outliers " << r.numOutliers());
+    CHECK(r.numOutliers() >= 1U);
+    CHECK(r.size() > 11U);
+
+    // the epochs asked for are classified once, and every outlier among them gets one more epoch
+    std::vector<double> asked;
+    for (size_t e = 0; e < 11U; ++e) {
+        asked.push_back(r.get(e, Result::Measure::elapsed));
+    }
+    auto const flags = nb::outlierFlags(asked, OutlierMethod::tukey);
+    auto const numAskedOutliers = static_cast<size_t>(std::count(flags.begin(), flags.end(), true));
+    CHECK(r.size() == 11U + numAskedOutliers);
+}
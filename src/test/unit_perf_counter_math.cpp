@@ -2,6 +2,7 @@
 #include <thirdparty/doctest/doctest.h>
 
 #include <cstdint>
+#include <string>
 
 // The ins/op, cyc/op, IPC, bra/op and miss% columns are what distinguish
 // nanobench from a plain timer, and every number in them has been through the
@@ -158,6 +159,88 @@ TEST_CASE("unit_perf_correct_branch_misses") {
     CHECK(nb::correctBranchMisses(0, 0.0) == doctest::Approx(1.0));
 }
 
+// NOLINTNEXTLINE
+TEST_CASE("unit_perf_counter_note") {
+    nb::PerfCountSet<bool> has{};
+    nb::PerfCountSet<bool> const none{};
+
+    // nothing works: the whole story, same as it always was
+    auto const failed = nb::performanceCounterNote(has, none);
+    CHECK(failed.find("perf_event_open failed, so the ins/op") != std::string::npos);
+
+    // everything works: nothing to say
+    has.cpuCycles = true;
+    has.instructions = true;
+    has.branchInstructions = true;
+    has.branchMisses = true;
+    has.pageFaults = true;
+    has.contextSwitches = true;
+    CHECK(nb::performanceCounterNote(has, none).empty());
+
+    // a partial PMU - each counter is named on the side it is on, and the
+    // software ones that still work are not lost along with the branch misses
+    has.branchMisses = false;
+    has.cpuCycles = false;
+    auto const partial = nb::performanceCounterNote(has, none);
+    INFO(partial);
+    CHECK(partial.find("failed for cpucycles, branchmisses,") != std::string::npos);
+    CHECK(partial.find("only instructions, branchinstructions, pagefaults, contextswitches are measured") !=
+          std::string::npos);
+
+    // the hardware counters all being gone is the old message, whatever the software ones do
+    has.instructions = false;
+    has.branchInstructions = false;
+    CHECK(nb::performanceCounterNote(has, none) == failed);
+
+    // counters that opened but never ran are not put down to perf_event_open
+    auto opened = has;
+    opened.instructions = true;
+    auto const unscheduled = nb::performanceCounterNote(has, opened);
+    INFO(unscheduled);
+    CHECK(unscheduled.find("the kernel never ran the hardware performance counters") != std::string::npos);
+    CHECK(unscheduled.find("perf_event_open failed") == std::string::npos);
+
+    has.instructions = true;
+    opened.branchMisses = true;
+    auto const mixed = nb::performanceCounterNote(has, opened);
+    INFO(mixed);
+    CHECK(mixed.find("perf_event_open failed for cpucycles, branchinstructions, and the kernel never ran branchmisses, "
+                     "so only instructions,") != std::string::npos);
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_perf_counters_of_a_failed_group_are_dropped") {
+    // every counter worked at calibration, and then the group of the hardware
+    // branch counters failed in the middle of a run - say a hypervisor took
+    // the PMU back. Its counters read zeros from then on, so they have to go
+    // from has(), and only they.
+    nb::PerfCountSet<bool> has{};
+    has.cpuCycles = true;
+    has.instructions = true;
+    has.branchInstructions = true;
+    has.branchMisses = true;
+    has.pageFaults = true;
+    has.contextSwitches = true;
+    nb::PerfCountSet<uint64_t> const val{};
+    auto const live = nb::liveCounters(has, val, [&val](uint64_t const* targetValue) {
+        return targetValue != &val.branchInstructions && targetValue != &val.branchMisses;
+    });
+    CHECK(live.cpuCycles);
+    CHECK(live.instructions);
+    CHECK_FALSE(live.branchInstructions);
+    CHECK_FALSE(live.branchMisses);
+    CHECK(live.pageFaults);
+    CHECK(live.contextSwitches);
+
+    // a counter that was not there is not brought back by a group that is fine
+    auto const again = nb::liveCounters(live, val, [](uint64_t const*) {
+        return true;
+    });
+    CHECK_FALSE(again.branchInstructions);
+    CHECK_FALSE(again.branchMisses);
+    CHECK(again.instructions);
+}
+
 // NOLINTNEXTLINE
 TEST_CASE("unit_perf_counters_are_consistent_when_available") {
     // Where the kernel does hand out counters, the corrected values have to be
@@ -0,0 +1,94 @@
+#include <nanobench.h>
+#include <thirdparty/doctest/doctest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// A progress line is read by someone deciding whether to wait or to go for
+// lunch, so it has to say where the run is and not be off by a factor of ten
+// about how long it has left. What it must never do is end up in the
+// measurement or in output(), which is what a redirected stderr checks here.
+namespace {
+
+namespace nb = ankerl::nanobench::detail;
+
+// std::cerr goes to a string for as long as this lives
+class CaptureStderr {
+public:
+    CaptureStderr()
+        : mOld(std::cerr.rdbuf(mCaptured.rdbuf())) {}
+    ~CaptureStderr() {
+        std::cerr.rdbuf(mOld);
+    }
+    CaptureStderr(CaptureStderr const&) = delete;
+    CaptureStderr& operator=(CaptureStderr const&) = delete;
+
+    std::string str() const {
+        return mCaptured.str();
+    }
+
+private:
+    std::ostringstream mCaptured{};
+    std::streambuf* mOld;
+};
+
+// something the optimizer cannot remove, or the run is an "iterations overflow" with no epochs
+void increment(uint64_t& x) {
+    ankerl::nanobench::doNotOptimizeAway(x += 1);
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_progress_duration") {
+    CHECK(nb::progressDuration(std::chrono::milliseconds(4200)) == "4.2s");
+    CHECK(nb::progressDuration(std::chrono::nanoseconds(0)) == "0.0s");
+    CHECK(nb::progressDuration(std::chrono::seconds(42)) == "42s");
+    CHECK(nb::progressDuration(std::chrono::seconds(192)) == "3m 12s");
+    CHECK(nb::progressDuration(std::chrono::seconds(3720)) == "1h 02m");
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_progress_lines") {
+    uint64_t x = 0;
+    std::ostringstream out;
+    ankerl::nanobench::Bench bench;
+    std::string progress;
+    {
+        CaptureStderr const capture;
+        bench.output(&out).progress(std::chrono::nanoseconds(1)).progressTotal(3).epochs(5).epochIterations(100);
+        bench.title("suite").run("first", [&] {
+            increment(x);
+        });
+        bench.run("second", [&] {
+            increment(x);
+        });
+        progress = capture.str();
+    }
+    INFO(progress);
+    CHECK(progress.find("nanobench: [1/3] suite / first: ") != std::string::npos);
+    CHECK(progress.find("nanobench: [2/3] suite / second: ") != std::string::npos);
+    CHECK(progress.find("epoch 3/5, ~") != std::string::npos);
+    CHECK(progress.find(" left in the suite") != std::string::npos);
+
+    // the table is where it always was, and nothing of the progress is in it
+    CHECK(out.str().find("`first`") != std::string::npos);
+    CHECK(out.str().find("nanobench:") == std::string::npos);
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_progress_off_by_default") {
+    uint64_t x = 0;
+    std::string progress;
+    {
+        CaptureStderr const capture;
+        ankerl::nanobench::Bench().output(nullptr).epochs(5).epochIterations(100).run("x", [&] {
+            increment(x);
+        });
+        progress = capture.str();
+    }
+    CHECK(progress.find("nanobench: ") == std::string::npos);
+}
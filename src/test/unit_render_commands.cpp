@@ -251,6 +251,89 @@ TEST_CASE("unit_render_measurement_section") {
     CHECK(render("{{#measurement}}{{nonsense}}{{/measurement}}", one) == "000");
 }
 
+// NOLINTNEXTLINE
+TEST_CASE("unit_render_context_section") {
+    std::vector<Result> const one{resultOf("ctx", {10, 20})};
+
+    // every variable, sorted by name, with the layer markers like any list
+    auto config = configFor("ctx");
+    config.mContext["alloc"] = "std";
+    std::vector<Result> const two{Result{config}};
+    CHECK(render("{{#result}}{{#context}}{{variable}}={{value}}{{^-last}},{{/-last}}{{/context}}{{/result}}", two) ==
+          "alloc=std,threads=8");
+    // and the result's own tags are still there inside it
+    CHECK(render("{{#result}}{{#context}}{{name}}:{{variable}};{{/context}}{{/result}}", two) == "ctx:alloc;ctx:threads;");
+
+    // a record per epoch can repeat the result's config and context
+    CHECK(render("{{#measurement}}{{name}}/{{#context}}{{variable}}:{{value}}{{/context}}/{{elapsedns}};{{/measurement}}",
+                 one) == "ctx/threads:8/10;ctx/threads:8/20;");
+    CHECK(render("{{#measurement}}{{complexityN}},{{context(threads)}};{{/measurement}}", one) == "128,8;128,8;");
+
+    // no context, nothing written
+    std::vector<Result> const bare{Result{ankerl::nanobench::Config{}}};
+    CHECK(render("{{#result}}[{{#context}}{{variable}}{{/context}}]{{/result}}", bare) == "[]");
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_render_compare_result") {
+    using ankerl::nanobench::CompareResult;
+    std::vector<CompareResult::Entry> entries;
+    entries.emplace_back("base", resultOf("x", {20, 20, 20}), 1.0, 1.0, 1.0, 0U);
+    entries.emplace_back("fast", resultOf("y", {10, 10, 10}), 2.0, 1.5, 2.5, 3U);
+    entries.emplace_back("same", resultOf("z", {20, 21, 19}), 1.0, 0.9, 1.1, 0U);
+    // only instructions has a ratio of its own, the others are 0 for "not recorded"
+    entries[1].measureRatios.assign(static_cast<size_t>(Result::Measure::_size), CompareResult::Ratio{0.0, 0.0, 0.0});
+    entries[1].measureRatios[static_cast<size_t>(Result::Measure::instructions)] = CompareResult::Ratio{1.25, 1.2, 1.3};
+    CompareResult const compared(std::move(entries), 11, 0.975, 1);
+
+    std::ostringstream oss;
+    ankerl::nanobench::render("{{rounds}};{{comparisons}};{{fastest}};{{looks}};{{title}}|"
+                              "{{#entry}}{{name}}:{{relative}}[{{relativeLow}},{{relativeHigh}}] "
+                              "{{isSignificant}}{{isDropped}} {{tiedRounds}} {{equivalence}} "
+                              "{{relative(instructions)}}[{{relativeLow(instructions)}},{{relativeHigh(instructions)}}] "
+                              "{{median(elapsedns)}}{{^-last}}|{{/-last}}{{/entry}}",
+                              compared, oss);
+    CHECK(oss.str() == "11;2;1;1;the title|"
+                       "base:1[1,1] 00 0 equivalent 0[0,0] 20|"
+                       "fast:2[1.5,2.5] 10 3 inconclusive 1.25[1.2,1.3] 10|"
+                       "same:1[0.9,1.1] 00 0 inconclusive 0[0,0] 20");
+
+    // {{relative}} is the ratio in here, but {{title}} and the rest are still the result's
+    std::ostringstream inner;
+    ankerl::nanobench::render("{{confidence}}{{#entry}};{{title}}/{{#context}}{{value}}{{/context}}"
+                              "{{#filtered}}/{{relative}}{{/filtered}}{{/entry}}",
+                              compared, inner);
+    CHECK(inner.str() == "0.975;the title/8/1;the title/8/2;the title/8/1");
+
+    // the same through a Template, and a std::string
+    ankerl::nanobench::Template const tpl("{{#entry}}{{name}}{{/entry}}");
+    std::ostringstream compiled;
+    ankerl::nanobench::render(tpl, compared, compiled);
+    ankerl::nanobench::render(std::string("{{#entry}}{{isSignificant}}{{/entry}}"), compared, compiled);
+    CHECK(compiled.str() == "basefastsame010");
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_render_big_o") {
+    using ankerl::nanobench::BigO;
+    std::vector<BigO> const bigOs{BigO("O(n)", BigO::RangeMeasure{{1, 2}, {2, 4}, {4, 8}}),
+                                  BigO("O(1)", BigO::RangeMeasure{{1, 2}, {2, 4}, {4, 8}})};
+
+    std::ostringstream oss;
+    ankerl::nanobench::render("[{{#bigO}}{{name}}{{^-last}},{{/-last}}{{/bigO}}]", bigOs, oss);
+    CHECK(oss.str() == "[O(n),O(1)]");
+
+    // a perfect fit: the constant is the slope, and there is no error
+    std::ostringstream numbers;
+    ankerl::nanobench::render(std::string("{{#bigO}}{{constant}} {{normalizedRootMeanSquare}};{{/bigO}}"),
+                              bigOs, numbers);
+    CHECK(numbers.str().find("2 0;") == 0);
+
+    std::ostringstream none;
+    ankerl::nanobench::render("[{{#bigO}}{{name}}{{/bigO}}]", std::vector<BigO>{}, none);
+    CHECK(none.str() == "[]");
+}
+
 // NOLINTNEXTLINE
 TEST_CASE("unit_render_tag_outside_a_result_section") {
     // With exactly one result, a bare tag can name a measure as well as a
@@ -313,3 +396,42 @@ TEST_CASE("unit_render_does_not_disturb_the_stream") {
     oss << " " << 1.25;
     CHECK(oss.str() == "1.250 only 1.250");
 }
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_render_template_object") {
+    // A Template is the same renderer with the parsing done once, so it has to
+    // produce exactly what the string does - for every built-in template, and
+    // every time it is used, not just the first.
+    std::vector<Result> const one{resultOf("only", {10, 20, 30})};
+    std::vector<Result> const two{resultOf("first", {10, 20}),
+                                  resultOf("second", {30, 40})};
+
+    for (auto const* tpl : {ankerl::nanobench::templates::csv(),
+                            ankerl::nanobench::templates::json(),
+                            ankerl::nanobench::templates::htmlBoxplot()}) {
+        ankerl::nanobench::Template const compiled(tpl);
+        for (int i = 0; i < 2; ++i) {
+            std::ostringstream oss;
+            ankerl::nanobench::render(compiled, two, oss);
+            CHECK(oss.str() == render(tpl, two));
+        }
+    }
+
+    // pyperf reaches into the measurements of "the" result
+    ankerl::nanobench::Template const pyperf(
+        ankerl::nanobench::templates::pyperf());
+    std::ostringstream oss;
+    ankerl::nanobench::render(pyperf, one, oss);
+    CHECK(oss.str() == render(ankerl::nanobench::templates::pyperf(), one));
+
+    // it keeps its own copy of what it needs from the text
+    auto const owned = [] {
+        std::string const tpl = "{{#result}}{{name}}: {{median(elapsedns)}} "
+                                "{{context(threads)}}{{^-last}}, {{/-last}}"
+                                "{{/result}}";
+        return ankerl::nanobench::Template(tpl);
+    }();
+    std::ostringstream fromOwned;
+    ankerl::nanobench::render(owned, two, fromOwned);
+    CHECK(fromOwned.str() == "first: 15 8, second: 35 8");
+}
@@ -81,7 +81,7 @@ TEST_CASE("unit_render_error_unknown_command") {
 TEST_CASE("unit_render_error_sections_in_the_wrong_place") {
     auto const one = oneResult();
 
-    // {{#result}} may contain {{#measurement}} and nothing else
+    // {{#result}} may contain {{#measurement}}, {{#filtered}} and {{#context}}, nothing else
     CHECK_THROWS_WITH_AS(
         renderIgnoringOutput("{{#result}}{{#other}}x{{/other}}{{/result}}",
                              one),
@@ -91,8 +91,9 @@ TEST_CASE("unit_render_error_sections_in_the_wrong_place") {
                              one),
         "got a inverted section inside result", std::runtime_error);
 
-    // {{#measurement}} is the innermost level, so it may contain no section at
-    // all - except the -first/-last markers, which are handled before this
+    // {{#measurement}} is the innermost level, so it may contain no section but
+    // the result's {{#context}} - and the -first/-last markers, which are handled
+    // before this
     CHECK_THROWS_WITH_AS(
         renderIgnoringOutput(
             "{{#measurement}}{{#other}}x{{/other}}{{/measurement}}", one),
@@ -105,6 +106,24 @@ TEST_CASE("unit_render_error_sections_in_the_wrong_place") {
     // ... and the markers really are still accepted there
     CHECK_NOTHROW(renderIgnoringOutput(
         "{{#measurement}}{{^-last}},{{/-last}}{{/measurement}}", one));
+
+    // {{#context}} is a list of strings, there is nothing to nest in it - which
+    // is only noticed once there is a variable to render it for
+    CHECK_NOTHROW(renderIgnoringOutput(
+        "{{#result}}{{#context}}{{#other}}x{{/other}}{{/context}}{{/result}}", one));
+    ankerl::nanobench::Config config;
+    config.mContext["type"] = "int";
+    std::vector<Result> const withContext{Result{config}};
+    CHECK_THROWS_WITH_AS(
+        renderIgnoringOutput(
+            "{{#result}}{{#context}}{{#other}}x{{/other}}{{/context}}{{/result}}", withContext),
+        "got a section inside context", std::runtime_error);
+    CHECK_THROWS_WITH_AS(
+        renderIgnoringOutput(
+            "{{#result}}{{#context}}{{^other}}x{{/other}}{{/context}}{{/result}}", withContext),
+        "got a inverted section inside context", std::runtime_error);
+    CHECK_THROWS_WITH_AS(renderIgnoringOutput("{{#context}}x{{/context}}", one),
+                         "render: unknown section 'context'", std::runtime_error);
 }
 
 // NOLINTNEXTLINE
@@ -153,6 +172,38 @@ TEST_CASE("unit_render_error_unknown_top_level_tag") {
     CHECK_NOTHROW(renderIgnoringOutput("{{name}}", twoResults()));
 }
 
+// NOLINTNEXTLINE
+TEST_CASE("unit_render_error_compare_and_big_o") {
+    // {{#entry}} and {{#bigO}} only have something to list when rendering the
+    // one thing that has it, and say so rather than rendering nothing
+    CHECK_THROWS_WITH_AS(renderIgnoringOutput("{{#entry}}{{name}}{{/entry}}", oneResult()),
+                         "render: section 'entry' needs a CompareResult", std::runtime_error);
+    CHECK_THROWS_WITH_AS(renderIgnoringOutput("{{#bigO}}{{name}}{{/bigO}}", oneResult()),
+                         "render: section 'bigO' needs a list of BigO", std::runtime_error);
+    CHECK_THROWS_WITH_AS(renderIgnoringOutput("{{rounds}}", twoResults()), "unknown tag 'rounds'", std::runtime_error);
+
+    using ankerl::nanobench::BigO;
+    std::vector<BigO> const bigOs{BigO("O(n)", BigO::RangeMeasure{{1, 2}, {2, 4}})};
+    std::ostringstream oss;
+    CHECK_THROWS_WITH_AS(ankerl::nanobench::render("{{#bigO}}{{title}}{{/bigO}}", bigOs, oss), "unknown tag 'title'",
+                         std::runtime_error);
+    CHECK_THROWS_WITH_AS(ankerl::nanobench::render("{{#bigO}}{{#x}}{{/x}}{{/bigO}}", bigOs, oss),
+                         "got a section inside bigO", std::runtime_error);
+    CHECK_THROWS_WITH_AS(ankerl::nanobench::render("{{#result}}x{{/result}}{{#entry}}{{/entry}}", bigOs, oss),
+                         "render: section 'entry' needs a CompareResult", std::runtime_error);
+
+    using ankerl::nanobench::CompareResult;
+    std::vector<CompareResult::Entry> entries;
+    entries.emplace_back("base", resultOf("x"), 1.0, 1.0, 1.0, 0U);
+    CompareResult const compared(std::move(entries), 1);
+    CHECK_THROWS_WITH_AS(ankerl::nanobench::render("{{#entry}}{{#x}}{{/x}}{{/entry}}", compared, oss),
+                         "got a section inside entry", std::runtime_error);
+    CHECK_THROWS_WITH_AS(ankerl::nanobench::render("{{#entry}}{{^x}}{{/x}}{{/entry}}", compared, oss),
+                         "got a inverted section inside entry", std::runtime_error);
+    CHECK_THROWS_WITH_AS(ankerl::nanobench::render("{{#bigO}}{{/bigO}}", compared, oss),
+                         "render: section 'bigO' needs a list of BigO", std::runtime_error);
+}
+
 // NOLINTNEXTLINE
 TEST_CASE("unit_render_error_leaves_the_stream_usable") {
     // The renderer restores the stream's formatting from a destructor, so an
@@ -172,4 +223,19 @@ TEST_CASE("unit_render_error_leaves_the_stream_usable") {
     CHECK(oss.str() == "1.250");
 }
 
+// NOLINTNEXTLINE
+TEST_CASE("unit_render_error_template_object") {
+    // A Template parses up front, but a mistake is still reported when
+    // rendering reaches it and not before: a {{#result}} with no results to
+    // render never looked at what was inside it.
+    ankerl::nanobench::Template const tpl("{{#result}}{{whatever}}{{/result}}");
+
+    std::ostringstream oss;
+    std::vector<Result> const none;
+    CHECK_NOTHROW(ankerl::nanobench::render(tpl, none, oss));
+    CHECK_THROWS_WITH_AS(ankerl::nanobench::render(tpl, oneResult(), oss),
+                         "command 'whatever' not understood",
+                         std::runtime_error);
+}
+
 #endif
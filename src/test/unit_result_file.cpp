@@ -0,0 +1,107 @@
+#include <nanobench.h>
+#include <thirdparty/doctest/doctest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// The binary format is read back without being parsed, straight out of the
+// mapped file - so the one thing that can go wrong is reading what is not
+// there. A result has to come back exactly, and anything that is not a whole
+// result file has to come back as no results at all.
+namespace {
+
+using ankerl::nanobench::Result;
+using ankerl::nanobench::ResultFile;
+
+std::string rendered(std::vector<Result> const& results) {
+    std::ostringstream oss;
+    ankerl::nanobench::render(ankerl::nanobench::templates::json(), results, oss);
+    return oss.str();
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_result_file_round_trip") {
+    std::string const path = "unit_result_file_round_trip.bin";
+
+    uint64_t x = 0;
+    ankerl::nanobench::Bench bench;
+    bench.output(nullptr).title("a \"title\"").unit("byte").epochs(5).epochIterations(10).batch(2).complexityN(100);
+    bench.context("type", "int").run("first", [&] {
+        ankerl::nanobench::doNotOptimizeAway(x += 1);
+    });
+    bench.clearContext().run("second", [&] {
+        ankerl::nanobench::doNotOptimizeAway(x += 2);
+    });
+    REQUIRE(ankerl::nanobench::saveResults(path, bench));
+
+    ResultFile const file(path);
+    REQUIRE(file.valid());
+    REQUIRE(file.size() == 2U);
+    CHECK(std::string(file[0].title()) == "a \"title\"");
+    CHECK(std::string(file[1].name()) == "second");
+    CHECK(std::string(file[1].unit()) == "byte");
+    CHECK(file[1].config().mComplexityN == doctest::Approx(100));
+    CHECK(file[0].config().mContext.at("type") == "int");
+    CHECK(file[1].config().mContext.empty());
+
+    // the epochs are in the file as they were in the result
+    auto const& original = bench.results().front();
+    REQUIRE(file[0].size() == original.size());
+    REQUIRE(file[0].has(Result::Measure::elapsed));
+    auto const* elapsed = file[0].measure(Result::Measure::elapsed);
+    for (size_t i = 0; i < original.size(); ++i) {
+        CHECK(elapsed[i] == original.get(i, Result::Measure::elapsed));
+    }
+
+    // and the results render exactly as they did
+    CHECK(rendered(file.results()) == rendered(bench.results()));
+    std::remove(path.c_str());
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_result_file_invalid") {
+    std::string const path = "unit_result_file_invalid.bin";
+
+    CHECK_FALSE(ResultFile("unit_result_file_that_does_not_exist.bin").valid());
+
+    // a directory opens like a file, but is not one
+    ResultFile const directory(".");
+    CHECK_FALSE(directory.valid());
+    CHECK(directory.size() == 0U);
+
+    {
+        std::ofstream out(path);
+        out << "this is not a result file, but it is long enough to have a header";
+    }
+    ResultFile const text(path);
+    CHECK_FALSE(text.valid());
+    CHECK(text.size() == 0U);
+
+    // every truncation of a real file is rejected rather than read past its end
+    ankerl::nanobench::Bench bench;
+    bench.output(nullptr).epochs(3).epochIterations(1).context("k", "v").run("x", [] {});
+    REQUIRE(ankerl::nanobench::saveResults(path, bench));
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        bytes.resize(static_cast<size_t>(in.tellg()));
+        in.seekg(0);
+        in.read(&bytes[0], static_cast<std::streamsize>(bytes.size()));
+    }
+    REQUIRE(ResultFile(path).valid());
+    for (size_t size = 0; size < bytes.size(); size += 8) {
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(bytes.data(), static_cast<std::streamsize>(size));
+        }
+        INFO("truncated to " << size << " of " << bytes.size() << " bytes");
+        CHECK_FALSE(ResultFile(path).valid());
+    }
+    std::remove(path.c_str());
+}
@@ -225,3 +225,78 @@ TEST_CASE("unit_result_context_of_unknown_variable") {
 }
 
 #endif
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_result_config_is_shared") {
+    // A parameter sweep makes thousands of results, and a copy of the config
+    // in each - title, unit, context map - was most of what they weighed.
+    ankerl::nanobench::Bench bench;
+    bench.output(nullptr).epochs(3).epochIterations(1);
+    bench.run("a", [] {}).run("a", [] {});
+    auto const& results = bench.results();
+    REQUIRE(results.size() == 2U);
+    CHECK(&results[0].config() == &results[1].config());
+
+    // a setter after a run does not reach into the results made before it
+    bench.context("size", "10").run("b", [] {});
+    CHECK(&results[1].config() != &results[2].config());
+    CHECK(results[0].config().mBenchmarkName == "a");
+    CHECK(results[0].config().mContext.empty());
+    CHECK(results[2].context("size") == "10");
+
+    // and neither does one on a copy of the bench
+    auto copy = bench;
+    copy.name("c");
+    CHECK(bench.name() == "b");
+    CHECK(results[2].config().mBenchmarkName == "b");
+
+    // the results have a snapshot rather than the bench's own config, so a setter never has to copy it
+    static_assert(noexcept(bench.epochs(3)), "a setter of a number does not allocate");
+    static_assert(noexcept(bench.output(nullptr)), "a setter of a number does not allocate");
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_result_grows_past_its_epochs") {
+    // storage is sized for the config's epochs, but remeasuring adds more
+    ankerl::nanobench::Config config;
+    config.mNumEpochs = 2;
+    Result r{config};
+    auto& pc = ankerl::nanobench::detail::performanceCounters();
+    for (int64_t ns = 1; ns <= 9; ++ns) {
+        r.add(std::chrono::nanoseconds(ns), 2, pc);
+    }
+    REQUIRE(r.size() == 9U);
+    for (size_t i = 0; i < r.size(); ++i) {
+        CHECK(r.get(i, Result::Measure::elapsed) == doctest::Approx(static_cast<double>(i + 1) * 0.5e-9));
+        CHECK(r.get(i, Result::Measure::iterations) == doctest::Approx(2.0));
+    }
+    CHECK(r.sum(Result::Measure::iterations) == doctest::Approx(18.0));
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_result_statistics_follow_new_epochs") {
+    // the order statistics select in a copy of the epochs, so they see every
+    // epoch added since, and leave the epochs themselves in measured order
+    Result r{ankerl::nanobench::Config{}};
+    auto& pc = ankerl::nanobench::detail::performanceCounters();
+    for (int64_t ns : {30, 10, 20}) {
+        r.add(std::chrono::nanoseconds(ns), 1, pc);
+    }
+    CHECK(r.median(Result::Measure::elapsed) == doctest::Approx(20e-9));
+    CHECK(r.medianAbsolutePercentError(Result::Measure::elapsed) == doctest::Approx(1.0 / 3.0));
+    CHECK(r.minimum(Result::Measure::elapsed) == doctest::Approx(10e-9));
+    CHECK(r.maximum(Result::Measure::elapsed) == doctest::Approx(30e-9));
+
+    r.add(std::chrono::nanoseconds(100), 1, pc);
+    CHECK(r.median(Result::Measure::elapsed) == doctest::Approx(25e-9));
+    CHECK(r.medianAbsolutePercentError(Result::Measure::elapsed) == doctest::Approx((0.25 + 0.75) / 2.0));
+    CHECK(r.maximum(Result::Measure::elapsed) == doctest::Approx(100e-9));
+
+    r.add(std::chrono::nanoseconds(5), 1, pc);
+    CHECK(r.minimum(Result::Measure::elapsed) == doctest::Approx(5e-9));
+    CHECK(r.median(Result::Measure::elapsed) == doctest::Approx(20e-9));
+
+    // and the epochs themselves are still in the order they were measured
+    CHECK(r.get(0, Result::Measure::elapsed) == doctest::Approx(30e-9));
+    CHECK(r.get(4, Result::Measure::elapsed) == doctest::Approx(5e-9));
+}
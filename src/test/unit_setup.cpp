@@ -1,6 +1,7 @@
 #include <nanobench.h>
 #include <thirdparty/doctest/doctest.h>
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 #include <vector>
@@ -85,3 +86,83 @@ TEST_CASE("unit_setup_named_run") {
     bench.setup([&] {}).run(asString, [] {});
     REQUIRE(bench.results().back().config().mBenchmarkName == asString);
 }
+
+// A comparison of two alternatives that sort in place is only meaningful when
+// both get unsorted data before every epoch: otherwise every epoch after the
+// first sorts what is already sorted.
+// NOLINTNEXTLINE
+TEST_CASE("unit_setup_compare_per_alternative") {
+    std::vector<char> a;
+    std::vector<char> b;
+
+    ankerl::nanobench::Bench bench;
+    bench.output(nullptr)
+        .warmup(0)
+        .epochs(6)
+        .epochIterations(1)
+        .performanceCounters(false);
+    auto const result = bench.compare(
+        "a",
+        ankerl::nanobench::withSetup(
+            [&] {
+                a.push_back('S');
+            },
+            [&] {
+                a.push_back('R');
+            }),
+        "b",
+        [&] {
+            b.push_back('R');
+        });
+
+    REQUIRE(result.size() == 2U);
+    // one setup in front of every run of a, calibration and all, and none for b
+    REQUIRE(a.size() % 2U == 0U);
+    for (size_t i = 0; i < a.size(); i += 2U) {
+        INFO(i);
+        CHECK(a[i] == 'S');
+        CHECK(a[i + 1U] == 'R');
+    }
+    CHECK(std::count(b.begin(), b.end(), 'S') == 0);
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_setup_compare_shared_and_untimed") {
+    size_t sharedCalls = 0;
+    size_t ownCalls = 0;
+    size_t runs = 0;
+
+    ankerl::nanobench::Bench bench;
+    bench.output(nullptr)
+        .warmup(0)
+        .epochs(6)
+        .epochIterations(1)
+        .performanceCounters(false);
+    auto const result = bench
+                            .setup([&] {
+                                ++sharedCalls;
+                                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                            })
+                            .compare(
+                                "shared",
+                                [&] {
+                                    ++runs;
+                                },
+                                "own",
+                                ankerl::nanobench::withSetup(
+                                    [&] {
+                                        ++ownCalls;
+                                    },
+                                    [&] {
+                                        ++runs;
+                                    }));
+
+    // the alternative with a setup of its own keeps it
+    REQUIRE(result.size() == 2U);
+    CHECK(sharedCalls == result[0].result.size());
+    CHECK(ownCalls == result[1].result.size());
+    CHECK(runs == sharedCalls + ownCalls);
+
+    // 2ms of sleeping in front of every epoch, and none of it measured
+    CHECK(result[0].result.median(ankerl::nanobench::Result::Measure::elapsed) < 0.001);
+}
@@ -0,0 +1,166 @@
+#include <nanobench.h>
+#include <thirdparty/doctest/doctest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// A soak run adds epochs for hours, so a streaming Result keeps running
+// statistics instead of the epochs. Exact where that is possible - sum, mean,
+// extremes, sumProduct - and a P² estimate for the median. The estimate is only
+// useful if it stays close to the exact median on the kind of data timings are:
+// skewed, with a long tail of slow epochs.
+namespace {
+
+namespace nb = ankerl::nanobench::detail;
+using ankerl::nanobench::Config;
+using ankerl::nanobench::Result;
+
+// most epochs near 100, every 20th one slow
+std::vector<double> timings(size_t n) {
+    ankerl::nanobench::Rng rng(1234);
+    std::vector<double> values;
+    for (size_t i = 0; i < n; ++i) {
+        auto v = 100.0 + 10.0 * rng.uniform01() * rng.uniform01();
+        if (0 == rng.bounded(20)) {
+            v *= 3.0;
+        }
+        values.push_back(v);
+    }
+    return values;
+}
+
+double exactMedian(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    auto const mid = values.size() / 2;
+    return (values.size() & 1U) == 1U ? values[mid] : (values[mid - 1] + values[mid]) / 2.0;
+}
+
+Result resultOf(std::vector<int64_t> const& nanos, bool streaming) {
+    Config config;
+    config.mStreaming = streaming;
+    Result r{config};
+    auto& pc = nb::performanceCounters();
+    uint64_t iters = 1;
+    for (auto ns : nanos) {
+        r.add(std::chrono::nanoseconds(ns), iters++, pc);
+    }
+    return r;
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_streaming_p2_quantile") {
+    auto const values = timings(20000);
+    nb::P2Quantile median(0.5);
+    nb::P2Quantile p90(0.9);
+    for (auto v : values) {
+        median.add(v);
+        p90.add(v);
+    }
+    CHECK(median.count() == values.size());
+    CHECK(median.value() == doctest::Approx(exactMedian(values)).epsilon(0.005));
+
+    auto sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+    CHECK(p90.value() == doctest::Approx(sorted[sorted.size() * 9 / 10]).epsilon(0.01));
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_streaming_p2_quantile_few_values") {
+    // exact until there are enough values for the markers
+    nb::P2Quantile q(0.5);
+    CHECK(q.value() == doctest::Approx(0.0));
+    q.add(7);
+    CHECK(q.value() == doctest::Approx(7.0));
+    q.add(1);
+    CHECK(q.value() == doctest::Approx(4.0));
+    q.add(3);
+    CHECK(q.value() == doctest::Approx(3.0));
+    q.add(100);
+    q.add(5);
+    CHECK(q.value() == doctest::Approx(5.0));
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_streaming_running_stats") {
+    // large and close together, where a naive sum of squares cancels to nothing
+    std::vector<double> const values = {1e9 + 4, 1e9 + 7, 1e9 + 13, 1e9 + 16};
+    nb::RunningStats stats;
+    CHECK(stats.variance() == doctest::Approx(0.0));
+    for (auto v : values) {
+        stats.add(v);
+    }
+    CHECK(stats.count() == 4U);
+    CHECK(stats.mean() == doctest::Approx(1e9 + 10));
+    CHECK(stats.variance() == doctest::Approx(30.0));
+    CHECK(stats.minimum() == doctest::Approx(1e9 + 4));
+    CHECK(stats.maximum() == doctest::Approx(1e9 + 16));
+    CHECK(stats.sum() == doctest::Approx(4e9 + 40));
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_streaming_result") {
+    std::vector<int64_t> const nanos = {50, 40, 90, 30, 60, 80, 70, 55, 45};
+    auto const stored = resultOf(nanos, false);
+    auto const streamed = resultOf(nanos, true);
+
+    CHECK_FALSE(stored.streaming());
+    REQUIRE(streamed.streaming());
+    CHECK(streamed.size() == stored.size());
+
+    for (auto m : {Result::Measure::elapsed, Result::Measure::iterations}) {
+        CHECK(streamed.has(m));
+        CHECK(streamed.sum(m) == doctest::Approx(stored.sum(m)));
+        CHECK(streamed.average(m) == doctest::Approx(stored.average(m)));
+        CHECK(streamed.minimum(m) == doctest::Approx(stored.minimum(m)));
+        CHECK(streamed.maximum(m) == doctest::Approx(stored.maximum(m)));
+    }
+    CHECK(streamed.sumProduct(Result::Measure::iterations, Result::Measure::elapsed) ==
+          doctest::Approx(stored.sumProduct(Result::Measure::iterations, Result::Measure::elapsed)));
+
+    // an estimate, but close on nine values already
+    CHECK(streamed.median(Result::Measure::elapsed) ==
+          doctest::Approx(stored.median(Result::Measure::elapsed)).epsilon(0.2));
+
+    // there is no epoch to return, and nothing for a template to list
+    CHECK_THROWS_AS(static_cast<void>(streamed.get(0, Result::Measure::elapsed)), std::out_of_range);
+    std::stringstream ss;
+    ankerl::nanobench::render("{{#measurement}}x{{/measurement}}{{#result}}{{sum(iterations)}}{{/result}}",
+                              std::vector<Result>{streamed}, ss);
+    CHECK(ss.str() == "45");
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_streaming_live_report") {
+    std::stringstream out;
+    ankerl::nanobench::Bench bench;
+    bench.output(&out)
+        .streaming(true)
+        .performanceCounters(false)
+        .epochs(20)
+        .epochIterations(1)
+        .liveReport(std::chrono::nanoseconds(1))
+        .run("live", [] {
+            auto const until = ankerl::nanobench::Clock::now() + std::chrono::microseconds(20);
+            while (ankerl::nanobench::Clock::now() < until) {
+            }
+        });
+
+    auto const s = out.str();
+    INFO(s);
+    CHECK(s.find(" window ns/op |") != std::string::npos);
+    CHECK(s.find(" drift% |") != std::string::npos);
+
+    // every epoch got a live row, and the final row still has its own header
+    CHECK(std::count(s.begin(), s.end(), '\n') >= 20);
+    CHECK(s.find(" op/s |") != std::string::npos);
+    CHECK(bench.results().back().streaming());
+    CHECK(bench.results().back().size() == 20U);
+}
@@ -45,6 +45,11 @@ TEST_CASE("unit_templates_generate" * doctest::skip()) {
         std::ofstream fout{tplPath() + "mustache.template.pyperf"};
         fout << ankerl::nanobench::templates::pyperf();
     }
+
+    {
+        std::ofstream fout{tplPath() + "mustache.template.googlebenchmark"};
+        fout << ankerl::nanobench::templates::googleBenchmark();
+    }
 }
 
 // NOLINTNEXTLINE
@@ -60,4 +65,7 @@ TEST_CASE("unit_templates") {
 
     REQUIRE(readFile(tplPath() + "mustache.template.pyperf") ==
             std::string{ankerl::nanobench::templates::pyperf()});
+
+    REQUIRE(readFile(tplPath() + "mustache.template.googlebenchmark") ==
+            std::string{ankerl::nanobench::templates::googleBenchmark()});
 }
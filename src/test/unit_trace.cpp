@@ -0,0 +1,100 @@
+#include <nanobench.h>
+#include <thirdparty/doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// A trace is only looked at when something already went wrong, so it has to
+// be there and open in a viewer the first time - a file that Perfetto refuses
+// is discovered an hour into the run that needed it. The viewer itself cannot
+// be run here, so this checks what it relies on: a file that is one array,
+// with every phase of every benchmark in it, and that a second benchmark of
+// the same process adds to it rather than starting over.
+namespace {
+
+std::string contentsOf(std::string const& path) {
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+size_t count(std::string const& text, std::string const& what) {
+    size_t n = 0;
+    for (auto pos = text.find(what); pos != std::string::npos; pos = text.find(what, pos + what.size())) {
+        ++n;
+    }
+    return n;
+}
+
+// something the optimizer cannot remove, or the run is an "iterations overflow" with no epochs
+void increment(uint64_t& x) {
+    ankerl::nanobench::doNotOptimizeAway(x += 1);
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_trace_file") {
+    std::string const path = "unit_trace_file.json";
+    uint64_t x = 0;
+    int numSetups = 0;
+
+    ankerl::nanobench::Bench bench;
+    bench.output(nullptr).trace(path).warmup(100).epochs(5).context("type", "int");
+    CHECK(bench.trace() == path);
+    bench.run("first", [&] {
+        increment(x);
+    });
+    bench.setup([&] {
+             ++numSetups;
+         })
+        .run("second", [&] {
+            increment(x);
+        });
+
+    auto const trace = contentsOf(path);
+    INFO(trace);
+    // an array the viewer may leave open, and no event without the comma that separates it
+    CHECK(trace.rfind(R"([{"name":"process_name")", 0) == 0U);
+    CHECK(std::count(trace.begin(), trace.end(), '{') == std::count(trace.begin(), trace.end(), '}'));
+    CHECK(count(trace, "\n{") == count(trace, ",\n{"));
+
+    CHECK(count(trace, R"("cat":"benchmark")") == 2U);
+    CHECK(count(trace, R"("name":"first","cat":"benchmark")") == 1U);
+    CHECK(count(trace, R"("type":"int")") == 2U);
+    CHECK(count(trace, R"("cat":"warmup")") == 2U);
+    CHECK(count(trace, R"("cat":"measuring")") == 10U);
+    CHECK(count(trace, R"("name":"epoch 5")") == 2U);
+    CHECK(count(trace, R"("ph":"C")") >= 12U);
+    CHECK(count(trace, R"("name":"between epochs")") >= 1U);
+    CHECK(numSetups > 0);
+
+    // a second bench of the same process appends, it does not start over
+    ankerl::nanobench::Bench().output(nullptr).trace(path).epochs(3).run("third", [&] {
+        increment(x);
+    });
+    auto const appended = contentsOf(path);
+    CHECK(appended.compare(0, trace.size(), trace) == 0);
+    CHECK(count(appended, R"("cat":"benchmark")") == 3U);
+    CHECK(count(appended, "[") == 1U);
+    std::remove(path.c_str());
+}
+
+// NOLINTNEXTLINE
+TEST_CASE("unit_trace_off_by_default") {
+    std::string const path = "unit_trace_off_by_default.json";
+    std::remove(path.c_str());
+
+    uint64_t x = 0;
+    ankerl::nanobench::Bench bench;
+    bench.output(nullptr).epochs(3).run("untraced", [&] {
+        increment(x);
+    });
+    CHECK(bench.trace().empty());
+    CHECK(!std::ifstream(path).good());
+}